@@ -0,0 +1,534 @@
+// ݹݮįաGHAȾq GetBinFileInfo / GetMainAppInfo / GetDefaultParametersInfo
+// bPɮפjpPæƶqUCШDơB (p50/p99) PǿqAȤ䴩 POSIX x
+// {Ҧ (co: }Y) H@ӨƥjWh CoroutineClient u@qFۦPæƶq
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <signal.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SocketClient.h"
+#include "CoroutineClient.h"
+#include "EventLoop.h"
+
+#define DEFAULT_BENCH_PORT 19450
+#define DEFAULT_DURATION_MS 2000
+#define CONNECT_RETRY_COUNT 50
+#define BENCH_ASK_ID "Bench"
+#define BENCH_PRODUCT_SERIES "BMS"
+#define BENCH_APPLICABLE_PROJECTS "Thai"
+
+struct BenchmarkOptions
+{
+	std::string serverPath;
+	std::string binDirectory;
+	int port = DEFAULT_BENCH_PORT;
+	int durationMs = DEFAULT_DURATION_MS;
+	std::vector<size_t> sizes = { 4 * 1024, 64 * 1024, 1024 * 1024, 8 * 1024 * 1024 };
+	std::vector<int> concurrency = { 1, 4, 8 };
+	int pipelineDepth = 1;
+	TransportBackend transportBackend = TRANSPORT_DEFAULT;
+	int rangeConnections = 1;
+	std::string rateLimit;
+	std::string csvPath;
+	bool coroutine = true;
+};
+
+struct BenchmarkResult
+{
+	std::string operation;
+	size_t payloadSize = 0;
+	int concurrency = 0;
+	size_t requests = 0;
+	size_t errors = 0;
+	double seconds = 0;
+	double p50Us = 0;
+	double p99Us = 0;
+	size_t bytes = 0;
+};
+
+// 榸ШDA\ɦ^Ǧ쪺e줸ռơAѦ^ -1
+typedef std::function<long long(ClientHandle)> BenchmarkRequest;
+
+// {Ҧ榸ШDAargument  .bin ɮת customizeId
+typedef Task<long long> (*CoroutineRequest)(CoroutineClient& client, std::string argument);
+
+// CӰΤu@qU۰OAAX
+struct WorkerSamples
+{
+	std::vector<double> latencies;
+	size_t errors = 0;
+	size_t bytes = 0;
+};
+
+static BenchmarkOptions options;
+
+static bool parseList(const std::string& text, std::vector<size_t>& values)
+{
+	values.clear();
+	std::stringstream stream(text);
+	std::string item;
+	while (std::getline(stream, item, ',')) {
+		char* end = nullptr;
+		unsigned long long value = std::strtoull(item.c_str(), &end, 10);
+		if (end == item.c_str() || value == 0) {
+			return false;
+		}
+		// 䴩 K / M 
+		if (*end == 'K' || *end == 'k') {
+			value *= 1024;
+		}
+		else if (*end == 'M' || *end == 'm') {
+			value *= 1024 * 1024;
+		}
+		values.push_back((size_t)value);
+	}
+	return !values.empty();
+}
+
+static void printUsage(const char* program)
+{
+	std::cerr << "Usage: " << program << " [options]\n"
+		<< "  --server PATH        start PATH (mock_server) for the run; otherwise use the server at\n"
+		<< "                       SOCKETCLIENT_ADDRESS:SOCKETCLIENT_PORT, which must serve --bin-dir\n"
+		<< "  --port N             port for the started server (default " << DEFAULT_BENCH_PORT << ")\n"
+		<< "  --bin-dir DIR        directory for generated payload files (default: temporary directory)\n"
+		<< "  --sizes LIST         payload sizes, e.g. 4K,64K,1M,8M\n"
+		<< "  --concurrency LIST   concurrent requests per client, e.g. 1,4,8\n"
+		<< "  --duration-ms N      run time of each case (default " << DEFAULT_DURATION_MS << ")\n"
+		<< "  --pipeline-depth N   requests in flight per connection; the pool shrinks accordingly (default 1)\n"
+		<< "  --transport NAME     default or io_uring (falls back to default when unsupported)\n"
+		<< "  --range-connections N\n"
+		<< "                       connections per large file download; the pool grows accordingly (default 1)\n"
+		<< "  --rate-limit N       with --server, limit the server to N bytes per second per response\n"
+		<< "  --coroutine on|off   also run each case as concurrent CoroutineClient sessions on one event loop (default on)\n"
+		<< "  --csv PATH           append results to a CSV file\n";
+}
+
+static bool parseArguments(int argc, char* argv[])
+{
+	for (int i = 1; i < argc; i++) {
+		std::string argument = argv[i];
+		if (i + 1 >= argc) {
+			return false;
+		}
+		std::string value = argv[++i];
+		if (argument == "--server") {
+			options.serverPath = value;
+		}
+		else if (argument == "--port") {
+			options.port = std::atoi(value.c_str());
+		}
+		else if (argument == "--bin-dir") {
+			options.binDirectory = value;
+		}
+		else if (argument == "--sizes") {
+			if (!parseList(value, options.sizes)) {
+				return false;
+			}
+		}
+		else if (argument == "--concurrency") {
+			std::vector<size_t> levels;
+			if (!parseList(value, levels)) {
+				return false;
+			}
+			options.concurrency.assign(levels.begin(), levels.end());
+		}
+		else if (argument == "--duration-ms") {
+			options.durationMs = std::atoi(value.c_str());
+		}
+		else if (argument == "--pipeline-depth") {
+			options.pipelineDepth = std::atoi(value.c_str());
+		}
+		else if (argument == "--transport") {
+			if (value == "io_uring") {
+				options.transportBackend = TRANSPORT_IO_URING;
+			}
+			else if (value != "default") {
+				return false;
+			}
+		}
+		else if (argument == "--range-connections") {
+			options.rangeConnections = std::atoi(value.c_str());
+		}
+		else if (argument == "--rate-limit") {
+			options.rateLimit = value;
+		}
+		else if (argument == "--csv") {
+			options.csvPath = value;
+		}
+		else if (argument == "--coroutine") {
+			if (value != "on" && value != "off") {
+				return false;
+			}
+			options.coroutine = value == "on";
+		}
+		else {
+			return false;
+		}
+	}
+	return options.durationMs > 0 && options.pipelineDepth > 0 && options.rangeConnections > 0;
+}
+
+// ͻPAȾۦP˦MɡAwsbBjpۦPɲL
+static bool writePayloadFile(size_t size)
+{
+	std::filesystem::path path = std::filesystem::path(options.binDirectory) /
+		(std::string(BENCH_ASK_ID) + "-" + BENCH_PRODUCT_SERIES + "-" + BENCH_APPLICABLE_PROJECTS + "-" + std::to_string(size) + ".bin");
+
+	std::error_code error;
+	if (std::filesystem::file_size(path, error) == size && !error) {
+		return true;
+	}
+
+	std::vector<char> image(size, (char)0xFF);
+	for (size_t i = 0; i < size / 2; i++) {
+		image[i] = (char)((i * 31 + (i >> 8)) & 0xFF);
+	}
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file.write(image.data(), image.size());
+	return file.good();
+}
+
+static pid_t startServer()
+{
+	pid_t pid = fork();
+	if (pid == 0) {
+		std::string port = std::to_string(options.port);
+		if (options.rateLimit.empty()) {
+			execl(options.serverPath.c_str(), options.serverPath.c_str(),
+				"--port", port.c_str(), "--bin-dir", options.binDirectory.c_str(), (char*)nullptr);
+		}
+		else {
+			execl(options.serverPath.c_str(), options.serverPath.c_str(),
+				"--port", port.c_str(), "--bin-dir", options.binDirectory.c_str(),
+				"--rate-limit", options.rateLimit.c_str(), (char*)nullptr);
+		}
+		_exit(127);
+	}
+	return pid;
+}
+
+static void stopServer(pid_t pid)
+{
+	if (pid > 0) {
+		kill(pid, SIGTERM);
+		waitpid(pid, nullptr, 0);
+	}
+}
+
+static ClientHandle connectClient(int concurrency)
+{
+	ClientOptions clientOptions;
+	InitClientOptions(&clientOptions);
+	// ޽uƮɥH֪suӸۦPæƶq
+	clientOptions.poolSize = (concurrency + options.pipelineDepth - 1) / options.pipelineDepth;
+	clientOptions.pipelineDepth = options.pipelineDepth;
+	clientOptions.transportBackend = options.transportBackend;
+	// CӽШDqUɻݭn rangeConnections su
+	clientOptions.poolSize *= options.rangeConnections;
+	clientOptions.rangeConnections = options.rangeConnections;
+
+	ClientHandle client = CreateClientWithOptions(&clientOptions);
+	for (int attempt = 0; attempt < CONNECT_RETRY_COUNT; attempt++) {
+		if (ClientInitialize(client, "Benchmark", "Benchmark", "0", "benchmark")) {
+			return client;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	}
+	DestroyClient(client);
+	return nullptr;
+}
+
+static double percentile(const std::vector<double>& sorted, double fraction)
+{
+	if (sorted.empty()) {
+		return 0;
+	}
+	size_t index = (size_t)(fraction * (double)(sorted.size() - 1) + 0.5);
+	return sorted[std::min(index, sorted.size() - 1)];
+}
+
+static BenchmarkResult summarize(const std::string& operation, size_t payloadSize, int concurrency,
+	std::chrono::steady_clock::time_point start, const std::vector<WorkerSamples>& samples)
+{
+	BenchmarkResult result;
+	result.operation = operation;
+	result.payloadSize = payloadSize;
+	result.concurrency = concurrency;
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::vector<double> all;
+	for (const auto& worker : samples) {
+		all.insert(all.end(), worker.latencies.begin(), worker.latencies.end());
+		result.errors += worker.errors;
+		result.bytes += worker.bytes;
+	}
+	std::sort(all.begin(), all.end());
+	result.requests = all.size();
+	result.p50Us = percentile(all, 0.50);
+	result.p99Us = percentile(all, 0.99);
+	return result;
+}
+
+// H concurrency ӰeXШDɶ
+static BenchmarkResult runCase(ClientHandle client, const std::string& operation, size_t payloadSize,
+	int concurrency, const BenchmarkRequest& request)
+{
+	std::vector<WorkerSamples> samples(concurrency);
+
+	auto start = std::chrono::steady_clock::now();
+	auto deadline = start + std::chrono::milliseconds(options.durationMs);
+
+	std::vector<std::thread> workers;
+	for (int t = 0; t < concurrency; t++) {
+		workers.emplace_back([&, t] {
+			while (std::chrono::steady_clock::now() < deadline) {
+				auto requestStart = std::chrono::steady_clock::now();
+				long long received = request(client);
+				auto requestEnd = std::chrono::steady_clock::now();
+				if (received < 0) {
+					samples[t].errors++;
+					continue;
+				}
+				samples[t].bytes += (size_t)received;
+				samples[t].latencies.push_back(std::chrono::duration<double, std::micro>(requestEnd - requestStart).count());
+			}
+		});
+	}
+	for (auto& worker : workers) {
+		worker.join();
+	}
+	return summarize(operation, payloadSize, concurrency, start, samples);
+}
+
+static Task<long long> coroutineMainAppInfo(CoroutineClient& client, std::string /*argument*/)
+{
+	MainAppInfo* info = co_await client.getMainAppInfo(BENCH_PRODUCT_SERIES, BENCH_APPLICABLE_PROJECTS, "0");
+	delete info;
+	co_return info ? 0 : -1;
+}
+
+static Task<long long> coroutineDefaultParametersInfo(CoroutineClient& client, std::string /*argument*/)
+{
+	DefaultParametersInfo* info = co_await client.getDefaultParametersInfo(BENCH_PRODUCT_SERIES, BENCH_APPLICABLE_PROJECTS, "0");
+	delete info;
+	co_return info ? 0 : -1;
+}
+
+static Task<long long> coroutineBinFileInfo(CoroutineClient& client, std::string argument)
+{
+	FileInfo* fileInfo = co_await client.getBinFileInfo(BENCH_ASK_ID, BENCH_PRODUCT_SERIES, BENCH_APPLICABLE_PROJECTS, argument);
+	if (!fileInfo) {
+		co_return -1;
+	}
+	long long size = (long long)fileInfo->size;
+	FreeFileInfo(fileInfo);
+	co_return size;
+}
+
+// @Ө{u@qGإߦۤvsuAeXШDɶFsuѩΤ_ɰO~
+static Task<void> runSession(EventLoop& loop, CoroutineRequest request, std::string argument,
+	std::chrono::steady_clock::time_point deadline, WorkerSamples& samples)
+{
+	CoroutineClient client(loop);
+	bool connected = co_await client.connect();
+	if (!connected) {
+		samples.errors++;
+		co_return;
+	}
+	while (std::chrono::steady_clock::now() < deadline) {
+		auto requestStart = std::chrono::steady_clock::now();
+		long long received = co_await request(client, argument);
+		auto requestEnd = std::chrono::steady_clock::now();
+		if (received < 0) {
+			samples.errors++;
+			if (!client.isConnected()) {
+				break;
+			}
+			continue;
+		}
+		samples.bytes += (size_t)received;
+		samples.latencies.push_back(std::chrono::duration<double, std::micro>(requestEnd - requestStart).count());
+	}
+	co_await client.close();
+}
+
+// bثe@ӨƥjWPɰ concurrency Ӥu@q
+static BenchmarkResult runCoroutineCase(const std::string& operation, size_t payloadSize, int concurrency,
+	CoroutineRequest request, const std::string& argument)
+{
+	std::vector<WorkerSamples> samples(concurrency);
+
+	auto start = std::chrono::steady_clock::now();
+	auto deadline = start + std::chrono::milliseconds(options.durationMs);
+
+	EventLoop loop;
+	for (int i = 0; i < concurrency; i++) {
+		loop.spawn(runSession(loop, request, argument, deadline, samples[i]));
+	}
+	loop.run();
+	return summarize("co:" + operation, payloadSize, concurrency, start, samples);
+}
+
+static void printResult(const BenchmarkResult& result)
+{
+	char line[256];
+	snprintf(line, sizeof(line), "%-30s %10zu %5d %9zu %7zu %11.1f %10.1f %10.1f %10.2f",
+		result.operation.c_str(), result.payloadSize, result.concurrency, result.requests, result.errors,
+		result.requests / result.seconds, result.p50Us, result.p99Us,
+		result.bytes / result.seconds / (1024.0 * 1024.0));
+	std::cout << line << std::endl;
+}
+
+static void appendCsv(const std::vector<BenchmarkResult>& results)
+{
+	bool writeHeader = !std::filesystem::exists(options.csvPath);
+	std::ofstream csv(options.csvPath, std::ios::app);
+	if (writeHeader) {
+		csv << "operation,payload_bytes,concurrency,requests,errors,requests_per_sec,p50_us,p99_us,mb_per_sec\n";
+	}
+	for (const auto& result : results) {
+		csv << result.operation << ',' << result.payloadSize << ',' << result.concurrency << ','
+			<< result.requests << ',' << result.errors << ',' << result.requests / result.seconds << ','
+			<< result.p50Us << ',' << result.p99Us << ',' << result.bytes / result.seconds / (1024.0 * 1024.0) << '\n';
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if (!parseArguments(argc, argv)) {
+		printUsage(argv[0]);
+		return 2;
+	}
+	signal(SIGPIPE, SIG_IGN);
+
+	bool temporaryDirectory = options.binDirectory.empty();
+	if (temporaryDirectory) {
+		options.binDirectory = (std::filesystem::temp_directory_path() /
+			("socketclient-bench-" + std::to_string(getpid()))).string();
+	}
+	std::filesystem::create_directories(options.binDirectory);
+	for (size_t size : options.sizes) {
+		if (!writePayloadFile(size)) {
+			std::cerr << "benchmark: cannot write payload file of " << size << " bytes to " << options.binDirectory << std::endl;
+			return 1;
+		}
+	}
+
+	pid_t serverPid = -1;
+	if (!options.serverPath.empty()) {
+		setenv("SOCKETCLIENT_ADDRESS", "127.0.0.1", 1);
+		setenv("SOCKETCLIENT_PORT", std::to_string(options.port).c_str(), 1);
+		serverPid = startServer();
+		if (serverPid < 0) {
+			std::cerr << "benchmark: cannot start " << options.serverPath << std::endl;
+			return 1;
+		}
+	}
+
+	char header[256];
+	snprintf(header, sizeof(header), "%-30s %10s %5s %9s %7s %11s %10s %10s %10s",
+		"operation", "bytes", "conc", "requests", "errors", "req/s", "p50(us)", "p99(us)", "MB/s");
+	std::cout << header << std::endl;
+
+	std::vector<BenchmarkResult> results;
+	int exitCode = 0;
+	for (int concurrency : options.concurrency) {
+		ClientHandle client = connectClient(concurrency);
+		if (!client) {
+			std::cerr << "benchmark: cannot connect to server" << std::endl;
+			exitCode = 1;
+			break;
+		}
+
+		results.push_back(runCase(client, "GetMainAppInfo", 0, concurrency, [](ClientHandle handle) -> long long {
+			MainAppInfo* info = ClientGetMainAppInfo(handle, BENCH_PRODUCT_SERIES, BENCH_APPLICABLE_PROJECTS, "0");
+			delete info;
+			return info ? 0 : -1;
+		}));
+		printResult(results.back());
+
+		results.push_back(runCase(client, "GetDefaultParametersInfo", 0, concurrency, [](ClientHandle handle) -> long long {
+			DefaultParametersInfo* info = ClientGetDefaultParametersInfo(handle, BENCH_PRODUCT_SERIES, BENCH_APPLICABLE_PROJECTS, "0");
+			delete info;
+			return info ? 0 : -1;
+		}));
+		printResult(results.back());
+
+		for (size_t size : options.sizes) {
+			std::string customizeId = std::to_string(size);
+			results.push_back(runCase(client, "GetBinFileInfo", size, concurrency, [customizeId](ClientHandle handle) -> long long {
+				FileInfo* fileInfo = ClientGetBinFileInfo(handle, BENCH_ASK_ID, BENCH_PRODUCT_SERIES, BENCH_APPLICABLE_PROJECTS, customizeId.c_str());
+				if (!fileInfo) {
+					return -1;
+				}
+				long long size = (long long)fileInfo->size;
+				FreeFileInfo(fileInfo);
+				return size;
+			}));
+			printResult(results.back());
+
+			// @x~]wGMainAppBDefaultParameters P .bin ɮפ@
+			results.push_back(runCase(client, "GetBatch", size, concurrency, [customizeId](ClientHandle handle) -> long long {
+				BatchQuery queries[] = {
+					{ BATCH_QUERY_MAIN_APP, nullptr, BENCH_PRODUCT_SERIES, BENCH_APPLICABLE_PROJECTS, "0" },
+					{ BATCH_QUERY_DEFAULT_PARAMETERS, nullptr, BENCH_PRODUCT_SERIES, BENCH_APPLICABLE_PROJECTS, "0" },
+					{ BATCH_QUERY_BIN_FILE, BENCH_ASK_ID, BENCH_PRODUCT_SERIES, BENCH_APPLICABLE_PROJECTS, customizeId.c_str() },
+				};
+				BatchResult batchResults[3];
+				bool success = ClientGetBatch(handle, queries, 3, batchResults);
+				long long size = success ? (long long)batchResults[2].fileInfo->size : -1;
+				FreeBatchResults(batchResults, 3);
+				return size;
+			}));
+			printResult(results.back());
+		}
+
+		DestroyClient(client);
+
+		if (options.coroutine) {
+			results.push_back(runCoroutineCase("GetMainAppInfo", 0, concurrency, coroutineMainAppInfo, std::string()));
+			printResult(results.back());
+
+			results.push_back(runCoroutineCase("GetDefaultParametersInfo", 0, concurrency, coroutineDefaultParametersInfo,
+				std::string()));
+			printResult(results.back());
+
+			for (size_t size : options.sizes) {
+				results.push_back(runCoroutineCase("GetBinFileInfo", size, concurrency, coroutineBinFileInfo,
+					std::to_string(size)));
+				printResult(results.back());
+			}
+		}
+	}
+
+	if (!options.csvPath.empty()) {
+		appendCsv(results);
+	}
+
+	stopServer(serverPid);
+	if (temporaryDirectory) {
+		std::error_code error;
+		std::filesystem::remove_all(options.binDirectory, error);
+	}
+
+	for (const auto& result : results) {
+		if (result.errors > 0) {
+			exitCode = 1;
+		}
+	}
+	return exitCode;
+}
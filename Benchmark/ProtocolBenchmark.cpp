@@ -0,0 +1,284 @@
+// wLǴաGqШDTͻP^YѪRCӮɻPOtmơA
+// HθgѥjH Connection eXШD (޽uƮɥ]t^Y) Ӹ|F
+// ƨϥνwİϻPcíwAUtmOAtmɥHX 1 ^
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Connection.h"
+#include "Logger.h"
+#include "Metrics.h"
+#include "Protocol.h"
+
+#define DEFAULT_ITERATIONS 1000000
+#define WARMUP_RUNS 4
+// gѰjبCݭntΩIsAƬ --iterations ʤ@
+#define CONNECTION_ITERATION_DIVISOR 100
+#define LOOPBACK_BUFFER_SIZE 64 * 1024
+
+// p operator new Is
+static std::atomic<size_t> allocations(0);
+
+void* operator new(size_t size)
+{
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	void* memory = malloc(size == 0 ? 1 : size);
+	if (!memory) {
+		throw std::bad_alloc();
+	}
+	return memory;
+}
+
+void* operator new[](size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+	free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+	free(memory);
+}
+
+struct ProtocolCase
+{
+	const char* name;
+	std::function<void()> run;
+	size_t iterations;
+};
+
+static size_t iterations = DEFAULT_ITERATIONS;
+
+// ƦwİϹFһݮeqA᪺jYíwA
+static bool runCase(const ProtocolCase& protocolCase)
+{
+	for (int i = 0; i < WARMUP_RUNS; i++) {
+		protocolCase.run();
+	}
+	size_t allocationsBefore = allocations.load();
+	auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < protocolCase.iterations; i++) {
+		protocolCase.run();
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	size_t allocated = allocations.load() - allocationsBefore;
+
+	char line[256];
+	snprintf(line, sizeof(line), "%-30s %10.1f %14.3f", protocolCase.name, seconds * 1e9 / (double)protocolCase.iterations,
+		(double)allocated / (double)protocolCase.iterations);
+	std::cout << line << std::endl;
+	return allocated == 0;
+}
+
+/// <summary>
+/// jWAȾGŪåШDArespond ɹCӧ㪺ШDŢǦ^
+/// {"status":"success","requestId":N} (N  1 }lAPsu requestId ۦP)FtmO
+/// </summary>
+class LoopbackServer
+{
+public:
+	explicit LoopbackServer(bool respond)
+		: respond(respond)
+	{
+		listenFd = socket(AF_INET, SOCK_STREAM, 0);
+		struct sockaddr_in address = {};
+		address.sin_family = AF_INET;
+		address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		socklen_t length = sizeof(address);
+		if (listenFd < 0 || bind(listenFd, (struct sockaddr*)&address, sizeof(address)) != 0 ||
+			listen(listenFd, 1) != 0 || getsockname(listenFd, (struct sockaddr*)&address, &length) != 0) {
+			return;
+		}
+		port = std::to_string(ntohs(address.sin_port));
+		worker = std::thread(&LoopbackServer::run, this);
+	}
+
+	~LoopbackServer() {
+		if (worker.joinable()) {
+			worker.join();
+		}
+		if (listenFd >= 0) {
+			close(listenFd);
+		}
+	}
+
+	const std::string& listenPort() const {
+		return port;
+	}
+
+private:
+	bool respond;
+	int listenFd = -1;
+	std::string port;
+	std::thread worker;
+
+	// suɵ
+	void run() {
+		int fd = accept(listenFd, nullptr, nullptr);
+		if (fd < 0) {
+			return;
+		}
+		static char buffer[LOOPBACK_BUFFER_SIZE];
+		int depth = 0;
+		bool inString = false;
+		bool escaped = false;
+		uint64_t requestId = 0;
+		ssize_t received;
+		while ((received = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+			for (ssize_t i = 0; i < received; i++) {
+				char c = buffer[i];
+				if (inString) {
+					if (escaped) {
+						escaped = false;
+					}
+					else if (c == '\\') {
+						escaped = true;
+					}
+					else if (c == '"') {
+						inString = false;
+					}
+				}
+				else if (c == '"') {
+					inString = true;
+				}
+				else if (c == '{') {
+					depth++;
+				}
+				else if (c == '}' && --depth == 0 && respond) {
+					// requestId HťոɨTweסAYפHƧ
+					char response[64];
+					int length = snprintf(response, sizeof(response), "{\"status\":\"success\",\"requestId\":%-20llu}",
+						(unsigned long long)++requestId);
+					if (send(fd, response, (size_t)length, MSG_NOSIGNAL) != length) {
+						close(fd);
+						return;
+					}
+				}
+			}
+		}
+		close(fd);
+	}
+};
+
+int main(int argc, char* argv[])
+{
+	if (argc == 3 && std::string(argv[1]) == "--iterations" && std::atoi(argv[2]) > 0) {
+		iterations = (size_t)std::atoi(argv[2]);
+	}
+	else if (argc != 1) {
+		std::cerr << "Usage: " << argv[0] << " [--iterations N]   (default " << DEFAULT_ITERATIONS << ")" << std::endl;
+		return 2;
+	}
+
+	// 嫬ɽШDGШDBqPY
+	AskRequest fileRequest = { "BMS", "Thai", "10000", "Customer-A", true, "766b8a137f29b875" };
+	fileRequest.range = ByteRange{ 0, 1024 * 1024 };
+	fileRequest.acceptCompressed = true;
+	AskRequest infoRequest = { "MainApp", "Thai", "10000", "Customer-A", false, nullptr };
+	std::vector<AskRequest> batch(8, fileRequest);
+	std::string buffer;
+	buffer.reserve(REQUEST_BUFFER_SIZE);
+	uint64_t requestId = 1;
+
+	std::string binHeader = "{\"status\":\"success\",\"fileName\":\"BMS-Thai-10000.bin\",\"fileSize\":16777216,"
+		"\"Version\":\"766b8a137f29b875\",\"range\":{\"offset\":0,\"length\":1048576},\"encoding\":\"lz4\","
+		"\"encodedSize\":304705,\"crc32c\":\"b0e2a0df\","
+		"\"sha256\":\"60303ae22b998861bce3b28f33eec1be758a213c86c93c076dbe9f558c11c752\",\"requestId\":12}";
+	std::string parametersHeader = "{\"status\":\"success\",\"Version\":\"1.0.0\",\"BLVersion\":\"1.0.0\","
+		"\"CalibrationOffset\":0,\"ShieldedZoneCount\":8,\"ShieldedZone\":[";
+	for (int i = 0; i < 8; i++) {
+		parametersHeader += (i > 0 ? ",{\"start\":" : "{\"start\":") + std::to_string(i * 0x1000) +
+			",\"end\":" + std::to_string(i * 0x1000 + 0x7FF) + "}";
+	}
+	parametersHeader += "]}";
+	BinFileHeader header;
+	MainAppInfo mainAppInfo;
+	DefaultParametersInfo parametersInfo;
+	std::string message;
+
+	// PΤݬۦPsu (]tέp)AgѥjeX
+	Metrics metrics;
+	LoopbackServer drainServer(false);
+	LoopbackServer echoServer(true);
+	std::unique_ptr<Connection> connection(new Connection(&metrics, false));
+	std::unique_ptr<Connection> pipelinedConnection(new Connection(&metrics, true));
+	if (drainServer.listenPort().empty() || echoServer.listenPort().empty() ||
+		!connection->open("127.0.0.1", drainServer.listenPort()) ||
+		!pipelinedConnection->open("127.0.0.1", echoServer.listenPort())) {
+		std::cerr << "protocol_bench: cannot open loopback connections" << std::endl;
+		return 1;
+	}
+	std::string responseHeader;
+	bool connectionFailed = false;
+	// suL{OgᰱOAqupШD|
+	Logger::shutdown();
+
+	size_t connectionIterations = std::max(iterations / CONNECTION_ITERATION_DIVISOR, (size_t)1);
+	std::vector<ProtocolCase> cases = {
+		{ "SerializeRequest (file)", [&] { SerializeRequest(fileRequest, 0, buffer); }, iterations },
+		{ "SerializeRequest (info)", [&] { SerializeRequest(infoRequest, 0, buffer); }, iterations },
+		{ "SerializeRequest (pipelined)", [&] { SerializeRequest(fileRequest, requestId++, buffer); }, iterations },
+		{ "SerializeBatchRequest (8)", [&] { SerializeBatchRequest(batch, requestId++, buffer); }, iterations },
+		{ "ParseResponseId", [&] { ParseResponseId(binHeader); }, iterations },
+		{ "ParseBinFileHeader", [&] { ParseBinFileHeader(binHeader, true, header); }, iterations },
+		{ "ParseMainAppInfo", [&] { ParseMainAppInfo(parametersHeader, mainAppInfo, message); }, iterations },
+		{ "ParseDefaultParametersInfo", [&] { ParseDefaultParametersInfo(parametersHeader, parametersInfo, message); },
+			iterations },
+		{ "Connection::sendRequest", [&] {
+			connectionFailed = connection->sendRequest(fileRequest) < 0 || connectionFailed;
+		}, connectionIterations },
+		{ "sendRequest + header (pipe)", [&] {
+			connectionFailed = pipelinedConnection->sendRequest(fileRequest) < 0 ||
+				!pipelinedConnection->receiveHeader(responseHeader) || connectionFailed;
+		}, connectionIterations },
+	};
+
+	char line[256];
+	snprintf(line, sizeof(line), "%-30s %10s %14s", "operation", "ns/op", "allocations/op");
+	std::cout << line << std::endl;
+	bool allocationFree = true;
+	for (const auto& protocolCase : cases) {
+		allocationFree = runCase(protocolCase) && allocationFree;
+	}
+
+	// sujAȾ
+	connection.reset();
+	pipelinedConnection.reset();
+	if (connectionFailed) {
+		std::cerr << "protocol_bench: loopback request failed" << std::endl;
+		return 1;
+	}
+	if (!allocationFree) {
+		std::cerr << "protocol_bench: steady-state path allocated memory" << std::endl;
+		return 1;
+	}
+	return 0;
+}
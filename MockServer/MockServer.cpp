@@ -0,0 +1,924 @@
+// AȾGHP nenweb AȾۦP JSON ШD/Y/ew^
+// ΩįR (PGO Vm) PuաAȤ䴩 POSIX x
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <errno.h>
+#include <signal.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "json.hpp"
+#include "Crc32c.h"
+#include "DeltaPatch.h"
+#include "Sha256.h"
+
+using json = nlohmann::json;
+
+#define DEFAULT_MOCK_PORT 19443
+
+struct ServerOptions
+{
+	int port = DEFAULT_MOCK_PORT;
+	std::string binDirectory;
+	size_t syntheticSize = 0;
+	int maxConnections = 0;
+	int headerGapMs = 0;
+	std::string answersPath;
+	int jitterMs = 0;
+	size_t rateLimit = 0;
+	size_t dropAfter = 0;
+	bool compress = true;
+	bool delta = true;
+	bool sendCrc32c = true;
+	bool sendSha256 = true;
+	// ǰee½ऺem줸աAǿ~laeFtƪܤla
+	long long corruptOffset = -1;
+};
+
+typedef std::shared_ptr<const std::vector<char>> FileContent;
+typedef std::shared_ptr<const std::string> CompressedContent;
+
+// wJ .bin ɮסAɮפjpέקɶܮɭsŪ
+struct CachedFile
+{
+	std::filesystem::file_time_type modified;
+	uintmax_t size = 0;
+	FileContent content;
+	std::string version;
+};
+
+static ServerOptions options;
+static std::atomic<int> finishedConnections(0);
+static std::mutex fileCacheMutex;
+static std::map<std::string, CachedFile> fileCache;
+static FileContent syntheticImage;
+static std::string syntheticVersion;
+// ɮת LZ4 YGAOd줺eקK}Qƨϥ
+static std::mutex compressedCacheMutex;
+static std::map<const void*, std::pair<FileContent, CompressedContent>> compressedCache;
+// ǰeLɮפe SHA-256 OdAȤݥH knownSha256 ܤwɥΨӲͮt
+static std::mutex contentHashMutex;
+static std::map<const void*, std::string> contentHashes;
+static std::map<std::string, FileContent> contentsByHash;
+// ɮפe CRC32CAOd줺eקK}Qƨϥ
+static std::mutex contentCrcMutex;
+static std::map<const void*, std::pair<FileContent, uint32_t>> contentCrcs;
+// --corrupt la᪺e
+static std::mutex corruptedMutex;
+static std::map<const void*, std::pair<FileContent, FileContent>> corruptedContents;
+
+// MainApp / DefaultParameters ^eAi --answers w JSON мg
+static json answers = {
+	{"MainApp", {
+		{"Version", "1.0.0"},
+		{"BLVersion", "1.0.0"},
+		{"CalibrationOffset", 0},
+	}},
+	{"DefaultParameters", {
+		{"Version", "1.0.0"},
+		{"BLVersion", "1.0.0"},
+		{"CalibrationOffset", 0},
+	}},
+};
+
+static bool sendAll(int fd, const char* data, size_t length)
+{
+	size_t totalSent = 0;
+	while (totalSent < length) {
+		ssize_t sent = send(fd, data + totalSent, length - totalSent, MSG_NOSIGNAL);
+		if (sent < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return false;
+		}
+		totalSent += (size_t)sent;
+	}
+	return true;
+}
+
+// HWL --rate-limit t׶ǰeɮפeA@suP𭭨Zu
+static bool sendContent(int fd, const char* data, size_t length)
+{
+	// --drop-after ǿ餤_GueX}Ysu
+	if (options.dropAfter > 0 && length > options.dropAfter) {
+		sendContent(fd, data, options.dropAfter);
+		return false;
+	}
+	if (options.rateLimit == 0) {
+		return sendAll(fd, data, length);
+	}
+	const size_t slice = 64 * 1024;
+	auto start = std::chrono::steady_clock::now();
+	for (size_t offset = 0; offset < length; offset += slice) {
+		size_t count = std::min(slice, length - offset);
+		if (!sendAll(fd, data + offset, count)) {
+			return false;
+		}
+		auto due = start + std::chrono::microseconds((offset + count) * 1000000 / options.rateLimit);
+		std::this_thread::sleep_until(due);
+	}
+	return true;
+}
+
+static bool sendJson(int fd, const json& message)
+{
+	std::string text = message.dump();
+	return sendAll(fd, text.data(), text.size());
+}
+
+// qwİϤX@ӧ㪺 JSON  (HAtP_ALrꤺe)
+static bool extractJsonObject(std::string& buffer, std::string& object)
+{
+	size_t start = buffer.find('{');
+	if (start == std::string::npos) {
+		buffer.clear();
+		return false;
+	}
+
+	int depth = 0;
+	bool inString = false;
+	bool escaped = false;
+	for (size_t i = start; i < buffer.size(); i++) {
+		char c = buffer[i];
+		if (inString) {
+			if (escaped) {
+				escaped = false;
+			}
+			else if (c == '\\') {
+				escaped = true;
+			}
+			else if (c == '"') {
+				inString = false;
+			}
+			continue;
+		}
+		if (c == '"') {
+			inString = true;
+		}
+		else if (c == '{') {
+			depth++;
+		}
+		else if (c == '}' && --depth == 0) {
+			object = buffer.substr(start, i - start + 1);
+			buffer.erase(0, i + 1);
+			return true;
+		}
+	}
+	return false;
+}
+
+#define LZ4_BLOCK_SIZE 64 * 1024
+#define LZ4_HASH_BITS 14
+
+static void appendLittleEndian32(std::string& output, uint32_t value)
+{
+	for (int i = 0; i < 4; i++) {
+		output.push_back((char)((value >> (8 * i)) & 0xFF));
+	}
+}
+
+// 15 ᪺ץH 255 
+static void appendLz4Length(std::string& output, size_t length)
+{
+	for (; length >= 255; length -= 255) {
+		output.push_back((char)255);
+	}
+	output.push_back((char)length);
+}
+
+static void appendLz4Sequence(std::string& output, const char* literals, size_t literalLength, size_t offset, size_t matchLength)
+{
+	size_t matchCode = matchLength > 0 ? matchLength - 4 : 0;
+	output.push_back((char)((std::min(literalLength, (size_t)15) << 4) | std::min(matchCode, (size_t)15)));
+	if (literalLength >= 15) {
+		appendLz4Length(output, literalLength - 15);
+	}
+	output.append(literals, literalLength);
+	if (matchLength == 0) {
+		return;
+	}
+	output.push_back((char)(offset & 0xFF));
+	output.push_back((char)(offset >> 8));
+	if (matchCode >= 15) {
+		appendLz4Length(output, matchCode - 15);
+	}
+}
+
+// HgY@ LZ4 ϶F϶̫ 12 줸դ}lA̫ 5 줸դ@wOr
+static std::string compressLz4Block(const char* data, size_t size)
+{
+	std::string output;
+	std::vector<int32_t> table((size_t)1 << LZ4_HASH_BITS, -1);
+	size_t anchor = 0;
+	size_t position = 0;
+	size_t matchLimit = size > 12 ? size - 12 : 0;
+	while (position < matchLimit) {
+		uint32_t sequence;
+		memcpy(&sequence, data + position, 4);
+		uint32_t hash = (sequence * 2654435761U) >> (32 - LZ4_HASH_BITS);
+		int32_t candidate = table[hash];
+		table[hash] = (int32_t)position;
+		uint32_t candidateSequence;
+		if (candidate < 0 || position - candidate > 65535 ||
+			(memcpy(&candidateSequence, data + candidate, 4), candidateSequence != sequence)) {
+			position++;
+			continue;
+		}
+		size_t length = 4;
+		while (position + length < size - 5 && data[candidate + length] == data[position + length]) {
+			length++;
+		}
+		appendLz4Sequence(output, data + anchor, position - anchor, position - candidate, length);
+		position += length;
+		anchor = position;
+	}
+	appendLz4Sequence(output, data + anchor, size - anchor, 0, 0);
+	return output;
+}
+
+// Y LZ4 frameG64KB W߰϶AˬdXFYSܤp϶xs
+static std::string compressLz4Frame(const char* data, size_t size)
+{
+	std::string frame;
+	appendLittleEndian32(frame, 0x184D2204);
+	// FLG:  01B϶WߡFBD: 64KBFYˬdX (xxHash32 ĤGӦ줸)
+	frame.push_back((char)0x60);
+	frame.push_back((char)0x40);
+	frame.push_back((char)0x82);
+	for (size_t offset = 0; offset < size; offset += LZ4_BLOCK_SIZE) {
+		size_t blockSize = std::min((size_t)LZ4_BLOCK_SIZE, size - offset);
+		std::string block = compressLz4Block(data + offset, blockSize);
+		if (block.size() < blockSize) {
+			appendLittleEndian32(frame, (uint32_t)block.size());
+			frame += block;
+		}
+		else {
+			appendLittleEndian32(frame, (uint32_t)blockSize | 0x80000000);
+			frame.append(data + offset, blockSize);
+		}
+	}
+	appendLittleEndian32(frame, 0);
+	return frame;
+}
+
+// Ȥݱ LZ4 Y^eFɮתYGOd᪺ШD
+static CompressedContent compressContent(const json& request, const FileContent& content, size_t offset, size_t length)
+{
+	if (!options.compress || !request.contains("acceptEncoding")) {
+		return nullptr;
+	}
+	const json& accepted = request["acceptEncoding"];
+	if (!accepted.is_array() || std::find(accepted.begin(), accepted.end(), "lz4") == accepted.end()) {
+		return nullptr;
+	}
+	if (offset > 0 || length < content->size()) {
+		return std::make_shared<const std::string>(compressLz4Frame(content->data() + offset, length));
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(compressedCacheMutex);
+		auto it = compressedCache.find(content.get());
+		if (it != compressedCache.end()) {
+			return it->second.second;
+		}
+	}
+	auto compressed = std::make_shared<const std::string>(compressLz4Frame(content->data(), content->size()));
+	std::lock_guard<std::mutex> lock(compressedCacheMutex);
+	compressedCache[content.get()] = { content, compressed };
+	return compressed;
+}
+
+#define DELTA_BLOCK_SIZE 32
+
+// pɮפe SHA-256 ëOdeA᪺iHͬ۹󦹤et
+static std::string contentSha256(const FileContent& content)
+{
+	{
+		std::lock_guard<std::mutex> lock(contentHashMutex);
+		auto it = contentHashes.find(content.get());
+		if (it != contentHashes.end()) {
+			return it->second;
+		}
+	}
+	std::string hash = Sha256::hex(content->data(), content->size());
+	std::lock_guard<std::mutex> lock(contentHashMutex);
+	contentHashes[content.get()] = hash;
+	contentsByHash[hash] = content;
+	return hash;
+}
+
+static uint32_t contentCrc32c(const FileContent& content)
+{
+	{
+		std::lock_guard<std::mutex> lock(contentCrcMutex);
+		auto it = contentCrcs.find(content.get());
+		if (it != contentCrcs.end()) {
+			return it->second.second;
+		}
+	}
+	uint32_t crc = Crc32cUpdate(0, content->data(), content->size());
+	std::lock_guard<std::mutex> lock(contentCrcMutex);
+	contentCrcs[content.get()] = { content, crc };
+	return crc;
+}
+
+// ǰeeGw --corrupt ɬ½@Ӧ줸ժƥAYˬdX줺e
+static FileContent transmittedContent(const FileContent& content)
+{
+	if (options.corruptOffset < 0 || (size_t)options.corruptOffset >= content->size()) {
+		return content;
+	}
+	std::lock_guard<std::mutex> lock(corruptedMutex);
+	auto it = corruptedContents.find(content.get());
+	if (it != corruptedContents.end()) {
+		return it->second.second;
+	}
+	auto corrupted = std::make_shared<std::vector<char>>(*content);
+	(*corrupted)[(size_t)options.corruptOffset] ^= 0x5A;
+	corruptedContents[content.get()] = { content, corrupted };
+	return corrupted;
+}
+
+static void appendVarint(std::string& output, uint64_t value)
+{
+	while (value >= 0x80) {
+		output.push_back((char)(value | 0x80));
+		value >>= 7;
+	}
+	output.push_back((char)value);
+}
+
+static void appendDeltaAdd(std::string& patch, const char* data, size_t length)
+{
+	if (length > 0) {
+		patch.push_back((char)DELTA_ADD);
+		appendVarint(patch, length);
+		patch.append(data, length);
+	}
+}
+
+// Hª϶ާXsۦPA̪H DELTA_COPY ܡAlH DELTA_ADD ǰe
+static std::string encodeDelta(const std::vector<char>& base, const std::vector<char>& target)
+{
+	std::unordered_map<uint64_t, size_t> blocks;
+	for (size_t i = 0; i + DELTA_BLOCK_SIZE <= base.size(); i += DELTA_BLOCK_SIZE) {
+		uint64_t key;
+		memcpy(&key, base.data() + i, sizeof(key));
+		blocks.emplace(key, i);
+	}
+
+	std::string patch;
+	size_t literalStart = 0;
+	size_t position = 0;
+	while (position + DELTA_BLOCK_SIZE <= target.size()) {
+		uint64_t key;
+		memcpy(&key, target.data() + position, sizeof(key));
+		auto it = blocks.find(key);
+		if (it == blocks.end() || memcmp(base.data() + it->second, target.data() + position, DELTA_BLOCK_SIZE) != 0) {
+			position++;
+			continue;
+		}
+
+		// Ve|eXseAV᩵줣ۦP
+		size_t baseStart = it->second;
+		size_t targetStart = position;
+		while (targetStart > literalStart && baseStart > 0 && base[baseStart - 1] == target[targetStart - 1]) {
+			baseStart--;
+			targetStart--;
+		}
+		size_t length = position + DELTA_BLOCK_SIZE - targetStart;
+		while (baseStart + length < base.size() && targetStart + length < target.size() &&
+			base[baseStart + length] == target[targetStart + length]) {
+			length++;
+		}
+
+		appendDeltaAdd(patch, target.data() + literalStart, targetStart - literalStart);
+		patch.push_back((char)DELTA_COPY);
+		appendVarint(patch, baseStart);
+		appendVarint(patch, length);
+		position = targetStart + length;
+		literalStart = position;
+	}
+	appendDeltaAdd(patch, target.data() + literalStart, target.size() - literalStart);
+	return patch;
+}
+
+// ȤݤweOdɲͮtAts@b~ϥ
+static bool makeDelta(const json& request, const FileContent& content, std::string& patch)
+{
+	std::string knownSha256 = request.value("knownSha256", "");
+	if (!options.delta || knownSha256.empty()) {
+		return false;
+	}
+	FileContent base;
+	{
+		std::lock_guard<std::mutex> lock(contentHashMutex);
+		auto it = contentsByHash.find(knownSha256);
+		if (it == contentsByHash.end()) {
+			return false;
+		}
+		base = it->second;
+	}
+	patch = encodeDelta(*base, *content);
+	return patch.size() < content->size() / 2;
+}
+
+// ͼMGeqWơAqH 0xFF R
+static std::vector<char> makeSyntheticImage(size_t size)
+{
+	std::vector<char> image(size, (char)0xFF);
+	size_t dataLength = size / 2;
+	for (size_t i = 0; i < dataLength; i++) {
+		image[i] = (char)((i * 31 + (i >> 8)) & 0xFF);
+	}
+	return image;
+}
+
+// He FNV-1a @AɮפeܮɪH
+static std::string contentVersion(const std::vector<char>& content)
+{
+	uint64_t hash = 14695981039346656037ULL;
+	for (char c : content) {
+		hash = (hash ^ (unsigned char)c) * 1099511628211ULL;
+	}
+	char text[17];
+	snprintf(text, sizeof(text), "%016llx", (unsigned long long)hash);
+	return text;
+}
+
+static FileContent readCachedFile(const std::filesystem::path& path, std::string& version)
+{
+	std::error_code error;
+	auto modified = std::filesystem::last_write_time(path, error);
+	if (error) {
+		return nullptr;
+	}
+	uintmax_t size = std::filesystem::file_size(path, error);
+	if (error) {
+		return nullptr;
+	}
+
+	std::string key = path.string();
+	{
+		std::lock_guard<std::mutex> lock(fileCacheMutex);
+		auto it = fileCache.find(key);
+		if (it != fileCache.end() && it->second.modified == modified && it->second.size == size) {
+			version = it->second.version;
+			return it->second.content;
+		}
+	}
+
+	std::ifstream file(path, std::ios::binary);
+	if (!file) {
+		return nullptr;
+	}
+	auto content = std::make_shared<std::vector<char>>(
+		std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	version = contentVersion(*content);
+
+	std::lock_guard<std::mutex> lock(fileCacheMutex);
+	fileCache[key] = { modified, size, content, version };
+	return content;
+}
+
+static bool loadBinFile(const json& request, std::string& fileName, FileContent& content, std::string& version)
+{
+	const json& askContent = request["askContent"];
+	std::string askId = request.value("askId", "");
+	std::string productSeries = askContent.value("productSeries", "");
+	std::string applicableProjects = askContent.value("applicableProjects", "");
+	std::string customizeId = askContent.value("customizeId", "");
+
+	if (!options.binDirectory.empty()) {
+		std::filesystem::path directory(options.binDirectory);
+		std::vector<std::string> candidates = {
+			askId + "-" + productSeries + "-" + applicableProjects + "-" + customizeId + ".bin",
+			askId + "-" + productSeries + "-" + applicableProjects + ".bin",
+			askId + ".bin",
+		};
+		for (const auto& candidate : candidates) {
+			content = readCachedFile(directory / candidate, version);
+			if (content) {
+				fileName = candidate;
+				return true;
+			}
+		}
+	}
+
+	if (syntheticImage) {
+		content = syntheticImage;
+		version = syntheticVersion;
+		fileName = askId + "-" + customizeId + ".bin";
+		return true;
+	}
+	return false;
+}
+
+static bool handleRequest(int fd, const json& request)
+{
+	// ޽uƪШDb^Ya^ requestId
+	auto reply = [fd, &request](json message) {
+		if (request.contains("requestId")) {
+			message["requestId"] = request["requestId"];
+		}
+		return sendJson(fd, message);
+	};
+
+	std::string askId = request.value("askId", "");
+	bool isGetFile = request.value("isGetFile", false);
+
+	// .bin ɮתG--answers wɨϥΫwȡA_he
+	std::string fileName;
+	FileContent content;
+	std::string version;
+	bool hasFile = loadBinFile(request, fileName, content, version);
+	if (hasFile && answers.contains(askId) && answers[askId].contains("Version")) {
+		version = answers[askId]["Version"];
+	}
+
+	if (isGetFile) {
+		if (!hasFile) {
+			return reply({ {"status", "error"}, {"message", "File not found: " + askId} });
+		}
+
+		// ȤݤwۦPɤǰeɮפe
+		if (request.value("knownVersion", "") == version) {
+			return reply({ {"status", "notModified"}, {"fileName", fileName}, {"Version", version} });
+		}
+
+		json header = { {"status", "success"}, {"fileName", fileName}, {"fileSize", content->size()}, {"Version", version} };
+		std::string sha256 = contentSha256(content);
+		// ˬdXҬɮתȡAd^PY^]ۦP
+		if (options.sendSha256) {
+			header["sha256"] = sha256;
+		}
+		if (options.sendCrc32c) {
+			char crc32c[16];
+			snprintf(crc32c, sizeof(crc32c), "%08x", contentCrc32c(content));
+			header["crc32c"] = crc32c;
+		}
+
+		// ȤݦªɥuǰetA׽ШDd
+		std::string patch;
+		if (makeDelta(request, content, patch)) {
+			header["sha256"] = sha256;
+			header["delta"] = { {"baseVersion", request.value("knownVersion", "")}, {"patchSize", patch.size()} };
+			if (!reply(header)) {
+				return false;
+			}
+			return sendContent(fd, patch.data(), patch.size());
+		}
+
+		// dШDuǰeɮת@AWX׺Iu
+		size_t offset = 0;
+		size_t length = content->size();
+		if (request.contains("range")) {
+			offset = request["range"].value("offset", (size_t)0);
+			length = request["range"].value("length", (size_t)0);
+			if (offset > content->size()) {
+				return reply({ {"status", "error"}, {"message", "Range outside of file: " + askId} });
+			}
+			length = std::min(length, content->size() - offset);
+			header["range"] = { {"offset", offset}, {"length", length} };
+		}
+
+		content = transmittedContent(content);
+		CompressedContent compressed = compressContent(request, content, offset, length);
+		if (compressed) {
+			header["encoding"] = "lz4";
+			header["encodedSize"] = compressed->size();
+		}
+
+		if (!reply(header)) {
+			return false;
+		}
+		if (options.headerGapMs > 0) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(options.headerGapMs));
+		}
+		if (compressed) {
+			return sendContent(fd, compressed->data(), compressed->size());
+		}
+		return sendContent(fd, content->data() + offset, length);
+	}
+
+	if (answers.contains(askId)) {
+		json response = answers[askId];
+		response["status"] = "success";
+		return reply(response);
+	}
+
+	// L askId ɽШD^ .bin ɮתAѫȤˬd֨
+	if (hasFile) {
+		return reply({ {"status", "success"}, {"fileName", fileName}, {"fileSize", content->size()}, {"Version", version} });
+	}
+
+	return reply({ {"status", "error"}, {"message", "Unknown askId: " + askId} });
+}
+
+// @suW޽uƽШDGUۦbu@BzAǤTwA
+// CӦ^ (YPɮפe) b writeMutex UgX
+struct PipelineState
+{
+	std::mutex writeMutex;
+	std::mutex stateMutex;
+	std::condition_variable idle;
+	int active = 0;
+	bool failed = false;
+};
+
+// ^@ӽШDF妸ШḐǦ^CӶءAUرa^妸 requestId
+static bool respond(int fd, const json& request, std::mutex& writeMutex)
+{
+	if (!request.contains("batch")) {
+		std::lock_guard<std::mutex> lock(writeMutex);
+		return handleRequest(fd, request);
+	}
+
+	for (json item : request["batch"]) {
+		if (request.contains("requestId")) {
+			item["requestId"] = request["requestId"];
+		}
+		std::lock_guard<std::mutex> lock(writeMutex);
+		if (!handleRequest(fd, item)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static void dispatchRequest(int fd, const json& request, PipelineState& pipeline)
+{
+	{
+		std::lock_guard<std::mutex> lock(pipeline.stateMutex);
+		pipeline.active++;
+	}
+	std::thread([fd, request, &pipeline]() {
+		if (options.jitterMs > 0) {
+			thread_local std::mt19937 random(std::random_device{}());
+			std::this_thread::sleep_for(std::chrono::milliseconds(random() % (options.jitterMs + 1)));
+		}
+		bool success = respond(fd, request, pipeline.writeMutex);
+		std::lock_guard<std::mutex> lock(pipeline.stateMutex);
+		pipeline.failed = pipeline.failed || !success;
+		pipeline.active--;
+		pipeline.idle.notify_all();
+	}).detach();
+}
+
+static bool serveRequest(int fd, const json& request, PipelineState& pipeline)
+{
+	if (request.contains("requestId")) {
+		dispatchRequest(fd, request, pipeline);
+		std::lock_guard<std::mutex> lock(pipeline.stateMutex);
+		return !pipeline.failed;
+	}
+	return respond(fd, request, pipeline.writeMutex);
+}
+
+static void serveConnection(int fd)
+{
+	std::string buffer;
+	char chunk[4096];
+	bool running = true;
+	PipelineState pipeline;
+
+	while (running) {
+		ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+		if (received <= 0) {
+			if (received < 0 && errno == EINTR) {
+				continue;
+			}
+			break;
+		}
+		buffer.append(chunk, (size_t)received);
+
+		std::string object;
+		while (running && extractJsonObject(buffer, object)) {
+			try {
+				json request = json::parse(object);
+				if (request.value("command", "") == "disconnect") {
+					running = false;
+					break;
+				}
+				running = serveRequest(fd, request, pipeline);
+			}
+			catch (const json::exception& e) {
+				std::lock_guard<std::mutex> lock(pipeline.writeMutex);
+				running = sendJson(fd, { {"status", "error"}, {"message", std::string("Bad request: ") + e.what()} });
+			}
+		}
+	}
+
+	// ݶi椤޽uƽШDg
+	{
+		std::unique_lock<std::mutex> lock(pipeline.stateMutex);
+		pipeline.idle.wait(lock, [&pipeline]() { return pipeline.active == 0; });
+	}
+	close(fd);
+	finishedConnections++;
+}
+
+static void printUsage(const char* program)
+{
+	std::cerr << "Usage: " << program << " [options]\n"
+		<< "  --port N             listen port (default " << DEFAULT_MOCK_PORT << ")\n"
+		<< "  --bin-dir DIR        serve <askId>[-<productSeries>-<applicableProjects>[-<customizeId>]].bin from DIR\n"
+		<< "  --synthetic-size N   serve an N-byte generated image when no file matches\n"
+		<< "  --header-gap-ms N    pause between bin header and body\n"
+		<< "  --answers FILE       JSON object keyed by askId (MainApp, DefaultParameters, ...) with the\n"
+		<< "                       header fields to answer non-file requests with; merged over the defaults\n"
+		<< "  --max-connections N  exit after N connections have closed\n"
+		<< "  --jitter-ms N        delay each pipelined request (one carrying requestId) by a random\n"
+		<< "                       0..N ms so that responses complete out of order\n"
+		<< "  --rate-limit N       send file content at most N bytes per second per response\n"
+		<< "  --drop-after N       close the connection after sending N bytes of a longer file response\n"
+		<< "  --encoding NAME      lz4 (default) compresses file content for clients that accept it,\n"
+		<< "                       identity always sends it uncompressed\n"
+		<< "  --delta on|off       answer requests carrying knownSha256 of a previously served version\n"
+		<< "                       with a delta against it (default on)\n"
+		<< "  --checksum NAME      both (default), crc32c, sha256 or none: whole-file checksums sent in\n"
+		<< "                       file response headers\n"
+		<< "  --corrupt N          flip the byte at file offset N in transmitted content (headers keep the\n"
+		<< "                       checksums of the original content)\n";
+}
+
+static bool parseArguments(int argc, char* argv[])
+{
+	for (int i = 1; i < argc; i++) {
+		std::string argument = argv[i];
+		if (i + 1 >= argc) {
+			return false;
+		}
+		std::string value = argv[++i];
+		if (argument == "--port") {
+			options.port = std::atoi(value.c_str());
+		}
+		else if (argument == "--bin-dir") {
+			options.binDirectory = value;
+		}
+		else if (argument == "--synthetic-size") {
+			options.syntheticSize = (size_t)std::strtoull(value.c_str(), nullptr, 10);
+		}
+		else if (argument == "--header-gap-ms") {
+			options.headerGapMs = std::atoi(value.c_str());
+		}
+		else if (argument == "--answers") {
+			options.answersPath = value;
+		}
+		else if (argument == "--max-connections") {
+			options.maxConnections = std::atoi(value.c_str());
+		}
+		else if (argument == "--jitter-ms") {
+			options.jitterMs = std::atoi(value.c_str());
+		}
+		else if (argument == "--rate-limit") {
+			options.rateLimit = (size_t)std::strtoull(value.c_str(), nullptr, 10);
+		}
+		else if (argument == "--drop-after") {
+			options.dropAfter = (size_t)std::strtoull(value.c_str(), nullptr, 10);
+		}
+		else if (argument == "--encoding") {
+			if (value != "lz4" && value != "identity") {
+				return false;
+			}
+			options.compress = value == "lz4";
+		}
+		else if (argument == "--delta") {
+			if (value != "on" && value != "off") {
+				return false;
+			}
+			options.delta = value == "on";
+		}
+		else if (argument == "--checksum") {
+			if (value != "both" && value != "crc32c" && value != "sha256" && value != "none") {
+				return false;
+			}
+			options.sendCrc32c = value == "both" || value == "crc32c";
+			options.sendSha256 = value == "both" || value == "sha256";
+		}
+		else if (argument == "--corrupt") {
+			options.corruptOffset = std::strtoll(value.c_str(), nullptr, 10);
+		}
+		else {
+			return false;
+		}
+	}
+	return true;
+}
+
+static void addDefaultShieldedZones()
+{
+	json zones = json::array();
+	for (int i = 0; i < 8; i++) {
+		zones.push_back({ {"start", i * 0x1000}, {"end", i * 0x1000 + 0x7FF} });
+	}
+	answers["DefaultParameters"]["ShieldedZoneCount"] = zones.size();
+	answers["DefaultParameters"]["ShieldedZone"] = zones;
+}
+
+static bool loadAnswers(const std::string& path)
+{
+	std::ifstream file(path);
+	if (!file) {
+		std::cerr << "mock_server: cannot open answers file " << path << std::endl;
+		return false;
+	}
+	try {
+		json overrides = json::parse(file);
+		for (auto& [askId, fields] : overrides.items()) {
+			if (!fields.is_object()) {
+				std::cerr << "mock_server: answer for " << askId << " must be an object" << std::endl;
+				return false;
+			}
+			answers[askId].update(fields);
+		}
+		// uwϬq}CɡA۰ʸɤWƶq
+		auto& parameters = answers["DefaultParameters"];
+		if (overrides.contains("DefaultParameters") && overrides["DefaultParameters"].contains("ShieldedZone")
+			&& !overrides["DefaultParameters"].contains("ShieldedZoneCount")) {
+			parameters["ShieldedZoneCount"] = parameters["ShieldedZone"].size();
+		}
+	}
+	catch (const json::exception& e) {
+		std::cerr << "mock_server: invalid answers file " << path << ": " << e.what() << std::endl;
+		return false;
+	}
+	return true;
+}
+
+int main(int argc, char* argv[])
+{
+	if (!parseArguments(argc, argv)) {
+		printUsage(argv[0]);
+		return 2;
+	}
+	signal(SIGPIPE, SIG_IGN);
+
+	addDefaultShieldedZones();
+	if (!options.answersPath.empty() && !loadAnswers(options.answersPath)) {
+		return 2;
+	}
+	if (options.syntheticSize > 0) {
+		syntheticImage = std::make_shared<const std::vector<char>>(makeSyntheticImage(options.syntheticSize));
+		syntheticVersion = contentVersion(*syntheticImage);
+	}
+
+	int listenFd = socket(AF_INET, SOCK_STREAM, 0);
+	int enable = 1;
+	setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+	struct sockaddr_in address;
+	memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	address.sin_port = htons((uint16_t)options.port);
+
+	if (bind(listenFd, (struct sockaddr*)&address, sizeof(address)) != 0 || listen(listenFd, 128) != 0) {
+		std::cerr << "mock_server: cannot listen on port " << options.port << ": " << strerror(errno) << std::endl;
+		return 1;
+	}
+	std::cerr << "mock_server: listening on 127.0.0.1:" << options.port << std::endl;
+
+	int acceptedConnections = 0;
+	std::vector<std::thread> workers;
+	while (options.maxConnections == 0 || acceptedConnections < options.maxConnections) {
+		int clientFd = accept(listenFd, nullptr, nullptr);
+		if (clientFd < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			break;
+		}
+		setsockopt(clientFd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+		acceptedConnections++;
+		workers.emplace_back(serveConnection, clientFd);
+	}
+
+	for (auto& worker : workers) {
+		worker.join();
+	}
+	close(listenFd);
+	return 0;
+}
@@ -0,0 +1,46 @@
+// PGO Vm{G糧AȾư@미IШDy{
+// AȾ} SOCKETCLIENT_ADDRESS / SOCKETCLIENT_PORT ܼƫw
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include "SocketClient.h"
+
+int main(int argc, char* argv[])
+{
+	int iterations = argc > 1 ? std::atoi(argv[1]) : 200;
+
+	// AȾiP{PɱҰʡAsuѮɵy᭫
+	bool connected = false;
+	for (int attempt = 0; attempt < 50 && !connected; attempt++) {
+		connected = InitializeClient("PGO", "Training", "0", "pgo");
+		if (!connected) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		}
+	}
+	if (!connected) {
+		std::cerr << "pgo_training: unable to connect to mock server" << std::endl;
+		return 1;
+	}
+
+	int failures = 0;
+	for (int i = 0; i < iterations; i++) {
+		MainAppInfo* mainAppInfo = GetMainAppInfo("BMS", "Thai", "10000");
+		DefaultParametersInfo* defaultParametersInfo = GetDefaultParametersInfo("BMS", "Thai", "10000");
+		FileInfo* fileInfo = GetBinFileInfo("MainApp", "BMS", "Thai", "10000");
+
+		if (!mainAppInfo || !defaultParametersInfo || !fileInfo) {
+			failures++;
+		}
+		delete mainAppInfo;
+		delete defaultParametersInfo;
+		FreeFileInfo(fileInfo);
+	}
+
+	CloseConnection();
+
+	// ѪШD| profile ơAuѤ~Vm
+	std::cout << "pgo_training: " << iterations << " iterations, " << failures << " failures" << std::endl;
+	return failures < iterations ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+#include "pch.h"
+#include "AsyncRequest.h"
+#include <chrono>
+
+SocketClientAsyncRequest::SocketClientAsyncRequest(AsyncCompletionCallback callback, void* userData)
+	: callback(callback), userData(userData)
+{
+}
+
+SocketClientAsyncRequest::~SocketClientAsyncRequest()
+{
+	// IsݨSG
+	FreeFileInfo(result.fileInfo);
+	delete result.mainAppInfo;
+	delete result.defaultParametersInfo;
+}
+
+void SocketClientAsyncRequest::complete(const AsyncResult& value)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		result = value;
+		done = true;
+	}
+	completed.notify_all();
+
+	if (callback) {
+		callback(this, userData);
+	}
+	release();
+}
+
+bool SocketClientAsyncRequest::wait(int timeoutMs)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	if (timeoutMs < 0) {
+		completed.wait(lock, [this] { return done; });
+		return true;
+	}
+	return completed.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] { return done; });
+}
+
+bool SocketClientAsyncRequest::take(AsyncResult& value)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (!done) {
+		return false;
+	}
+	value = result;
+	result.fileInfo = nullptr;
+	result.mainAppInfo = nullptr;
+	result.defaultParametersInfo = nullptr;
+	return true;
+}
+
+void SocketClientAsyncRequest::release()
+{
+	bool last;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		last = --references == 0;
+	}
+	if (last) {
+		delete this;
+	}
+}
+
+AsyncExecutor::AsyncExecutor(size_t threadCount)
+{
+	for (size_t i = 0; i < threadCount; i++) {
+		workers.emplace_back([this] { run(); });
+	}
+}
+
+AsyncExecutor::~AsyncExecutor()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	taskReady.notify_all();
+	for (auto& worker : workers) {
+		worker.join();
+	}
+}
+
+void AsyncExecutor::submit(std::function<void(bool run)> task)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		tasks.push_back(std::move(task));
+	}
+	taskReady.notify_one();
+}
+
+void AsyncExecutor::run()
+{
+	while (true) {
+		std::function<void(bool)> task;
+		bool cancelled;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			taskReady.wait(lock, [this] { return stopping || !tasks.empty(); });
+			if (tasks.empty()) {
+				return;
+			}
+			task = std::move(tasks.front());
+			tasks.pop_front();
+			cancelled = stopping;
+		}
+		task(!cancelled);
+	}
+}
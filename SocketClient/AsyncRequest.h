@@ -0,0 +1,79 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "SocketClient.h"
+
+/// <summary>
+/// DPBШDAA C API  AsyncRequest
+/// IsݻPШDU@ӰѷӡA̳~RA
+/// IsݴH FreeAsyncRequest ɡAGb
+/// </summary>
+struct SocketClientAsyncRequest
+{
+	SocketClientAsyncRequest(AsyncCompletionCallback callback, void* userData);
+
+	SocketClientAsyncRequest(const SocketClientAsyncRequest&) = delete;
+	SocketClientAsyncRequest& operator=(const SocketClientAsyncRequest&) = delete;
+
+	/// <summary>
+	/// OGóݪAAIs^IA̫ѷ
+	/// </summary>
+	void complete(const AsyncResult& result);
+
+	/// <summary>
+	/// ݧ
+	/// </summary>
+	/// <param name="timeoutMs">O (@)A0 ܤݡAtƪܤ@</param>
+	/// <returns>wɦ^ true</returns>
+	bool wait(int timeoutMs);
+
+	/// <summary>
+	/// GAᵲGХѩIsF|ɦ^ false
+	/// </summary>
+	bool take(AsyncResult& result);
+
+	void release();
+
+private:
+	AsyncCompletionCallback callback;
+	void* userData;
+
+	std::mutex mutex;
+	std::condition_variable completed;
+	bool done = false;
+	AsyncResult result = {};
+	int references = 2;
+
+	~SocketClientAsyncRequest();
+};
+
+/// <summary>
+/// DPBШDu@A̰eXǨXu@
+/// ɩ|}lu@H run = false Is (Hѧ)A椤u@|ݨ䵲
+/// </summary>
+class AsyncExecutor
+{
+public:
+	explicit AsyncExecutor(size_t threadCount);
+	~AsyncExecutor();
+
+	AsyncExecutor(const AsyncExecutor&) = delete;
+	AsyncExecutor& operator=(const AsyncExecutor&) = delete;
+
+	void submit(std::function<void(bool run)> task);
+
+private:
+	std::mutex mutex;
+	std::condition_variable taskReady;
+	std::deque<std::function<void(bool)>> tasks;
+	bool stopping = false;
+	std::vector<std::thread> workers;
+
+	void run();
+};
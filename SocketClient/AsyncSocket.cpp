@@ -0,0 +1,226 @@
+#include "pch.h"
+#include "AsyncSocket.h"
+#include "EventLoop.h"
+#include "Logger.h"
+#include "Transport.h"
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netdb.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <memory>
+#include <mutex>
+
+// IѪRGFѪRPݪ{@PA{QPɲM handle
+struct ResolveState
+{
+	std::mutex mutex;
+	std::coroutine_handle<> handle;
+	struct addrinfo* result = nullptr;
+	int error = 0;
+};
+
+// ѪR}GƦr}Al浹j骺IA^ƥj
+struct ResolveAwaiter
+{
+	EventLoop& loop;
+	const std::string& address;
+	const std::string& port;
+	struct addrinfo* result = nullptr;
+	int error = 0;
+	std::shared_ptr<ResolveState> state;
+
+	ResolveAwaiter(EventLoop& loop, const std::string& address, const std::string& port)
+		: loop(loop), address(address), port(port)
+	{
+	}
+
+	ResolveAwaiter(const ResolveAwaiter&) = delete;
+	ResolveAwaiter& operator=(const ResolveAwaiter&) = delete;
+
+	~ResolveAwaiter() {
+		if (state) {
+			std::lock_guard<std::mutex> lock(state->mutex);
+			state->handle = nullptr;
+			if (state->result) {
+				freeaddrinfo(state->result);
+				state->result = nullptr;
+			}
+		}
+		if (result) {
+			freeaddrinfo(result);
+		}
+	}
+
+	static struct addrinfo hints(int flags) {
+		struct addrinfo value;
+		memset(&value, 0, sizeof(value));
+		value.ai_family = AF_UNSPEC;
+		value.ai_socktype = SOCK_STREAM;
+		value.ai_protocol = IPPROTO_TCP;
+		value.ai_flags = flags;
+		return value;
+	}
+
+	bool await_ready() {
+		struct addrinfo numeric = hints(AI_NUMERICHOST);
+		error = getaddrinfo(address.c_str(), port.c_str(), &numeric, &result);
+		return error != EAI_NONAME;
+	}
+
+	// uϥΦۤv}ƥP stateAĲΨ{ج[
+	void await_suspend(std::coroutine_handle<> awaiting) {
+		state = std::make_shared<ResolveState>();
+		state->handle = awaiting;
+		loop.runBlocking([&loop = loop, state = state, address = address, port = port] {
+			struct addrinfo any = hints(0);
+			struct addrinfo* resolved = nullptr;
+			int resolveError = getaddrinfo(address.c_str(), port.c_str(), &any, &resolved);
+
+			std::lock_guard<std::mutex> lock(state->mutex);
+			if (!state->handle) {
+				if (resolved) {
+					freeaddrinfo(resolved);
+				}
+				return;
+			}
+			state->result = resolved;
+			state->error = resolveError;
+			loop.post(state->handle);
+		});
+	}
+
+	int await_resume() {
+		if (state) {
+			std::lock_guard<std::mutex> lock(state->mutex);
+			result = state->result;
+			error = state->error;
+			state->result = nullptr;
+		}
+		return error;
+	}
+};
+
+AsyncSocket::AsyncSocket(EventLoop& loop)
+	: loop(loop)
+{
+}
+
+AsyncSocket::~AsyncSocket()
+{
+	close();
+}
+
+Task<bool> AsyncSocket::connect(std::string address, std::string port)
+{
+	close();
+
+	ResolveAwaiter resolve{ loop, address, port };
+	int iResult = co_await resolve;
+	if (iResult != 0) {
+		errorCode = iResult;
+		Logger::error("getaddrinfo failed with error: " + std::string(gai_strerror(iResult)));
+		co_return false;
+	}
+
+	// ճsAȾ
+	for (struct addrinfo* ptr = resolve.result; ptr != NULL; ptr = ptr->ai_next) {
+		socketFd = socket(ptr->ai_family, ptr->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, ptr->ai_protocol);
+		if (socketFd < 0) {
+			errorCode = errno;
+			Logger::error("Socket creation failed with error: " + std::to_string(errorCode));
+			break;
+		}
+
+		if (::connect(socketFd, ptr->ai_addr, ptr->ai_addrlen) == 0) {
+			break;
+		}
+		if (errno == EINPROGRESS) {
+			bool ready = co_await loop.waitWritable(socketFd, std::chrono::milliseconds(DEFAULT_CONNECT_TIMEOUT_MS));
+			int soError = ETIMEDOUT;
+			socklen_t soErrorLen = sizeof(soError);
+			if (ready && getsockopt(socketFd, SOL_SOCKET, SO_ERROR, &soError, &soErrorLen) != 0) {
+				soError = errno;
+			}
+			if (soError == 0) {
+				break;
+			}
+			errorCode = soError;
+		}
+		else {
+			errorCode = errno;
+		}
+
+		close();
+		Logger::debug("Connection attempt failed, trying next address...");
+	}
+
+	co_return socketFd >= 0;
+}
+
+Task<int> AsyncSocket::send(const char* data, size_t length)
+{
+	size_t totalSent = 0;
+	while (totalSent < length) {
+		ssize_t sent = ::send(socketFd, data + totalSent, length - totalSent, MSG_NOSIGNAL);
+		if (sent >= 0) {
+			totalSent += (size_t)sent;
+			continue;
+		}
+		if (errno == EINTR) {
+			continue;
+		}
+		if (errno != EAGAIN && errno != EWOULDBLOCK) {
+			errorCode = errno;
+			co_return -1;
+		}
+		bool writable = co_await loop.waitWritable(socketFd, std::chrono::milliseconds(DEFAULT_IO_TIMEOUT_MS));
+		if (!writable) {
+			errorCode = ETIMEDOUT;
+			co_return -1;
+		}
+	}
+	co_return (int)totalSent;
+}
+
+Task<int> AsyncSocket::receive(char* buffer, size_t length)
+{
+	while (true) {
+		// ŪAuƩ|Fɤ~浹ƥj鵥
+		ssize_t received = recv(socketFd, buffer, length, 0);
+		if (received >= 0) {
+			co_return (int)received;
+		}
+		if (errno == EINTR) {
+			continue;
+		}
+		if (errno != EAGAIN && errno != EWOULDBLOCK) {
+			errorCode = errno;
+			co_return -1;
+		}
+		bool readable = co_await loop.waitReadable(socketFd, std::chrono::milliseconds(DEFAULT_IO_TIMEOUT_MS));
+		if (!readable) {
+			errorCode = ETIMEDOUT;
+			co_return -1;
+		}
+	}
+}
+
+bool AsyncSocket::shutdownSend()
+{
+	if (shutdown(socketFd, SHUT_WR) != 0) {
+		errorCode = errno;
+		return false;
+	}
+	return true;
+}
+
+void AsyncSocket::close()
+{
+	if (socketFd >= 0) {
+		loop.forget(socketFd);
+		::close(socketFd);
+		socketFd = -1;
+	}
+}
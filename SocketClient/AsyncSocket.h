@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include "Task.h"
+
+class EventLoop;
+
+/// <summary>
+/// ѨƥjXʪD socketAsuBǰePOi co_await u@
+/// OɻP EpollTransport ۦP (DEFAULT_CONNECT_TIMEOUT_MS / DEFAULT_IO_TIMEOUT_MS)
+/// </summary>
+class AsyncSocket
+{
+public:
+	explicit AsyncSocket(EventLoop& loop);
+	~AsyncSocket();
+
+	AsyncSocket(const AsyncSocket&) = delete;
+	AsyncSocket& operator=(const AsyncSocket&) = delete;
+
+	/// <summary>
+	/// ѪR}ósAȾA̧ǹըCӸѪRG
+	/// DƦr}bt@ӰWѪRAƥj
+	/// </summary>
+	Task<bool> connect(std::string address, std::string port);
+
+	/// <summary>
+	/// ǰe
+	/// </summary>
+	/// <returns>ǰe줸ռơAѦ^ -1</returns>
+	Task<int> send(const char* data, size_t length);
+
+	/// <summary>
+	/// ơA̦h length 줸
+	/// </summary>
+	/// <returns>줸ռơAsu^ 0AѦ^ -1</returns>
+	Task<int> receive(char* buffer, size_t length);
+
+	bool shutdownSend();
+
+	void close();
+
+	bool isConnected() const {
+		return socketFd >= 0;
+	}
+
+	/// <summary>
+	/// ̪@Ѫ errno
+	/// </summary>
+	int lastError() const {
+		return errorCode;
+	}
+
+private:
+	EventLoop& loop;
+	int socketFd = -1;
+	int errorCode = 0;
+};
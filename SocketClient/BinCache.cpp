@@ -0,0 +1,238 @@
+#include "pch.h"
+#include "BinCache.h"
+#include "Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+#include "json.hpp"
+
+using json = nlohmann::json;
+
+#define OBJECT_EXTENSION ".bin"
+#define INDEX_EXTENSION ".json"
+#define TEMPORARY_EXTENSION ".tmp"
+
+BinCache::BinCache(const std::string& directory, uint64_t maxBytes)
+	: objectDirectory(std::filesystem::path(directory) / "objects"),
+	indexDirectory(std::filesystem::path(directory) / "index"),
+	maxBytes(maxBytes)
+{
+	std::error_code error;
+	std::filesystem::create_directories(objectDirectory, error);
+	std::filesystem::create_directories(indexDirectory, error);
+	if (error) {
+		Logger::error("Failed to create cache directory " + directory + ": " + error.message());
+	}
+}
+
+std::filesystem::path BinCache::indexPath(const BinCacheKey& key) const
+{
+	// HШDѼƪ@ɦWAקKѼƤSr
+	std::string tuple = key.askId + '\n' + key.productSeries + '\n' + key.applicableProjects + '\n' + key.customizeId;
+	return indexDirectory / (Sha256::hex(tuple.data(), tuple.size()) + INDEX_EXTENSION);
+}
+
+std::filesystem::path BinCache::temporaryPath(const std::filesystem::path& directory) const
+{
+	static std::atomic<uint64_t> sequence(0);
+	auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+	size_t thread = std::hash<std::thread::id>()(std::this_thread::get_id());
+	return directory / (std::to_string(now) + "-" + std::to_string(thread) + "-" +
+		std::to_string(sequence++) + TEMPORARY_EXTENSION);
+}
+
+bool BinCache::lookup(const BinCacheKey& key, BinCacheEntry& entry)
+{
+	std::ifstream file(indexPath(key));
+	if (!file) {
+		return false;
+	}
+
+	try {
+		json index = json::parse(file);
+		entry.version = index["version"];
+		entry.fileName = index["fileName"];
+		entry.sha256 = index["sha256"];
+		entry.fileSize = index["fileSize"];
+	}
+	catch (const json::exception& e) {
+		Logger::error("Invalid cache index for " + key.askId + ": " + std::string(e.what()));
+		return false;
+	}
+
+	std::filesystem::path object = objectDirectory / (entry.sha256 + OBJECT_EXTENSION);
+	std::error_code error;
+	if (std::filesystem::file_size(object, error) != entry.fileSize || error) {
+		return false;
+	}
+
+	// sϥήɶAѮeqP_̤[ϥΪɮ
+	std::filesystem::last_write_time(object, std::filesystem::file_time_type::clock::now(), error);
+	entry.objectPath = object.string();
+	return true;
+}
+
+bool BinCache::writeIndex(const BinCacheKey& key, const BinCacheEntry& entry)
+{
+	json index = {
+		{"askId", key.askId},
+		{"productSeries", key.productSeries},
+		{"applicableProjects", key.applicableProjects},
+		{"customizeId", key.customizeId},
+		{"version", entry.version},
+		{"fileName", entry.fileName},
+		{"fileSize", entry.fileSize},
+		{"sha256", entry.sha256},
+	};
+	std::string text = index.dump();
+
+	std::filesystem::path temporary = temporaryPath(indexDirectory);
+	{
+		std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+		file.write(text.data(), text.size());
+		if (!file.good()) {
+			Logger::error("Failed to write cache index " + temporary.string());
+			std::error_code error;
+			std::filesystem::remove(temporary, error);
+			return false;
+		}
+	}
+
+	std::error_code error;
+	std::filesystem::rename(temporary, indexPath(key), error);
+	if (error) {
+		Logger::error("Failed to update cache index: " + error.message());
+		std::filesystem::remove(temporary, error);
+		return false;
+	}
+	return true;
+}
+
+BinCache::Writer::Writer(BinCache& cache, const BinCacheKey& key, const std::string& version, const std::string& fileName)
+	: cache(cache), key(key), version(version), fileName(fileName),
+	temporaryPath(cache.temporaryPath(cache.objectDirectory)),
+	file(temporaryPath, std::ios::binary | std::ios::trunc)
+{
+}
+
+BinCache::Writer::~Writer()
+{
+	if (!committed) {
+		file.close();
+		std::error_code error;
+		std::filesystem::remove(temporaryPath, error);
+	}
+}
+
+bool BinCache::Writer::write(const char* data, size_t length)
+{
+	sha.update(data, length);
+	file.write(data, length);
+	size += length;
+	return file.good();
+}
+
+bool BinCache::Writer::commit(const std::string& expectedSha256)
+{
+	file.close();
+	if (file.fail()) {
+		Logger::error("Failed to write cache file " + temporaryPath.string());
+		return false;
+	}
+
+	BinCacheEntry entry;
+	entry.version = version;
+	entry.fileName = fileName;
+	entry.fileSize = size;
+	entry.sha256 = sha.finishHex();
+	if (!expectedSha256.empty() && entry.sha256 != expectedSha256) {
+		Logger::error("SHA-256 of " + fileName + " does not match: expected " + expectedSha256 + ", got " + entry.sha256);
+		return false;
+	}
+
+	// ۦPewsbɪϥΡAƦs
+	std::filesystem::path object = cache.objectDirectory / (entry.sha256 + OBJECT_EXTENSION);
+	std::error_code error;
+	if (std::filesystem::exists(object, error)) {
+		std::filesystem::remove(temporaryPath, error);
+	}
+	else {
+		std::filesystem::rename(temporaryPath, object, error);
+		if (error) {
+			Logger::error("Failed to add cache file: " + error.message());
+			return false;
+		}
+	}
+	committed = true;
+
+	if (!cache.writeIndex(key, entry)) {
+		return false;
+	}
+	Logger::debug("Cached " + fileName + " (" + entry.sha256 + ") for version " + version);
+	cache.trim();
+	return true;
+}
+
+std::unique_ptr<BinCache::Writer> BinCache::beginStore(const BinCacheKey& key, const std::string& version, const std::string& fileName)
+{
+	std::unique_ptr<Writer> writer(new Writer(*this, key, version, fileName));
+	if (!writer->file) {
+		Logger::error("Failed to create cache file " + writer->temporaryPath.string());
+		return nullptr;
+	}
+	return writer;
+}
+
+bool BinCache::store(const BinCacheKey& key, const std::string& version, const std::string& fileName, const char* data, size_t size)
+{
+	auto writer = beginStore(key, version, fileName);
+	return writer && writer->write(data, size) && writer->commit();
+}
+
+void BinCache::trim()
+{
+	if (maxBytes == 0) {
+		return;
+	}
+
+	struct ObjectFile
+	{
+		std::filesystem::path path;
+		std::filesystem::file_time_type lastUsed;
+		uintmax_t size;
+	};
+
+	std::vector<ObjectFile> objects;
+	uintmax_t totalSize = 0;
+	std::error_code error;
+	for (const auto& item : std::filesystem::directory_iterator(objectDirectory, error)) {
+		if (item.path().extension() != OBJECT_EXTENSION) {
+			continue;
+		}
+		ObjectFile object{ item.path(), item.last_write_time(error), item.file_size(error) };
+		if (!error) {
+			totalSize += object.size;
+			objects.push_back(object);
+		}
+	}
+	if (totalSize <= maxBytes) {
+		return;
+	}
+
+	// ѳ̤[ϥΪɮ׶}lRAޫVwRɮ׮ɵR
+	std::sort(objects.begin(), objects.end(), [](const ObjectFile& a, const ObjectFile& b) {
+		return a.lastUsed < b.lastUsed;
+	});
+	for (const auto& object : objects) {
+		if (totalSize <= maxBytes) {
+			break;
+		}
+		if (std::filesystem::remove(object.path, error)) {
+			totalSize -= object.size;
+			Logger::debug("Evicted cache file " + object.path.filename().string());
+		}
+	}
+}
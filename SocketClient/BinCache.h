@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include "Sha256.h"
+
+/// <summary>
+/// ֨G@ .bin ɮ׽ШDѼ
+/// </summary>
+struct BinCacheKey
+{
+	std::string askId;
+	std::string productSeries;
+	std::string applicableProjects;
+	std::string customizeId;
+};
+
+/// <summary>
+/// ޤeGYӽШDbYӪAȾUɮ
+/// </summary>
+struct BinCacheEntry
+{
+	std::string version;
+	std::string fileName;
+	std::string sha256;
+	size_t fileSize = 0;
+	std::string objectPath;
+};
+
+/// <summary>
+/// .bin ɮת֨
+/// ɮפeH SHA-256 RWsb objects/AۦPeus@F
+/// index/ HШDѼƬOAȾPe
+/// ҦgJgȦsɦAWAhӰΦ{@ΦP@ؿ]|Ū줣㪺ɮ
+/// </summary>
+class BinCache
+{
+public:
+	/// <param name="directory">֨ؿ</param>
+	/// <param name="maxBytes">objects/ jpWAWLɧR̤[ϥΪɮסF0 ܤ</param>
+	BinCache(const std::string& directory, uint64_t maxBytes);
+
+	/// <summary>
+	/// gJ@ɮסA䱵pAcommit ~[J֨
+	/// </summary>
+	class Writer
+	{
+	public:
+		~Writer();
+
+		bool write(const char* data, size_t size);
+
+		/// <summary>
+		/// gJçs
+		/// </summary>
+		/// <param name="expectedSha256">DŮɤeꥲۦPA_h˱gJe</param>
+		bool commit(const std::string& expectedSha256 = std::string());
+
+	private:
+		friend class BinCache;
+		Writer(BinCache& cache, const BinCacheKey& key, const std::string& version, const std::string& fileName);
+
+		BinCache& cache;
+		BinCacheKey key;
+		std::string version;
+		std::string fileName;
+		std::filesystem::path temporaryPath;
+		std::ofstream file;
+		Sha256 sha;
+		size_t size = 0;
+		bool committed = false;
+	};
+
+	/// <summary>
+	/// d߽ШD֨ɮסARɧsɮתϥήɶ
+	/// ֨ɮ׬O_̷sѩIsݥH entry.version VAȾT{
+	/// </summary>
+	/// <returns>ަsbBɮקɦ^ true</returns>
+	bool lookup(const BinCacheKey& key, BinCacheEntry& entry);
+
+	/// <summary>
+	/// }lgJ@ɮ
+	/// </summary>
+	/// <returns>Lkإ߼Ȧsɮɦ^ nullptr</returns>
+	std::unique_ptr<Writer> beginStore(const BinCacheKey& key, const std::string& version, const std::string& fileName);
+
+	/// <summary>
+	/// gJw㱵ɮ
+	/// </summary>
+	bool store(const BinCacheKey& key, const std::string& version, const std::string& fileName, const char* data, size_t size);
+
+private:
+	std::filesystem::path objectDirectory;
+	std::filesystem::path indexDirectory;
+	uint64_t maxBytes;
+
+	std::filesystem::path indexPath(const BinCacheKey& key) const;
+	std::filesystem::path temporaryPath(const std::filesystem::path& directory) const;
+	bool writeIndex(const BinCacheKey& key, const BinCacheEntry& entry);
+	void trim();
+};
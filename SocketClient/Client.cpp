@@ -0,0 +1,1539 @@
+#include "pch.h"
+#include "Client.h"
+#include "Connection.h"
+#include "DeltaPatch.h"
+#include "Logger.h"
+#include "MappedFile.h"
+#include "Transport.h"
+#include <stdlib.h>
+#include <string.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+#include "json.hpp"
+
+using json = nlohmann::json;
+
+#define STREAM_CHUNK_SIZE 256 * 1024 // 256KB
+#define VERIFY_CHUNK_SIZE 64 * 1024  // pˬdXɨCסAƤb CPU ֨
+#define DEFAULT_POOL_SIZE 1
+#define DEFAULT_IDLE_TIMEOUT_MS 60000
+#define RANGE_FIRST_SIZE 1024 * 1024 // qUɲĤ@ӽШDdApɮפ@o
+#define RANGE_MIN_SIZE 1024 * 1024   // Cq̤p
+#define DEFAULT_RESUME_ATTEMPTS 3
+#define RESUME_DELAY_MS 500          //  n ssue n ɶ
+#define PARTIAL_INDEX_EXTENSION ".json" // ȦsǰOɦWAb .part 
+
+// MainApp / DefaultParameters T֨
+static std::string infoCacheKey(const char* productSeries, const char* applicableProjects, const char* customizeId)
+{
+	std::string key;
+	for (const char* value : { productSeries, applicableProjects, customizeId }) {
+		key += value ? value : "";
+		key += '\n';
+	}
+	return key;
+}
+
+Client::Client(const ClientOptions& options)
+	: options(options),
+	mainAppCache(std::chrono::milliseconds(options.infoCacheTtlMs)),
+	defaultParametersCache(std::chrono::milliseconds(options.infoCacheTtlMs))
+{
+	if (this->options.poolSize <= 0) {
+		this->options.poolSize = DEFAULT_POOL_SIZE;
+	}
+	if (this->options.idleTimeoutMs <= 0) {
+		this->options.idleTimeoutMs = DEFAULT_IDLE_TIMEOUT_MS;
+	}
+	if (this->options.pipelineDepth <= 0) {
+		this->options.pipelineDepth = 1;
+	}
+	if (this->options.rangeConnections <= 0) {
+		this->options.rangeConnections = 1;
+	}
+	if (this->options.resumeAttempts < 0) {
+		this->options.resumeAttempts = 0;
+	}
+	if (options.cacheDirectory && *options.cacheDirectory) {
+		cache = std::make_unique<BinCache>(options.cacheDirectory, options.cacheMaxBytes);
+	}
+	// Isݪrbإ߫ᤣOҦ
+	this->options.cacheDirectory = nullptr;
+}
+
+Client::~Client()
+{
+	// DPBШDA椤ШD|ϥγsu
+	executor.reset();
+
+	std::lock_guard<std::mutex> lock(stateMutex);
+	if (isInitialized) {
+		closeConnectionLocked();
+	}
+}
+
+ClientOptions Client::defaultOptions()
+{
+	ClientOptions options;
+	options.poolSize = DEFAULT_POOL_SIZE;
+	options.idleTimeoutMs = DEFAULT_IDLE_TIMEOUT_MS;
+	options.cacheDirectory = nullptr;
+	options.cacheMaxBytes = 0;
+	options.infoCacheTtlMs = 0;
+	options.pipelineDepth = 1;
+	options.transportBackend = TRANSPORT_DEFAULT;
+	options.rangeConnections = 1;
+	options.resumeAttempts = DEFAULT_RESUME_ATTEMPTS;
+	return options;
+}
+
+bool Client::initialize(
+	const char* stationType,
+	const char* stationName,
+	const char* stationId,
+	const char* operatorId
+) {
+	std::lock_guard<std::mutex> lock(stateMutex);
+
+	Logger::info("Initializing client...");
+	Logger::debug("Station Type: " + std::string(stationType) +
+		", Station Name: " + std::string(stationName) +
+		", Station ID: " + std::string(stationId) +
+		", Operator ID: " + std::string(operatorId));
+
+	if (isInitialized) {
+		Logger::info("Client already initialized");
+		return true;
+	}
+
+	// lƺ禡w
+	int iResult = TransportStartup();
+	if (iResult != 0) {
+		Logger::error("TransportStartup failed with error: " + std::to_string(iResult));
+		return false;
+	}
+
+	// إ߳suùwsAȾ
+	pool = std::make_shared<ConnectionPool>(ServerAddress(), ServerPort(),
+		(size_t)options.poolSize, std::chrono::milliseconds(options.idleTimeoutMs), (size_t)options.pipelineDepth, &metrics,
+		options.transportBackend);
+	if (pool->warmUp((size_t)options.poolSize) == 0) {
+		pool.reset();
+		TransportCleanup();
+		return false;
+	}
+
+	Logger::info("Client initialized successfully");
+	this->stationId = stationId;
+	isInitialized = true;
+	return true;
+}
+
+PooledConnection Client::acquireConnection(const char* caller)
+{
+	std::shared_ptr<ConnectionPool> currentPool;
+	{
+		std::lock_guard<std::mutex> lock(stateMutex);
+		if (!isInitialized || !pool) {
+			Logger::error(std::string(caller) + " called while not initialized");
+			return PooledConnection();
+		}
+		currentPool = pool;
+	}
+	return currentPool->acquire();
+}
+
+int Client::sendData(
+	const char* askId,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	bool isGetFile
+) {
+	// ШDP^ݨ⦸ɥΡALk޽uƪ^Asuhsuɤ]iɨ줣Psu
+	if (options.pipelineDepth > 1) {
+		Logger::error("SendData is not available when pipelining is enabled");
+		return -1;
+	}
+	if (options.poolSize > 1) {
+		Logger::error("SendData is not available with more than one pooled connection");
+		return -1;
+	}
+
+	PooledConnection connection = acquireConnection("SendData");
+	if (!connection) {
+		return -1;
+	}
+	return connection->sendRequest(askId, productSeries, applicableProjects, customizeId, isGetFile);
+}
+
+int Client::receiveData(char* buffer, int bufferSize)
+{
+	// ܤֻݭn@ӸƦ줸ջPrŶ
+	if (!buffer || bufferSize < 2) {
+		Logger::error("ReceiveData called with a buffer smaller than 2 bytes");
+		return -1;
+	}
+	if (options.pipelineDepth > 1) {
+		Logger::error("ReceiveData is not available when pipelining is enabled");
+		return -1;
+	}
+	if (options.poolSize > 1) {
+		Logger::error("ReceiveData is not available with more than one pooled connection");
+		return -1;
+	}
+
+	PooledConnection connection = acquireConnection("ReceiveData");
+	if (!connection) {
+		return -1;
+	}
+
+	// OdrŶ
+	int iResult = connection->receive(buffer, (size_t)(bufferSize - 1));
+	if (iResult > 0) {
+		// TOrŦפ
+		buffer[iResult] = '\0';
+	}
+	return iResult;
+}
+
+bool Client::closeConnection()
+{
+	std::lock_guard<std::mutex> lock(stateMutex);
+	return closeConnectionLocked();
+}
+
+bool Client::closeConnectionLocked()
+{
+	Logger::info("Closing connection...");
+	bool closed = true;
+	if (pool) {
+		// ɥXsubШDkٮ
+		closed = pool->closeAll();
+		pool.reset();
+	}
+	if (isInitialized) {
+		int cleanupResult = TransportCleanup();
+		if (cleanupResult != 0) {
+			// Mz Windows Sockets ɵoͿ~
+			Logger::error("WSACleanup failed with error: " + std::to_string(cleanupResult));
+			return false;
+		}
+		isInitialized = false;
+	}
+	if (!closed) {
+		return false;
+	}
+
+	// 
+	Logger::info("Connection closed successfully");
+	Logger::flush();
+	return true;
+}
+
+// oe .bin ɮ׽ШDñ JSON headerA\BD notModified ɮפe򱵦bsu
+bool Client::requestBinFile(
+	const char* caller,
+	Connection& connection,
+	const char* askId,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	const char* knownVersion,
+	BinFileHeader& result,
+	ByteRange range,
+	const char* knownSha256
+) {
+	Logger::info("Getting binary file info...");
+
+	// oeШDT
+	AskRequest request = { askId, productSeries, applicableProjects, customizeId, true, knownVersion, range, true, knownSha256 };
+	int sendResult = connection.sendRequest(request);
+	if (sendResult <= 0) {
+		Logger::error("Failed to send data request for binary file info");
+		return false;
+	}
+	if (!readBinFileHeader(caller, connection, knownVersion, result)) {
+		return false;
+	}
+	// AȾu^ШDdA_hLkoebɮפm
+	if (result.ranged && (range.length == 0 || result.range.offset != range.offset)) {
+		Logger::error("Unexpected range in response to " + std::string(caller));
+		metrics.recordError(METRICS_ERROR_PROTOCOL);
+		connection.markBroken();
+		return false;
+	}
+	// SꪺШDLkMήt
+	if (result.delta && !(knownSha256 && *knownSha256)) {
+		Logger::error("Unexpected delta response to " + std::string(caller));
+		metrics.recordError(METRICS_ERROR_PROTOCOL);
+		connection.markBroken();
+		return false;
+	}
+	return true;
+}
+
+bool Client::readBinFileHeader(const char* caller, Connection& connection, const char* knownVersion, BinFileHeader& result)
+{
+	//  JSON header
+	std::string header;
+	if (!connection.receiveHeader(header)) {
+		result.message = "Failed to receive response header";
+		return false;
+	}
+
+	auto parseStart = std::chrono::steady_clock::now();
+	ResponseStatus status = ParseBinFileHeader(header, knownVersion && *knownVersion, result);
+	if (status == RESPONSE_SERVER_ERROR) {
+		Logger::error(result.message);
+		metrics.recordError(METRICS_ERROR_SERVER);
+		return false;
+	}
+	if (status == RESPONSE_MALFORMED) {
+		// Lko򤺮eסAsuAi
+		Logger::error(result.message + " in " + std::string(caller) + "\nHeader content: " + header);
+		metrics.recordError(METRICS_ERROR_PROTOCOL);
+		connection.markBroken();
+		return false;
+	}
+	metrics.recordPhase(METRICS_PHASE_PARSE, std::chrono::steady_clock::now() - parseStart);
+
+	// Yeѳsu䱵Y
+	BodyEncoding encoding = result.notModified ? BODY_ENCODING_IDENTITY : result.encoding;
+	if (encoding != BODY_ENCODING_IDENTITY) {
+		Logger::debug("File content compressed from " + std::to_string(result.bodySize()) + " to " +
+			std::to_string(result.encodedSize) + " bytes");
+	}
+	if (!connection.beginBody(encoding, result.encodedSize, result.bodySize())) {
+		result.message = "Failed to receive compressed content";
+		return false;
+	}
+	return true;
+}
+
+bool Client::requestCachedBinFile(
+	const char* caller,
+	Connection& connection,
+	const BinCacheKey& key,
+	BinFileHeader& header,
+	BinCacheEntry& entry,
+	char*& cachedData,
+	ByteRange range
+) {
+	cachedData = nullptr;
+	bool cached = cache && cache->lookup(key, entry);
+	if (!requestBinFile(caller, connection, key.askId.c_str(), key.productSeries.c_str(), key.applicableProjects.c_str(),
+		key.customizeId.c_str(), cached ? entry.version.c_str() : nullptr, header, range,
+		cached ? entry.sha256.c_str() : nullptr)) {
+		return false;
+	}
+	if (header.delta) {
+		if (applyDelta(caller, connection, key, header, entry) && (cachedData = MapFile(entry.objectPath, entry.fileSize))) {
+			metrics.recordDelta();
+			return true;
+		}
+		if (!connection.isHealthy()) {
+			return false;
+		}
+		// tLkM (Ҧp֨ɮפwQRεGꤣ)AאּU
+		metrics.recordCacheMiss();
+		return requestBinFile(caller, connection, key.askId.c_str(), key.productSeries.c_str(), key.applicableProjects.c_str(),
+			key.customizeId.c_str(), nullptr, header, range);
+	}
+	if (!header.notModified) {
+		if (cache) {
+			metrics.recordCacheMiss();
+		}
+		return true;
+	}
+
+	// Mg֨ɮסAƻse
+	cachedData = MapFile(entry.objectPath, entry.fileSize);
+	if (cachedData) {
+		metrics.recordCacheHit();
+		return true;
+	}
+
+	// ֨ɮצbd߫QRAאּU
+	metrics.recordCacheMiss();
+	return requestBinFile(caller, connection, key.askId.c_str(), key.productSeries.c_str(), key.applicableProjects.c_str(),
+		key.customizeId.c_str(), nullptr, header, range);
+}
+
+bool Client::applyDelta(const char* caller, Connection& connection, const BinCacheKey& key, const BinFileHeader& header,
+	BinCacheEntry& entry)
+{
+	Logger::info("Receiving " + std::to_string(header.patchSize) + " byte delta of " + header.fileName +
+		" from version " + header.deltaBase);
+	auto bodyStart = std::chrono::steady_clock::now();
+
+	// ׸ɸƳq`uܧ󪺤jpA㱵AM
+	std::vector<char> patch;
+	try {
+		patch.resize(header.patchSize);
+	}
+	catch (const std::exception& e) {
+		Logger::error("Unexpected error in " + std::string(caller) + ": " + std::string(e.what()));
+		connection.discardBody(header.patchSize);
+		return false;
+	}
+	if (connection.receiveFull(patch.data(), patch.size()) < patch.size()) {
+		Logger::error("Failed to receive delta of " + header.fileName + ". " + connection.lastError());
+		return false;
+	}
+
+	if (header.deltaBase != entry.version) {
+		Logger::error("Delta of " + header.fileName + " is based on version " + header.deltaBase +
+			" instead of cached version " + entry.version);
+		return false;
+	}
+	char* base = MapFile(entry.objectPath, entry.fileSize);
+	if (!base) {
+		return false;
+	}
+	std::unique_ptr<BinCache::Writer> writer = cache->beginStore(key, header.version, header.fileName);
+	if (!writer) {
+		UnmapFile(base);
+		return false;
+	}
+
+	// se䲣gJ֨ípAPAȾѪۦP~[J֨
+	std::string message;
+	bool applied = ApplyDeltaPatch(patch.data(), patch.size(), base, entry.fileSize, header.fileSize,
+		[&writer](const char* data, size_t size) { return writer->write(data, size); }, message);
+	UnmapFile(base);
+	if (!applied) {
+		Logger::error("Failed to apply delta of " + header.fileName + ": " + message);
+		return false;
+	}
+	if (!writer->commit(header.sha256) || !cache->lookup(key, entry)) {
+		return false;
+	}
+	metrics.recordPhase(METRICS_PHASE_BODY, std::chrono::steady_clock::now() - bodyStart);
+	Logger::info("Updated cached " + header.fileName + " to version " + header.version + " with a delta");
+	return true;
+}
+
+FileInfo* Client::getBinFileInfo(
+	const char* askId,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId
+) {
+	return fetchBinFileInfo("GetBinFileInfo", askId, productSeries, applicableProjects, customizeId, nullptr, nullptr);
+}
+
+FileInfo* Client::getBinFileInfoIfModified(
+	const char* askId,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	const char* knownVersion,
+	bool* notModified
+) {
+	return fetchBinFileInfo("GetBinFileInfoIfModified", askId, productSeries, applicableProjects, customizeId,
+		knownVersion, notModified);
+}
+
+FileInfo* Client::fetchBinFileInfo(
+	const char* caller,
+	const char* askId,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	const char* knownVersion,
+	bool* notModified
+) {
+	if (notModified) {
+		*notModified = false;
+	}
+
+	RequestTimer requestTimer(metrics);
+	PooledConnection connection = acquireConnection(caller);
+	if (!connection) {
+		return nullptr;
+	}
+
+	// IsݴѪɥHӪoeШDA_hϥΧ֨
+	BinCacheKey key{ askId, productSeries, applicableProjects, customizeId };
+	BinFileHeader header;
+	BinCacheEntry entry;
+	char* cachedData = nullptr;
+	ByteRange range = firstRange();
+	bool requested = (knownVersion && *knownVersion)
+		? requestBinFile(caller, *connection, askId, productSeries, applicableProjects, customizeId, knownVersion, header, range)
+		: requestCachedBinFile(caller, *connection, key, header, entry, cachedData, range);
+	if (!requested) {
+		return nullptr;
+	}
+
+	if (cachedData) {
+		//  FreeFileInfo ѰMg
+		FileInfo* fileInfo = new FileInfo();
+		fileInfo->data = cachedData;
+		fileInfo->size = entry.fileSize;
+		copyString(fileInfo->fileName, entry.fileName);
+		copyString(fileInfo->version, entry.version);
+		Logger::info("Served file from cache: " + entry.fileName);
+		return fileInfo;
+	}
+
+	if (header.notModified) {
+		Logger::info("File not modified since version " + std::string(knownVersion));
+		if (notModified) {
+			*notModified = true;
+		}
+		return nullptr;
+	}
+
+	ContentVerifier verifier(header);
+	FileInfo* fileInfo = receiveBinFileInfo(caller, connection, header, verifier, &key);
+	if (fileInfo && header.bodySize() < header.fileSize) {
+		// lHhsuPɤUP@O
+		auto rangesStart = std::chrono::steady_clock::now();
+		bool success = fetchRanges(caller, connection, key, header, header.bodySize(), RangeTarget{ fileInfo->data, nullptr },
+			verifier);
+		if (success) {
+			metrics.recordPhase(METRICS_PHASE_BODY, std::chrono::steady_clock::now() - rangesStart);
+			if (verifier.position() < header.fileSize) {
+				verifier.update(fileInfo->data + verifier.position(), (size_t)(header.fileSize - verifier.position()));
+			}
+			success = verifyContent(caller, verifier, header.fileName);
+		}
+		if (!success) {
+			delete[] fileInfo->data;
+			delete fileInfo;
+			return nullptr;
+		}
+	}
+	if (fileInfo && cache && !header.version.empty()) {
+		cache->store(key, header.version, header.fileName, fileInfo->data, header.fileSize);
+	}
+	return fileInfo;
+}
+
+FileInfo* Client::receiveBinFileInfo(const char* caller, PooledConnection& connection, const BinFileHeader& header,
+	ContentVerifier& verifier, const BinCacheKey* resumeKey)
+{
+	char* data;
+	try {
+		data = new char[header.fileSize];
+	}
+	catch (const std::exception& e) {
+		Logger::error("Unexpected error in " + std::string(caller) + ": " + std::string(e.what()));
+		connection->discardBody(header.bodySize());
+		return nullptr;
+	}
+
+	// ɮפeAgJ dataFd^u}Y
+	Logger::info("Starting file content reception");
+	auto bodyStart = std::chrono::steady_clock::now();
+	size_t bodySize = header.bodySize();
+	BodyCursor cursor{ 0, bodySize };
+	size_t totalReceived = receiveBody(caller, connection, resumeKey, header, cursor, data, bodySize,
+		verifier.isEnabled() ? &verifier : nullptr);
+	if (totalReceived < bodySize) {
+		Logger::error("Failed to receive file content. Total received so far: " + std::to_string(totalReceived) +
+			" of " + std::to_string(bodySize));
+		delete[] data;
+		return nullptr;
+	}
+	metrics.recordPhase(METRICS_PHASE_BODY, std::chrono::steady_clock::now() - bodyStart);
+	// d^ѩIsݱlA
+	if (bodySize == header.fileSize && !verifyContent(caller, verifier, header.fileName)) {
+		delete[] data;
+		return nullptr;
+	}
+
+	// إ FileInfo c
+	FileInfo* fileInfo = new FileInfo();
+	fileInfo->data = data;
+	fileInfo->size = header.fileSize;
+	copyString(fileInfo->fileName, header.fileName);
+	copyString(fileInfo->version, header.version);
+	Logger::info("Successfully received file: " + header.fileName);
+	return fileInfo;
+}
+
+bool Client::verifyContent(const char* caller, ContentVerifier& verifier, const std::string& fileName)
+{
+	std::string message;
+	if (verifier.verify(message)) {
+		return true;
+	}
+	Logger::error("Content of " + fileName + " is corrupted in " + std::string(caller) + ": " + message);
+	metrics.recordError(METRICS_ERROR_CHECKSUM);
+	return false;
+}
+
+size_t Client::receiveBody(
+	const char* caller,
+	PooledConnection& connection,
+	const BinCacheKey* resumeKey,
+	const BinFileHeader& header,
+	BodyCursor& cursor,
+	char* destination,
+	size_t length,
+	ContentVerifier* verifier
+) {
+	size_t received = 0;
+	int attempts = 0;
+	while (true) {
+		if (connection && connection->isHealthy()) {
+			size_t bytesReceived = 0;
+			if (verifier) {
+				// _ɤw쪺P˭pJAǱq cursor.position W
+				while (received + bytesReceived < length) {
+					char* piece = destination + received + bytesReceived;
+					size_t pieceSize = std::min((size_t)VERIFY_CHUNK_SIZE, length - received - bytesReceived);
+					size_t pieceReceived = connection->receiveFull(piece, pieceSize);
+					verifier->update(piece, pieceReceived);
+					bytesReceived += pieceReceived;
+					if (pieceReceived < pieceSize) {
+						break;
+					}
+				}
+			}
+			else {
+				bytesReceived = connection->receiveFull(destination + received, length - received);
+			}
+			received += bytesReceived;
+			cursor.position += bytesReceived;
+			if (received == length) {
+				return received;
+			}
+			// iiɭsp⭫ssu
+			if (bytesReceived > 0) {
+				attempts = 0;
+			}
+			Logger::error("Failed to receive file content at offset " + std::to_string(cursor.position) +
+				" of " + header.fileName + ". " + connection->lastError());
+		}
+
+		// usu_~ǡF^~μgɥѮɩ
+		if (!resumeKey || (connection && !connection->isInterrupted()) ||
+			!requestBody(caller, connection, *resumeKey, header, cursor, attempts)) {
+			return received;
+		}
+	}
+}
+
+bool Client::requestBody(
+	const char* caller,
+	PooledConnection& connection,
+	const BinCacheKey& key,
+	const BinFileHeader& header,
+	const BodyCursor& cursor,
+	int& attempts
+) {
+	ByteRange range{ cursor.position, cursor.end - cursor.position };
+	while (true) {
+		if (connection && connection->isHealthy()) {
+			BinFileHeader part;
+			if (requestBinFile(caller, *connection, key.askId.c_str(), key.productSeries.c_str(),
+				key.applicableProjects.c_str(), key.customizeId.c_str(), nullptr, part, range)) {
+				// UqӦۦP@ɮ
+				if (part.ranged && part.range.length == range.length &&
+					part.fileSize == header.fileSize && part.version == header.version) {
+					return true;
+				}
+				Logger::error("Range response does not match " + header.fileName + " in " + std::string(caller));
+				metrics.recordError(METRICS_ERROR_PROTOCOL);
+				connection->markBroken();
+				return false;
+			}
+			if (!connection->isInterrupted()) {
+				return false;
+			}
+		}
+
+		// SɵLkT{sШDOP@ɮ
+		if (attempts >= options.resumeAttempts || header.version.empty()) {
+			return false;
+		}
+		attempts++;
+
+		// _sukٮɥѳsuAݮɶvW[
+		connection = PooledConnection();
+		std::this_thread::sleep_for(std::chrono::milliseconds(RESUME_DELAY_MS * attempts));
+		Logger::info("Resuming " + header.fileName + " at offset " + std::to_string(cursor.position) +
+			" (attempt " + std::to_string(attempts) + " of " + std::to_string(options.resumeAttempts) + ")");
+		metrics.recordResume();
+		connection = acquireConnection(caller);
+	}
+}
+
+bool Client::getBinFileStream(
+	const char* askId,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	BinFileChunkCallback callback,
+	void* userData,
+	FileInfo* fileInfo
+) {
+	RequestTimer requestTimer(metrics);
+	PooledConnection connection = acquireConnection("GetBinFileStream");
+	if (!connection) {
+		return false;
+	}
+	return streamBinFile("GetBinFileStream", connection, askId, productSeries, applicableProjects, customizeId,
+		callback, userData, fileInfo);
+}
+
+// qUBǩΪgJɮ׮ɡAɮפweɮŪ^gJ֨ípˬdX
+static bool readBackFile(const std::string& path, size_t offset, size_t end,
+	std::unique_ptr<BinCache::Writer>& cacheWriter, ContentVerifier* verifier)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file.seekg((std::streamoff)offset)) {
+		return false;
+	}
+	std::unique_ptr<char[]> chunk(new char[STREAM_CHUNK_SIZE]);
+	while (offset < end) {
+		size_t chunkSize = std::min((size_t)STREAM_CHUNK_SIZE, end - offset);
+		if (!file.read(chunk.get(), chunkSize)) {
+			return false;
+		}
+		// ֨gJѥuO[J֨
+		if (cacheWriter && !cacheWriter->write(chunk.get(), chunkSize)) {
+			cacheWriter.reset();
+		}
+		if (verifier) {
+			verifier->update(chunk.get(), chunkSize);
+		}
+		offset += chunkSize;
+	}
+	return true;
+}
+
+bool Client::streamBinFile(
+	const char* caller,
+	PooledConnection& connection,
+	const char* askId,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	BinFileChunkCallback callback,
+	void* userData,
+	FileInfo* fileInfo,
+	PartialFile* partial
+) {
+	if (!callback) {
+		Logger::error(std::string(caller) + " called without callback");
+		return false;
+	}
+
+	BinCacheKey key{ askId, productSeries, applicableProjects, customizeId };
+	BinFileHeader header;
+	BinCacheEntry entry;
+	char* cachedData = nullptr;
+	// gJɮ׮ɤ~qA^IݭņǦ줺e
+	ByteRange range = partial ? firstRange() : ByteRange{ 0, 0 };
+	if (partial && partial->offset > 0) {
+		// qWOdm~AqɦP˥u@q
+		uint64_t rest = partial->fileSize - partial->offset;
+		range = ByteRange{ partial->offset, range.length > 0 ? std::min(range.length, rest) : rest };
+	}
+	if (!requestCachedBinFile(caller, *connection, key, header, entry, cachedData, range)) {
+		return false;
+	}
+
+	if (cachedData) {
+		if (fileInfo) {
+			fileInfo->data = nullptr;
+			fileInfo->size = entry.fileSize;
+			copyString(fileInfo->fileName, entry.fileName);
+			copyString(fileInfo->version, entry.version);
+		}
+
+		// HPUۦP϶jp浹^I
+		bool success = true;
+		for (size_t offset = 0; offset < entry.fileSize; offset += STREAM_CHUNK_SIZE) {
+			size_t chunkSize = std::min((size_t)STREAM_CHUNK_SIZE, entry.fileSize - offset);
+			if (!callback(cachedData + offset, chunkSize, offset, entry.fileSize, userData)) {
+				Logger::error("File streaming aborted by callback at offset " + std::to_string(offset));
+				success = false;
+				break;
+			}
+		}
+		UnmapFile(cachedData);
+		if (success) {
+			Logger::info("Streamed file from cache: " + entry.fileName);
+		}
+		return success;
+	}
+
+	size_t fileSize = header.fileSize;
+	const std::string& fileName = header.fileName;
+	// Ǫ^qOdm}lAAȾ䴩dШDɦ^㪺ɮ
+	uint64_t bodyStart = header.ranged ? header.range.offset : 0;
+	if (partial) {
+		if (bodyStart > 0 && (header.version != partial->version || header.fileSize != partial->fileSize)) {
+			Logger::info("Partial file of " + fileName + " is from another version, downloading again");
+			connection->markBroken();
+			partial->stale = true;
+			return false;
+		}
+		partial->version = header.version;
+		partial->fileSize = header.fileSize;
+		partial->completed = bodyStart;
+	}
+	if (fileInfo) {
+		fileInfo->data = nullptr;
+		fileInfo->size = fileSize;
+		copyString(fileInfo->fileName, fileName);
+		copyString(fileInfo->version, header.version);
+	}
+
+	// 䱵gJ֨A㱵ҫ~[J
+	std::unique_ptr<BinCache::Writer> cacheWriter;
+	if (cache && !header.version.empty()) {
+		cacheWriter = cache->beginStore(key, header.version, fileName);
+	}
+	ContentVerifier verifier(header);
+	// Ū^ɮץѮɵLkҡAOdȦsɡFwX֦Uq CRC32C ɥu֨Ū^
+	auto readBack = [&](uint64_t offset, uint64_t end) {
+		ContentVerifier* pending = (verifier.isEnabled() && verifier.position() == offset) ? &verifier : nullptr;
+		if (offset >= end || (!cacheWriter && !pending)) {
+			return true;
+		}
+		if (readBackFile(partial->path, (size_t)offset, (size_t)end, cacheWriter, pending)) {
+			return true;
+		}
+		Logger::error("Failed to read back destination file: " + partial->path);
+		partial->completed = 0;
+		return false;
+	};
+	if (bodyStart > 0 && !readBack(0, bodyStart)) {
+		connection->markBroken();
+		return false;
+	}
+
+	// qUɳsuu}Y
+	BodyCursor cursor{ bodyStart, bodyStart + header.bodySize() };
+	if (partial && partial->fd >= 0 && !cacheWriter && header.encoding == BODY_ENCODING_IDENTITY &&
+		connection->canReceiveToFile()) {
+		// ݼgJ֨BeYɥѶǿhq socket gJɮסAgL^IF_᪺lѤU
+		Logger::info("Starting file content transfer to file");
+		auto receiveStart = std::chrono::steady_clock::now();
+		uint64_t receivedStart = cursor.position;
+		cursor.position += connection->receiveToFile(partial->fd, cursor.position, (size_t)(cursor.end - cursor.position));
+		partial->completed = cursor.position;
+		metrics.recordPhase(METRICS_PHASE_BODY, std::chrono::steady_clock::now() - receiveStart);
+		// eSgLϥΪ̪ŶAɮŪ^pˬdX
+		if (!readBack(receivedStart, cursor.position)) {
+			connection->markBroken();
+			return false;
+		}
+	}
+	if (cursor.position < cursor.end) {
+		// HTwjp϶å浹IsݡAOζqPɮפjpL
+		std::unique_ptr<char[]> chunk(new char[STREAM_CHUNK_SIZE]);
+		// u֭pɶA]t^IBz (Ҧpg) ɶ
+		std::chrono::steady_clock::duration bodyTime(0);
+
+		Logger::info("Starting file content streaming");
+		while (cursor.position < cursor.end) {
+			uint64_t offset = cursor.position;
+			size_t chunkSize = (size_t)std::min((uint64_t)STREAM_CHUNK_SIZE, cursor.end - offset);
+			auto receiveStart = std::chrono::steady_clock::now();
+			size_t bytesReceived = receiveBody(caller, connection, &key, header, cursor, chunk.get(), chunkSize,
+				verifier.isEnabled() ? &verifier : nullptr);
+			bodyTime += std::chrono::steady_clock::now() - receiveStart;
+			if (bytesReceived < chunkSize) {
+				Logger::error("Failed to receive file content. Total received so far: " + std::to_string(offset + bytesReceived) +
+					" of " + std::to_string(fileSize));
+				return false;
+			}
+
+			if (cacheWriter && !cacheWriter->write(chunk.get(), chunkSize)) {
+				cacheWriter.reset();
+			}
+
+			if (!callback(chunk.get(), chunkSize, (size_t)offset, fileSize, userData)) {
+				Logger::error("File streaming aborted by callback at offset " + std::to_string(offset));
+				connection->discardBody((size_t)(cursor.end - cursor.position));
+				return false;
+			}
+			if (partial) {
+				partial->completed = cursor.position;
+			}
+		}
+		metrics.recordPhase(METRICS_PHASE_BODY, bodyTime);
+	}
+
+	if (cursor.end < fileSize) {
+		// lHhsuPɼgJɮסA֨ɮŪ^򪺤e
+		auto rangesStart = std::chrono::steady_clock::now();
+		if (!fetchRanges(caller, connection, key, header, cursor.end, RangeTarget{ nullptr, &partial->path }, verifier)) {
+			return false;
+		}
+		metrics.recordPhase(METRICS_PHASE_BODY, std::chrono::steady_clock::now() - rangesStart);
+		partial->completed = fileSize;
+		if (!readBack(cursor.end, fileSize)) {
+			return false;
+		}
+	}
+
+	if (!verifyContent(caller, verifier, fileName)) {
+		// e~ɤOdȦsɨ
+		if (partial) {
+			partial->completed = 0;
+		}
+		return false;
+	}
+	if (cacheWriter) {
+		cacheWriter->commit();
+	}
+	Logger::info("Successfully streamed file: " + fileName);
+	return true;
+}
+
+ByteRange Client::firstRange() const
+{
+	// u@suiήɤqSįq
+	if (std::min(options.rangeConnections, options.poolSize) <= 1) {
+		return ByteRange{ 0, 0 };
+	}
+	return ByteRange{ 0, RANGE_FIRST_SIZE };
+}
+
+bool Client::fetchRanges(
+	const char* caller,
+	PooledConnection& connection,
+	const BinCacheKey& key,
+	const BinFileHeader& header,
+	uint64_t start,
+	const RangeTarget& target,
+	ContentVerifier& verifier
+) {
+	uint64_t remaining = header.fileSize - start;
+	uint64_t connections = (uint64_t)std::min(options.rangeConnections, options.poolSize);
+	uint64_t rangeSize = std::max((uint64_t)RANGE_MIN_SIZE, (remaining + connections - 1) / connections);
+	size_t rangeCount = (size_t)((remaining + rangeSize - 1) / rangeSize);
+	size_t workerCount = (size_t)std::min((uint64_t)rangeCount, connections);
+	Logger::info("Downloading remaining " + std::to_string(remaining) + " bytes of " + header.fileName +
+		" in " + std::to_string(rangeCount) + " ranges");
+
+	// Uq CRC32C OpA̧ǱW
+	bool combine = verifier.isEnabled() && verifier.isCombinable() && verifier.position() == start;
+	std::vector<ContentVerifier> parts(combine ? rangeCount : 0, ContentVerifier::crcOnly());
+
+	// Usu̧ǻU@qAɤsuθCsu|Lq
+	std::atomic<size_t> nextRange(0);
+	std::atomic<bool> failed(false);
+	auto work = [&](PooledConnection& worker) {
+		while (!failed) {
+			size_t index = nextRange++;
+			if (index >= rangeCount) {
+				break;
+			}
+			ByteRange range;
+			range.offset = start + (uint64_t)index * rangeSize;
+			range.length = std::min(rangeSize, (uint64_t)header.fileSize - range.offset);
+			if (!fetchRange(caller, worker, key, header, range, target, combine ? &parts[index] : nullptr)) {
+				failed = true;
+			}
+		}
+	};
+
+	// LsuuɥζmAPi椤ШD@
+	std::vector<std::thread> workers;
+	for (size_t i = 1; i < workerCount; i++) {
+		workers.emplace_back([this, &work] {
+			std::shared_ptr<ConnectionPool> currentPool;
+			{
+				std::lock_guard<std::mutex> lock(stateMutex);
+				currentPool = pool;
+			}
+			PooledConnection extra = currentPool ? currentPool->acquire(true) : PooledConnection();
+			if (extra) {
+				work(extra);
+			}
+		});
+	}
+	work(connection);
+	for (auto& worker : workers) {
+		worker.join();
+	}
+	if (failed) {
+		return false;
+	}
+	for (const ContentVerifier& part : parts) {
+		verifier.combine(part);
+	}
+	return true;
+}
+
+bool Client::fetchRange(
+	const char* caller,
+	PooledConnection& connection,
+	const BinCacheKey& key,
+	const BinFileHeader& header,
+	ByteRange range,
+	const RangeTarget& target,
+	ContentVerifier* verifier
+) {
+	// e@q_suiwLkϥΡAP_ۦPassu
+	BodyCursor cursor{ range.offset, range.offset + range.length };
+	int attempts = 0;
+	if (!requestBody(caller, connection, key, header, cursor, attempts)) {
+		return false;
+	}
+
+	size_t length = (size_t)range.length;
+	if (target.memory) {
+		return receiveBody(caller, connection, &key, header, cursor, target.memory + range.offset, length, verifier) == length;
+	}
+
+	std::fstream file(*target.path, std::ios::binary | std::ios::in | std::ios::out);
+	if (!file) {
+		Logger::error("Failed to open destination file: " + *target.path);
+		connection->discardBody(length);
+		return false;
+	}
+	file.seekp((std::streamoff)range.offset);
+	std::unique_ptr<char[]> chunk(new char[STREAM_CHUNK_SIZE]);
+	while (cursor.position < cursor.end) {
+		size_t chunkSize = (size_t)std::min((uint64_t)STREAM_CHUNK_SIZE, cursor.end - cursor.position);
+		if (receiveBody(caller, connection, &key, header, cursor, chunk.get(), chunkSize, verifier) < chunkSize) {
+			return false;
+		}
+		if (!file.write(chunk.get(), chunkSize)) {
+			Logger::error("Failed to write destination file: " + *target.path);
+			connection->discardBody((size_t)(cursor.end - cursor.position));
+			return false;
+		}
+	}
+	return true;
+}
+
+// GetBinFileToPath gɦ^I
+static bool writeChunkToFile(const char* data, size_t size, size_t offset, size_t /*fileSize*/, void* userData)
+{
+	std::ofstream* file = static_cast<std::ofstream*>(userData);
+	// ǡBgJɮ׫ΪAȾ䴩dШDɡAm@wW@gJ
+	if ((size_t)file->tellp() != offset) {
+		file->seekp((std::streamoff)offset);
+	}
+	file->write(data, size);
+	return file->good();
+}
+
+// ŪȦsɪǰOAOݩP@ӽШDɵS
+static bool readPartialIndex(const std::string& path, const BinCacheKey& key, std::string& version,
+	uint64_t& fileSize, uint64_t& completed)
+{
+	std::ifstream file(path);
+	if (!file) {
+		return false;
+	}
+
+	try {
+		json index = json::parse(file);
+		if (index["askId"] != key.askId || index["productSeries"] != key.productSeries ||
+			index["applicableProjects"] != key.applicableProjects || index["customizeId"] != key.customizeId) {
+			return false;
+		}
+		version = index["version"];
+		fileSize = index["fileSize"];
+		completed = index["completed"];
+	}
+	catch (const json::exception& e) {
+		Logger::error("Invalid partial file index " + path + ": " + std::string(e.what()));
+		return false;
+	}
+	return !version.empty() && completed > 0 && completed < fileSize;
+}
+
+static bool writePartialIndex(const std::string& path, const BinCacheKey& key, const std::string& version,
+	uint64_t fileSize, uint64_t completed)
+{
+	json index = {
+		{"askId", key.askId},
+		{"productSeries", key.productSeries},
+		{"applicableProjects", key.applicableProjects},
+		{"customizeId", key.customizeId},
+		{"version", version},
+		{"fileSize", fileSize},
+		{"completed", completed},
+	};
+	std::string text = index.dump();
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file.write(text.data(), text.size());
+	return file.good();
+}
+
+bool Client::getBinFileToPath(
+	const char* askId,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	const char* destinationPath,
+	FileInfo* fileInfo
+) {
+	if (!destinationPath || !*destinationPath) {
+		Logger::error("GetBinFileToPath called without destination path");
+		return false;
+	}
+
+	RequestTimer requestTimer(metrics);
+	PooledConnection connection = acquireConnection("GetBinFileToPath");
+	if (!connection) {
+		return false;
+	}
+
+	// gJȦsɡA㱵~WAקKdU㪺MF
+	// ѮɫOdw}YPOAUIsuШDl
+	BinCacheKey key{ askId, productSeries, applicableProjects, customizeId };
+	PartialFile partial;
+	partial.path = std::string(destinationPath) + ".part";
+	std::string indexPath = partial.path + PARTIAL_INDEX_EXTENSION;
+	std::error_code error;
+	if (options.resumeAttempts > 0 &&
+		readPartialIndex(indexPath, key, partial.version, partial.fileSize, partial.offset)) {
+		uint64_t existing = std::filesystem::file_size(partial.path, error);
+		partial.offset = error ? 0 : std::min(partial.offset, existing);
+	}
+	// UȦsɪeiܡAɦA̵GgJO
+	std::filesystem::remove(indexPath, error);
+
+	bool success = false;
+	bool writeFailed = false;
+	while (true) {
+		partial.completed = partial.offset;
+		std::ios::openmode mode = std::ios::binary | std::ios::out | (partial.offset > 0 ? std::ios::in : std::ios::trunc);
+		std::ofstream file(partial.path, mode);
+		if (!file) {
+			Logger::error("Failed to open destination file: " + partial.path);
+			return false;
+		}
+		if (partial.offset > 0) {
+			Logger::info("Resuming " + partial.path + " from offset " + std::to_string(partial.offset));
+		}
+
+		// ǿh䴩ɥt}ɮ״yzAegJɮ
+		partial.fd = -1;
+#ifndef _WIN32
+		if (connection->canReceiveToFile()) {
+			partial.fd = ::open(partial.path.c_str(), O_WRONLY | O_CLOEXEC);
+		}
+#endif
+
+		success = streamBinFile("GetBinFileToPath", connection, askId, productSeries, applicableProjects, customizeId,
+			writeChunkToFile, &file, fileInfo, &partial);
+#ifndef _WIN32
+		if (partial.fd >= 0) {
+			::close(partial.fd);
+		}
+#endif
+		file.close();
+		writeFailed = file.fail();
+		if (success || !partial.stale) {
+			break;
+		}
+
+		// AȾWɮפwsA˱OdeqYU
+		partial.offset = 0;
+		partial.completed = 0;
+		partial.stale = false;
+		connection = PooledConnection();
+		connection = acquireConnection("GetBinFileToPath");
+		if (!connection) {
+			break;
+		}
+	}
+
+	if (!success || writeFailed) {
+		if (!writeFailed && options.resumeAttempts > 0 && partial.completed > 0 && !partial.version.empty() &&
+			partial.completed < partial.fileSize &&
+			writePartialIndex(indexPath, key, partial.version, partial.fileSize, partial.completed)) {
+			Logger::info("Kept " + std::to_string(partial.completed) + " bytes of " + partial.path + " for resuming");
+			return false;
+		}
+		std::filesystem::remove(partial.path, error);
+		std::filesystem::remove(indexPath, error);
+		return false;
+	}
+
+	std::filesystem::rename(partial.path, destinationPath, error);
+	if (error) {
+		Logger::error("Failed to rename " + partial.path + ": " + error.message());
+		std::filesystem::remove(partial.path, error);
+		return false;
+	}
+
+	Logger::info("Saved file to: " + std::string(destinationPath));
+	return true;
+}
+
+//  MainApp / DefaultParameters ^öJc
+// ^SɮפeAY㱵᪺~vTsu
+template <typename Info>
+static bool receiveInfo(
+	const char* caller,
+	Connection& connection,
+	Metrics& metrics,
+	ResponseStatus (*parse)(const std::string&, Info&, std::string&),
+	Info& info,
+	std::string& message
+) {
+	//  JSON header
+	std::string header;
+	if (!connection.receiveHeader(header)) {
+		message = "Failed to receive response header";
+		return false;
+	}
+
+	auto parseStart = std::chrono::steady_clock::now();
+	ResponseStatus status = parse(header, info, message);
+	if (status == RESPONSE_SERVER_ERROR) {
+		Logger::error(message);
+		metrics.recordError(METRICS_ERROR_SERVER);
+		return false;
+	}
+	if (status == RESPONSE_MALFORMED) {
+		Logger::error(message + " in " + std::string(caller) + "\nHeader content: " + header);
+		metrics.recordError(METRICS_ERROR_PROTOCOL);
+		return false;
+	}
+	metrics.recordPhase(METRICS_PHASE_PARSE, std::chrono::steady_clock::now() - parseStart);
+	return true;
+}
+
+MainAppInfo* Client::getMainAppInfo(const char* productSeries, const char* applicableProjects, const char* customizeId)
+{
+	RequestTimer requestTimer(metrics);
+	std::string cacheKey = infoCacheKey(productSeries, applicableProjects, customizeId);
+	MainAppInfo info = {};
+	uint64_t generation;
+	if (mainAppCache.get(cacheKey, info, generation)) {
+		return new MainAppInfo(info);
+	}
+
+	PooledConnection connection = acquireConnection("GetMainAppInfo");
+	if (!connection) {
+		return nullptr;
+	}
+
+	Logger::info("Getting main app info...");
+
+	// oeШDT
+	int sendResult = connection->sendRequest("MainApp", productSeries, applicableProjects, customizeId, false);
+	if (sendResult <= 0) {
+		Logger::error("Failed to send data request for main app info");
+		return nullptr;
+	}
+
+	std::string message;
+	if (!receiveInfo("GetMainAppInfo", *connection, metrics, ParseMainAppInfo, info, message)) {
+		return nullptr;
+	}
+
+	mainAppCache.put(cacheKey, info, generation);
+	Logger::info("Successfully retrieved main app info");
+	return new MainAppInfo(info);
+}
+
+DefaultParametersInfo* Client::getDefaultParametersInfo(const char* productSeries, const char* applicableProjects, const char* customizeId)
+{
+	RequestTimer requestTimer(metrics);
+	std::string cacheKey = infoCacheKey(productSeries, applicableProjects, customizeId);
+	DefaultParametersInfo info = {};
+	uint64_t generation;
+	if (defaultParametersCache.get(cacheKey, info, generation)) {
+		return new DefaultParametersInfo(info);
+	}
+
+	PooledConnection connection = acquireConnection("GetDefaultParametersInfo");
+	if (!connection) {
+		return nullptr;
+	}
+
+	Logger::info("Getting default parameters info...");
+
+	// oeШDT
+	int sendResult = connection->sendRequest("DefaultParameters", productSeries, applicableProjects, customizeId, false);
+	if (sendResult <= 0) {
+		Logger::error("Failed to send data request for default parameters");
+		return nullptr;
+	}
+
+	std::string message;
+	if (!receiveInfo("GetDefaultParametersInfo", *connection, metrics, ParseDefaultParametersInfo, info, message)) {
+		return nullptr;
+	}
+
+	defaultParametersCache.put(cacheKey, info, generation);
+	Logger::info("Successfully retrieved default parameters info");
+	return new DefaultParametersInfo(info);
+}
+
+bool Client::getBatch(const BatchQuery* queries, int count, BatchResult* results)
+{
+	if (!queries || !results || count <= 0) {
+		Logger::error("GetBatch called without queries");
+		return false;
+	}
+
+	RequestTimer requestTimer(metrics);
+
+	// T֨RؤeXF.bin ɮתa֨
+	std::vector<AskRequest> requests;
+	std::vector<int> pending;
+	std::vector<BinCacheEntry> entries(count);
+	// T֨@NAGb֨QM~FɤOs
+	std::vector<uint64_t> generations(count, 0);
+	for (int i = 0; i < count; i++) {
+		const BatchQuery& query = queries[i];
+		BatchResult& result = results[i];
+		result = BatchResult();
+		result.type = query.type;
+
+		std::string cacheKey = infoCacheKey(query.productSeries, query.applicableProjects, query.customizeId);
+		AskRequest request = { nullptr, query.productSeries, query.applicableProjects, query.customizeId, false, nullptr };
+		switch (query.type) {
+		case BATCH_QUERY_MAIN_APP: {
+			MainAppInfo info = {};
+			if (mainAppCache.get(cacheKey, info, generations[i])) {
+				result.mainAppInfo = new MainAppInfo(info);
+				result.success = true;
+				continue;
+			}
+			request.askId = "MainApp";
+			break;
+		}
+		case BATCH_QUERY_DEFAULT_PARAMETERS: {
+			DefaultParametersInfo info = {};
+			if (defaultParametersCache.get(cacheKey, info, generations[i])) {
+				result.defaultParametersInfo = new DefaultParametersInfo(info);
+				result.success = true;
+				continue;
+			}
+			request.askId = "DefaultParameters";
+			break;
+		}
+		case BATCH_QUERY_BIN_FILE: {
+			BinCacheKey key{ query.askId, query.productSeries, query.applicableProjects, query.customizeId };
+			request.askId = query.askId;
+			request.isGetFile = true;
+			request.acceptCompressed = true;
+			if (cache && cache->lookup(key, entries[i])) {
+				request.knownVersion = entries[i].version.c_str();
+			}
+			break;
+		}
+		default:
+			copyString(result.message, "Unknown query type " + std::to_string((int)query.type));
+			continue;
+		}
+		requests.push_back(request);
+		pending.push_back(i);
+	}
+
+	std::vector<size_t> refetch;
+	if (!pending.empty()) {
+		PooledConnection connection = acquireConnection("GetBatch");
+		if (!connection || connection->sendBatchRequest(requests) <= 0) {
+			for (int index : pending) {
+				copyString(results[index].message, "Failed to send batch request");
+			}
+			return false;
+		}
+
+		// ̧ǱCӶت^FsuhPBlصLk
+		for (size_t n = 0; n < pending.size(); n++) {
+			int index = pending[n];
+			if (!connection->isHealthy()) {
+				copyString(results[index].message, "Connection lost before response");
+				continue;
+			}
+			if (!receiveBatchResult(connection, queries[index], requests[n], entries[index], generations[index], results[index])) {
+				refetch.push_back(n);
+			}
+		}
+	}
+
+	// ֨ɮצbd߫QRءGl^b妸suWAHt@suɵo㪺ШD
+	if (!refetch.empty()) {
+		PooledConnection connection = acquireConnection("GetBatch");
+		for (size_t n : refetch) {
+			int index = pending[n];
+			const AskRequest& request = requests[n];
+			BinFileHeader header;
+			if (!connection || !connection->isHealthy()) {
+				copyString(results[index].message, "Failed to connect for refetch");
+				continue;
+			}
+			if (!requestBinFile("GetBatch", *connection, request.askId, request.productSeries, request.applicableProjects,
+				request.customizeId, nullptr, header)) {
+				copyString(results[index].message, header.message);
+				continue;
+			}
+			receiveBatchBinFile(connection, request, header, results[index]);
+		}
+	}
+
+	bool success = true;
+	for (int i = 0; i < count; i++) {
+		success = success && results[i].success;
+	}
+	Logger::info("Batch of " + std::to_string(count) + " queries completed" + (success ? "" : " with errors"));
+	return success;
+}
+
+bool Client::receiveBatchResult(
+	PooledConnection& connection,
+	const BatchQuery& query,
+	const AskRequest& request,
+	const BinCacheEntry& entry,
+	uint64_t generation,
+	BatchResult& result
+) {
+	std::string message;
+	std::string cacheKey = infoCacheKey(query.productSeries, query.applicableProjects, query.customizeId);
+
+	if (query.type == BATCH_QUERY_MAIN_APP) {
+		MainAppInfo info = {};
+		result.success = receiveInfo("GetBatch", *connection, metrics, ParseMainAppInfo, info, message);
+		if (result.success) {
+			mainAppCache.put(cacheKey, info, generation);
+			result.mainAppInfo = new MainAppInfo(info);
+		}
+	}
+	else if (query.type == BATCH_QUERY_DEFAULT_PARAMETERS) {
+		DefaultParametersInfo info = {};
+		result.success = receiveInfo("GetBatch", *connection, metrics, ParseDefaultParametersInfo, info, message);
+		if (result.success) {
+			defaultParametersCache.put(cacheKey, info, generation);
+			result.defaultParametersInfo = new DefaultParametersInfo(info);
+		}
+	}
+	else {
+		BinFileHeader header;
+		if (!readBinFileHeader("GetBatch", *connection, request.knownVersion, header)) {
+			copyString(result.message, header.message);
+			return true;
+		}
+
+		if (header.notModified) {
+			char* data = MapFile(entry.objectPath, entry.fileSize);
+			if (data) {
+				metrics.recordCacheHit();
+				result.fileInfo = new FileInfo();
+				result.fileInfo->data = data;
+				result.fileInfo->size = entry.fileSize;
+				copyString(result.fileInfo->fileName, entry.fileName);
+				copyString(result.fileInfo->version, entry.version);
+				result.success = true;
+				return true;
+			}
+
+			// ֨ɮצbd߫QRFnotModified SeAsuMPBAѩIsݦb妸ɵo
+			metrics.recordCacheMiss();
+			return false;
+		}
+		if (cache) {
+			metrics.recordCacheMiss();
+		}
+		receiveBatchBinFile(connection, request, header, result);
+		return true;
+	}
+
+	if (!result.success) {
+		copyString(result.message, message);
+	}
+	return true;
+}
+
+void Client::receiveBatchBinFile(
+	PooledConnection& connection,
+	const AskRequest& request,
+	const BinFileHeader& header,
+	BatchResult& result
+) {
+	ContentVerifier verifier(header);
+	result.fileInfo = receiveBinFileInfo("GetBatch", connection, header, verifier);
+	if (!result.fileInfo) {
+		copyString(result.message, "Failed to receive file content");
+		return;
+	}
+	if (cache && !header.version.empty()) {
+		BinCacheKey key{ request.askId, request.productSeries, request.applicableProjects, request.customizeId };
+		cache->store(key, header.version, header.fileName, result.fileInfo->data, header.fileSize);
+	}
+	result.success = true;
+}
+
+AsyncRequest Client::submitAsync(std::function<AsyncResult()> work, AsyncCompletionCallback callback, void* userData)
+{
+	AsyncExecutor* asyncExecutor;
+	{
+		std::lock_guard<std::mutex> lock(executorMutex);
+		if (!executor) {
+			executor = std::make_unique<AsyncExecutor>((size_t)options.poolSize * options.pipelineDepth);
+		}
+		asyncExecutor = executor.get();
+	}
+
+	AsyncRequest request = new SocketClientAsyncRequest(callback, userData);
+	asyncExecutor->submit([request, work = std::move(work)](bool run) {
+		AsyncResult result = {};
+		if (run) {
+			result = work();
+		}
+		else {
+			Logger::error("Async request cancelled: client destroyed");
+		}
+		request->complete(result);
+	});
+	return request;
+}
+
+void Client::setInfoCacheTtl(int ttlMs)
+{
+	std::chrono::milliseconds ttl(ttlMs > 0 ? ttlMs : 0);
+	mainAppCache.setTtl(ttl);
+	defaultParametersCache.setTtl(ttl);
+}
+
+void Client::invalidateInfoCache()
+{
+	mainAppCache.clear();
+	defaultParametersCache.clear();
+	Logger::info("Info cache invalidated");
+}
+
+bool Client::getMetrics(ClientMetrics* result)
+{
+	if (!result) {
+		return false;
+	}
+	metrics.snapshot(*result);
+	return true;
+}
+
+bool Client::dumpMetrics(const char* path)
+{
+	if (!path || !*path) {
+		Logger::error("DumpClientMetrics called without path");
+		return false;
+	}
+
+	std::string station;
+	{
+		std::lock_guard<std::mutex> lock(stateMutex);
+		station = stationId;
+	}
+	return metrics.writePrometheus(path, station);
+}
@@ -0,0 +1,315 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "SocketClient.h"
+#include "AsyncRequest.h"
+#include "BinCache.h"
+#include "ConnectionPool.h"
+#include "ContentVerifier.h"
+#include "Metrics.h"
+#include "Protocol.h"
+#include "TtlCache.h"
+
+class Connection;
+
+/// <summary>
+/// ȤݹҡA C API  ClientHandle
+/// CӽШDqsuɥΤ@suAP@ҥiѦhӰPɩIs
+/// </summary>
+class Client
+{
+public:
+	explicit Client(const ClientOptions& options);
+	~Client();
+
+	/// <summary>
+	/// w]Ȥݳ]w
+	/// </summary>
+	static ClientOptions defaultOptions();
+
+	Client(const Client&) = delete;
+	Client& operator=(const Client&) = delete;
+
+	bool initialize(
+		const char* stationType,
+		const char* stationName,
+		const char* stationId,
+		const char* operatorId
+	);
+
+	int sendData(
+		const char* askId,
+		const char* productSeries,
+		const char* applicableProjects,
+		const char* customizeId,
+		bool isGetFile
+	);
+
+	int receiveData(char* buffer, int bufferSize);
+
+	bool closeConnection();
+
+	FileInfo* getBinFileInfo(
+		const char* askId,
+		const char* productSeries,
+		const char* applicableProjects,
+		const char* customizeId
+	);
+
+	FileInfo* getBinFileInfoIfModified(
+		const char* askId,
+		const char* productSeries,
+		const char* applicableProjects,
+		const char* customizeId,
+		const char* knownVersion,
+		bool* notModified
+	);
+
+	bool getBinFileStream(
+		const char* askId,
+		const char* productSeries,
+		const char* applicableProjects,
+		const char* customizeId,
+		BinFileChunkCallback callback,
+		void* userData,
+		FileInfo* fileInfo
+	);
+
+	bool getBinFileToPath(
+		const char* askId,
+		const char* productSeries,
+		const char* applicableProjects,
+		const char* customizeId,
+		const char* destinationPath,
+		FileInfo* fileInfo
+	);
+
+	MainAppInfo* getMainAppInfo(const char* productSeries, const char* applicableProjects, const char* customizeId);
+
+	DefaultParametersInfo* getDefaultParametersInfo(const char* productSeries, const char* applicableProjects, const char* customizeId);
+
+	bool getBatch(const BatchQuery* queries, int count, BatchResult* results);
+
+	/// <summary>
+	/// b I/O W workAOGéIs callback
+	/// </summary>
+	AsyncRequest submitAsync(std::function<AsyncResult()> work, AsyncCompletionCallback callback, void* userData);
+
+	void setInfoCacheTtl(int ttlMs);
+
+	void invalidateInfoCache();
+
+	bool getMetrics(ClientMetrics* metrics);
+
+	bool dumpMetrics(const char* path);
+
+private:
+	ClientOptions options;
+	Metrics metrics;
+	std::unique_ptr<BinCache> cache;
+	TtlCache<MainAppInfo> mainAppCache;
+	TtlCache<DefaultParametersInfo> defaultParametersCache;
+
+	// O@ isInitialized P poolAШD
+	std::mutex stateMutex;
+	bool isInitialized = false;
+	std::shared_ptr<ConnectionPool> pool;
+	std::string stationId;
+
+	// Ĥ@ӫDPBШDɫإߡAƬiPɶi檺ШD
+	std::mutex executorMutex;
+	std::unique_ptr<AsyncExecutor> executor;
+
+	/// <summary>
+	/// qsuɥX@suAlƩεLksuɦ^ǪŪ PooledConnection
+	/// </summary>
+	PooledConnection acquireConnection(const char* caller);
+	bool closeConnectionLocked();
+
+	bool requestBinFile(
+		const char* caller,
+		Connection& connection,
+		const char* askId,
+		const char* productSeries,
+		const char* applicableProjects,
+		const char* customizeId,
+		const char* knownVersion,
+		BinFileHeader& header,
+		ByteRange range = ByteRange{ 0, 0 },
+		const char* knownSha256 = nullptr
+	);
+	bool readBinFileHeader(const char* caller, Connection& connection, const char* knownVersion, BinFileHeader& header);
+
+	/// <summary>
+	///  header ᪺ɮפeAإ߷s FileInfo
+	/// </summary>
+	/// <param name="resumeKey"> nullptr ɳsu_H䭫sШDl</param>
+	/// <param name="verifier">̧ǭpⱵeAheader ɮ׮ɨæb</param>
+	FileInfo* receiveBinFileInfo(const char* caller, PooledConnection& connection, const BinFileHeader& header,
+		ContentVerifier& verifier, const BinCacheKey* resumeKey = nullptr);
+
+	/// <summary>
+	/// eJ verifier PYˬdXAŮɰO~
+	/// </summary>
+	bool verifyContent(const char* caller, ContentVerifier& verifier, const std::string& fileName);
+
+	/// <summary>
+	/// H֨oeШDAAȾ^tɮMΨ֨ɮ
+	/// </summary>
+	/// <param name="cachedData">AȾ^ notModified ήtɬMg֨ɮ (entry )A_h nullptr Bɮפe򱵦bsu</param>
+	bool requestCachedBinFile(
+		const char* caller,
+		Connection& connection,
+		const BinCacheKey& key,
+		BinFileHeader& header,
+		BinCacheEntry& entry,
+		char*& cachedData,
+		ByteRange range = ByteRange{ 0, 0 }
+	);
+	/// <summary>
+	/// t׸ɸƨîMΨ֨ªAG۲ŮɼgJ֨çs entry
+	/// </summary>
+	/// <returns>LkMήɦ^ falseAsuiϥήɥiאּU</returns>
+	bool applyDelta(const char* caller, Connection& connection, const BinCacheKey& key, const BinFileHeader& header,
+		BinCacheEntry& entry);
+	FileInfo* fetchBinFileInfo(
+		const char* caller,
+		const char* askId,
+		const char* productSeries,
+		const char* applicableProjects,
+		const char* customizeId,
+		const char* knownVersion,
+		bool* notModified
+	);
+	/// <summary>
+	/// 妸@Ӷت^
+	/// </summary>
+	/// <param name="generation">eXeoT֨@N</param>
+	/// <returns>.bin ɮצ^ notModified ֨ɮפwQRAݭnb妸ɵoШDɦ^ false</returns>
+	bool receiveBatchResult(
+		PooledConnection& connection,
+		const BatchQuery& query,
+		const AskRequest& request,
+		const BinCacheEntry& entry,
+		uint64_t generation,
+		BatchResult& result
+	);
+	void receiveBatchBinFile(
+		PooledConnection& connection,
+		const AskRequest& request,
+		const BinFileHeader& header,
+		BatchResult& result
+	);
+
+	/// <summary>
+	/// GetBinFileToPath Ȧs (ت|[W .part)A_ɫOḑǧ}YѤUIs
+	/// </summary>
+	struct PartialFile
+	{
+		std::string path;
+		// ǿhigJɮ׮ɪɮ״yzA_h -1
+		int fd = -1;
+		// WOdeݪPɮפjpAoffset  0 ܱqYU
+		std::string version;
+		uint64_t fileSize = 0;
+		uint64_t offset = 0;
+		// Isqɮ׶}Y̧ǧ
+		uint64_t completed = 0;
+		// AȾWɮפwOOdAݭnqYU
+		bool stale = false;
+	};
+
+	/// <param name="partial">gJ GetBinFileToPath Ȧsɮɤ nullptrAɥiqUP</param>
+	bool streamBinFile(
+		const char* caller,
+		PooledConnection& connection,
+		const char* askId,
+		const char* productSeries,
+		const char* applicableProjects,
+		const char* customizeId,
+		BinFileChunkCallback callback,
+		void* userData,
+		FileInfo* fileInfo,
+		PartialFile* partial = nullptr
+	);
+
+	/// <summary>
+	/// su|ɮפeGposition  end 
+	/// </summary>
+	struct BodyCursor
+	{
+		uint64_t position;
+		uint64_t end;
+	};
+
+	/// <summary>
+	///  length 줸ժɮפeëei cursorFsu_B resumeKey  nullptr ɭssuA
+	/// HdШDq cursor.position ~ASseɳ̦hs resumeAttempts 
+	/// </summary>
+	/// <param name="verifier"> nullptr ɥHpqACXƤb CPU ֨pˬdX</param>
+	/// <returns>줸ռơAp length ܥѡAconnection iwssuά</returns>
+	size_t receiveBody(
+		const char* caller,
+		PooledConnection& connection,
+		const BinCacheKey* resumeKey,
+		const BinFileHeader& header,
+		BodyCursor& cursor,
+		char* destination,
+		size_t length,
+		ContentVerifier* verifier = nullptr
+	);
+
+	/// <summary>
+	/// b connection WШD cursor ҫdAýT{^P header P@ɮסF
+	/// su_ɭssuAШDAattempts ֭pwssu
+	/// </summary>
+	bool requestBody(
+		const char* caller,
+		PooledConnection& connection,
+		const BinCacheKey& key,
+		const BinFileHeader& header,
+		const BodyCursor& cursor,
+		int& attempts
+	);
+
+	/// <summary>
+	/// qUتaAmemory  nullptr ɼgJOA_hgJ path ɮתm
+	/// </summary>
+	struct RangeTarget
+	{
+		char* memory;
+		const std::string* path;
+	};
+
+	/// <summary>
+	/// Ĥ@ .bin ɮ׽ШDdAҥΤqUɤwd
+	/// </summary>
+	ByteRange firstRange() const;
+
+	/// <summary>
+	/// H̦h rangeConnections suPɤU start ᪺lAconnection Ĥ@ӽШDsu
+	/// </summary>
+	/// <param name="verifier">uݭn CRC32C ɦUqOp̧ǱWFݭn SHA-256 ɤpA
+	/// position b startAѩIsŪ^le</param>
+	bool fetchRanges(
+		const char* caller,
+		PooledConnection& connection,
+		const BinCacheKey& key,
+		const BinFileHeader& header,
+		uint64_t start,
+		const RangeTarget& target,
+		ContentVerifier& verifier
+	);
+	bool fetchRange(
+		const char* caller,
+		PooledConnection& connection,
+		const BinCacheKey& key,
+		const BinFileHeader& header,
+		ByteRange range,
+		const RangeTarget& target,
+		ContentVerifier* verifier
+	);
+};
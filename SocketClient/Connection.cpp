@@ -0,0 +1,512 @@
+#include "pch.h"
+#include "Connection.h"
+#include "Logger.h"
+#include "Lz4Decoder.h"
+#include "MessageReader.h"
+#include "Metrics.h"
+#include "Transport.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+#ifndef _WIN32
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+Connection::Connection(Metrics* metrics, bool pipelined, TransportBackend backend)
+	: transport(CreateTransport(backend)), broken(false), interrupted(false), metrics(metrics), pipelined(pipelined)
+{
+	requestBuffer.reserve(REQUEST_BUFFER_SIZE);
+}
+
+Connection::~Connection() = default;
+
+bool Connection::open(const std::string& address, const std::string& port)
+{
+	if (!transport->connect(address.c_str(), port.c_str())) {
+		if (metrics) {
+			metrics->recordError(METRICS_ERROR_CONNECT);
+		}
+		return false;
+	}
+	if (metrics) {
+		metrics->recordPhase(METRICS_PHASE_DNS, transport->connectTiming().resolve);
+		metrics->recordPhase(METRICS_PHASE_CONNECT, transport->connectTiming().connect);
+	}
+	reader = std::make_unique<MessageReader>(*transport);
+	return true;
+}
+
+void Connection::recordFailure(MetricsError error)
+{
+	interrupted = true;
+	if (metrics) {
+		metrics->recordError(IsTimeoutError(transport->lastError()) ? METRICS_ERROR_TIMEOUT : error);
+	}
+}
+
+int Connection::sendRequest(
+	const char* askId,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	bool isGetFile,
+	const char* knownVersion
+) {
+	AskRequest request = { askId, productSeries, applicableProjects, customizeId, isGetFile, knownVersion };
+	return sendRequest(request);
+}
+
+int Connection::sendRequest(const AskRequest& request)
+{
+	if (!pipelined) {
+		SerializeRequest(request, 0, requestBuffer);
+		return sendMessage(requestBuffer);
+	}
+
+	std::lock_guard<std::mutex> lock(sendMutex);
+	uint64_t requestId = nextRequestId++;
+	// nOAeXALiߧYŪ^
+	registerRequest(requestId, 1);
+	SerializeRequest(request, requestId, requestBuffer);
+	int result = sendMessage(requestBuffer);
+	if (result < 0) {
+		failPending();
+	}
+	return result;
+}
+
+int Connection::sendBatchRequest(const std::vector<AskRequest>& requests)
+{
+	if (!pipelined) {
+		SerializeBatchRequest(requests, 0, requestBuffer);
+		return sendMessage(requestBuffer);
+	}
+
+	// ӧ妸ϥΤ@ requestIdAUت^̧ǨFAiPLШD^
+	std::lock_guard<std::mutex> lock(sendMutex);
+	uint64_t requestId = nextRequestId++;
+	registerRequest(requestId, requests.size());
+	SerializeBatchRequest(requests, requestId, requestBuffer);
+	int result = sendMessage(requestBuffer);
+	if (result < 0) {
+		failPending();
+	}
+	return result;
+}
+
+void Connection::registerRequest(uint64_t requestId, size_t responses)
+{
+	std::lock_guard<std::mutex> lock(pipelineMutex);
+	PendingResponse* response;
+	if (!spareResponses.empty()) {
+		// ƨϥΤwШD`IAYrOd즳Ŷ
+		auto node = std::move(spareResponses.back());
+		spareResponses.pop_back();
+		node.key() = requestId;
+		node.mapped().ready = false;
+		node.mapped().header.clear();
+		response = &pending.insert(std::move(node)).position->second;
+	}
+	else {
+		response = &pending[requestId];
+	}
+	response->owner = std::this_thread::get_id();
+	response->sentAt = std::chrono::steady_clock::now();
+	response->remaining = responses;
+	sendOrder.push_back(requestId);
+}
+
+void Connection::releaseResponse(std::map<uint64_t, PendingResponse>::iterator it)
+{
+	spareResponses.push_back(pending.extract(it));
+}
+
+void Connection::releaseResponse(uint64_t requestId)
+{
+	auto it = pending.find(requestId);
+	if (it != pending.end()) {
+		releaseResponse(it);
+	}
+}
+
+// suwlaAҦݦ^
+void Connection::failPending()
+{
+	broken = true;
+	std::lock_guard<std::mutex> lock(pipelineMutex);
+	responseReady.notify_all();
+}
+
+int Connection::sendMessage(const std::string& message)
+{
+	auto sendStart = std::chrono::steady_clock::now();
+	int iResult = transport->send(message.c_str(), message.length());
+	if (iResult < 0) {
+		Logger::error("Send failed with error: " + std::to_string(transport->lastError()));
+		broken = true;
+		recordFailure(METRICS_ERROR_SEND);
+		return -1;
+	}
+	sentAt = std::chrono::steady_clock::now();
+	if (metrics) {
+		metrics->recordPhase(METRICS_PHASE_SEND, sentAt - sendStart);
+		metrics->addBytesSent((size_t)iResult);
+	}
+
+	return iResult;
+}
+
+bool Connection::receiveHeader(std::string& header)
+{
+	if (pipelined) {
+		return receivePipelinedHeader(header);
+	}
+
+	if (!readHeader(header)) {
+		return false;
+	}
+	if (metrics) {
+		metrics->recordPhase(METRICS_PHASE_FIRST_BYTE, std::chrono::steady_clock::now() - sentAt);
+	}
+	return true;
+}
+
+bool Connection::receivePipelinedHeader(std::string& header)
+{
+	std::thread::id self = std::this_thread::get_id();
+	std::unique_lock<std::mutex> lock(pipelineMutex);
+
+	// ̦eXB|ШD
+	auto mine = std::find_if(pending.begin(), pending.end(), [self](const auto& entry) {
+		return entry.second.owner == self;
+	});
+	if (mine == pending.end()) {
+		Logger::error("No outstanding request on this connection");
+		return false;
+	}
+	uint64_t requestId = mine->first;
+
+	while (true) {
+		auto it = pending.find(requestId);
+		if (it->second.ready) {
+			// Ū즹^wŪv浹
+			header.swap(it->second.header);
+			it->second.ready = false;
+			if (it->second.remaining == 0) {
+				releaseResponse(it);
+			}
+			return true;
+		}
+		if (broken) {
+			releaseResponse(it);
+			return false;
+		}
+		if (readerBusy && readerOwner != self) {
+			responseReady.wait(lock);
+			continue;
+		}
+
+		readerBusy = true;
+		readerOwner = self;
+		lock.unlock();
+		bool received = readHeader(nextHeader);
+		uint64_t target = received ? ParseResponseId(nextHeader) : 0;
+		lock.lock();
+
+		if (!received) {
+			readerBusy = false;
+			releaseResponse(requestId);
+			responseReady.notify_all();
+			return false;
+		}
+
+		if (target == 0 && !sendOrder.empty()) {
+			// AȾ^ requestIdA̰eXǹ
+			target = sendOrder.front();
+		}
+		auto targetIt = pending.find(target);
+		auto orderIt = std::find(sendOrder.begin(), sendOrder.end(), target);
+		if (targetIt == pending.end() || orderIt == sendOrder.end() || targetIt->second.ready) {
+			Logger::error("Received response for unknown request " + std::to_string(target));
+			if (metrics) {
+				metrics->recordError(METRICS_ERROR_PROTOCOL);
+			}
+			broken = true;
+			readerBusy = false;
+			releaseResponse(requestId);
+			responseReady.notify_all();
+			return false;
+		}
+		PendingResponse& response = targetIt->second;
+		if (--response.remaining == 0) {
+			sendOrder.erase(orderIt);
+		}
+		if (metrics) {
+			metrics->recordPhase(METRICS_PHASE_FIRST_BYTE, std::chrono::steady_clock::now() - response.sentAt);
+		}
+
+		// H洫NʡAYrꪺŶbШDyϥ
+		if (target == requestId) {
+			header.swap(nextHeader);
+			if (response.remaining == 0) {
+				releaseResponse(targetIt);
+			}
+			return true;
+		}
+
+		// 浹ݦ^AŪv@ಾ
+		response.header.swap(nextHeader);
+		response.ready = true;
+		readerOwner = response.owner;
+		responseReady.notify_all();
+	}
+}
+
+void Connection::endLease()
+{
+	if (!pipelined) {
+		return;
+	}
+
+	std::thread::id self = std::this_thread::get_id();
+	std::lock_guard<std::mutex> lock(pipelineMutex);
+	for (auto it = pending.begin(); it != pending.end();) {
+		if (it->second.owner == self) {
+			// ^FɨSHA򪺸ƵLkA
+			Logger::error("Lease ended with unanswered request " + std::to_string(it->first));
+			broken = true;
+			sendOrder.erase(std::remove(sendOrder.begin(), sendOrder.end(), it->first), sendOrder.end());
+			releaseResponse(it++);
+		}
+		else {
+			++it;
+		}
+	}
+	if (readerBusy && readerOwner == self) {
+		readerBusy = false;
+	}
+	responseReady.notify_all();
+}
+
+bool Connection::readHeader(std::string& header)
+{
+	int headerResult = reader->readHeader(header);
+	if (headerResult <= 0) {
+		Logger::error("Failed to receive header data. Result: " + std::to_string(headerResult) +
+			", " + reader->lastError());
+		broken = true;
+		if (reader->isMalformed()) {
+			if (metrics) {
+				metrics->recordError(METRICS_ERROR_PROTOCOL);
+			}
+		}
+		else {
+			recordFailure(METRICS_ERROR_RECEIVE);
+		}
+		return false;
+	}
+	if (metrics) {
+		metrics->addBytesReceived(header.size());
+	}
+	return true;
+}
+
+int Connection::receive(char* buffer, size_t length)
+{
+	int received = reader->read(buffer, length);
+	if (received <= 0) {
+		broken = true;
+		recordFailure(METRICS_ERROR_RECEIVE);
+	}
+	else if (metrics) {
+		metrics->addBytesReceived((size_t)received);
+	}
+	return received;
+}
+
+bool Connection::beginBody(BodyEncoding encoding, size_t encodedSize, size_t decodedSize)
+{
+	decoding = encoding == BODY_ENCODING_LZ4;
+	if (!decoding) {
+		return true;
+	}
+	if (!decoder) {
+		decoder = std::make_unique<Lz4FrameDecoder>();
+	}
+	decoder->begin(encodedSize, decodedSize);
+	if (decodedSize > 0) {
+		return true;
+	}
+	// SeɨSH|ŪAŪ frame subU@Ӧ^}Y
+	receiveDecoded(nullptr, 0);
+	return decoder->isFinished();
+}
+
+size_t Connection::receiveDecoded(char* destination, size_t length)
+{
+	size_t consumedBefore = decoder->consumedInput();
+	size_t received = decoder->read(*reader, destination, length);
+	if (metrics) {
+		metrics->addBytesReceived(decoder->consumedInput() - consumedBefore);
+	}
+	if (received < length || decoder->isMalformed()) {
+		decoding = false;
+		broken = true;
+		if (decoder->isMalformed()) {
+			Logger::error("Failed to decompress file content: " + decoder->lastError());
+			if (metrics) {
+				metrics->recordError(METRICS_ERROR_PROTOCOL);
+			}
+		}
+		else {
+			recordFailure(METRICS_ERROR_RECEIVE);
+		}
+		return received;
+	}
+	if (decoder->isFinished()) {
+		decoding = false;
+	}
+	return received;
+}
+
+size_t Connection::receiveFull(char* destination, size_t length)
+{
+	if (decoding) {
+		return receiveDecoded(destination, length);
+	}
+
+	size_t received = reader->readFull(destination, length);
+	if (metrics) {
+		metrics->addBytesReceived(received);
+	}
+	if (received < length) {
+		broken = true;
+		recordFailure(METRICS_ERROR_RECEIVE);
+	}
+	return received;
+}
+
+bool Connection::canReceiveToFile() const
+{
+	return transport->supportsReceiveToFile();
+}
+
+size_t Connection::receiveToFile(int fileFd, uint64_t offset, size_t length)
+{
+	size_t written = 0;
+#ifndef _WIN32
+	// PY@_쪺egJ
+	size_t buffered = std::min(reader->buffered(), length);
+	if (buffered > 0) {
+		std::vector<char> prefix(buffered);
+		reader->take(prefix.data(), buffered);
+		if (pwrite(fileFd, prefix.data(), buffered, (off_t)offset) != (ssize_t)buffered) {
+			Logger::error("Failed to write file content: " + std::to_string(errno));
+			broken = true;
+			return 0;
+		}
+		written = buffered;
+	}
+	if (written < length) {
+		written += transport->receiveToFile(fileFd, offset + written, length - written);
+	}
+#endif
+	if (metrics) {
+		metrics->addBytesReceived(written);
+	}
+	if (written < length) {
+		Logger::error("Failed to receive file content to file: " + std::to_string(transport->lastError()));
+		broken = true;
+		recordFailure(METRICS_ERROR_RECEIVE);
+	}
+	return written;
+}
+
+bool Connection::discardBody(size_t remaining)
+{
+	if (decoding) {
+		remaining = decoder->remainingInput();
+		decoding = false;
+	}
+	char buffer[4096];
+	while (remaining > 0) {
+		int bytesReceived = receive(buffer, std::min(sizeof(buffer), remaining));
+		if (bytesReceived <= 0) {
+			return false;
+		}
+		remaining -= bytesReceived;
+	}
+	return true;
+}
+
+bool Connection::close()
+{
+	if (!transport->isConnected()) {
+		return true;
+	}
+
+	// oe_}sШD
+	std::string jsonStr = SerializeDisconnectRequest();
+
+	Logger::debug("Sending disconnect request");
+	int sendResult = transport->send(jsonStr.c_str(), jsonStr.length());
+
+	if (sendResult < 0) {
+		// oeѡAsɵoͿ~
+		Logger::error("Failed to send disconnect request: " + std::to_string(transport->lastError()));
+		transport->close();
+		return false;
+	}
+
+	// ݤ@pqɶATOAȾШD
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+	if (!transport->shutdownSend()) {
+		// oeqDɵoͿ~
+		Logger::error("shutdown failed with error: " + std::to_string(transport->lastError()));
+		transport->close();
+		return false;
+	}
+
+	if (!transport->close()) {
+		//  socket ɵoͿ~
+		Logger::error("closesocket failed with error: " + std::to_string(transport->lastError()));
+		return false;
+	}
+	return true;
+}
+
+void Connection::abort()
+{
+	if (transport->isConnected()) {
+		transport->close();
+	}
+}
+
+bool Connection::isOpen() const
+{
+	return transport->isConnected();
+}
+
+bool Connection::isHealthy() const
+{
+	return !broken && transport->isConnected();
+}
+
+void Connection::markBroken()
+{
+	broken = true;
+}
+
+bool Connection::isInterrupted() const
+{
+	return interrupted;
+}
+
+const std::string& Connection::lastError() const
+{
+	static const std::string notConnected = "Not connected";
+	return reader ? reader->lastError() : notConnected;
+}
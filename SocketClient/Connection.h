@@ -0,0 +1,202 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SocketClient.h"
+#include "Protocol.h"
+
+class Transport;
+class MessageReader;
+class Metrics;
+class Lz4FrameDecoder;
+
+/// <summary>
+/// PAȾ@suGǿh[WTŪA
+/// tdШDeXP^Y
+///
+/// ޽uƪsuiѦhӰPɭɥΡGCӽШDa requestIdA
+/// ^Y requestId 浹eXШD (AȾ^ requestId ɨ̰eX)F
+/// YPɨoŪvAŪɮפeõɥΫ~浹U@Ӧ^
+/// 妸ШDu@ requestIdAUت^̧ǨFF
+/// P@ӽШDǰePbP@
+/// </summary>
+class Connection
+{
+public:
+	/// <param name="metrics">OsuBǰePέpAi nullptr</param>
+	/// <param name="pipelined">O_\hӽШDPɨϥΦsu</param>
+	/// <param name="backend">ǿh@</param>
+	explicit Connection(Metrics* metrics = nullptr, bool pipelined = false, TransportBackend backend = TRANSPORT_DEFAULT);
+	~Connection();
+
+	/// <summary>
+	/// sAȾ
+	/// </summary>
+	bool open(const std::string& address, const std::string& port);
+
+	/// <summary>
+	/// ǰeШD
+	/// </summary>
+	/// <param name="knownVersion">wɮתADŮɪAȾۦPhu^ notModified</param>
+	/// <returns>ǰe줸ռơAѦ^ -1</returns>
+	int sendRequest(
+		const char* askId,
+		const char* productSeries,
+		const char* applicableProjects,
+		const char* customizeId,
+		bool isGetFile,
+		const char* knownVersion = nullptr
+	);
+
+	/// <summary>
+	/// ǰe@ӽШDAiwɮפed
+	/// </summary>
+	/// <returns>ǰe줸ռơAѦ^ -1</returns>
+	int sendRequest(const AskRequest& request);
+
+	/// <summary>
+	/// H@ӰTǰehӽШDAAȾ̧Ǧ^CӶ (YAɮɱɮפe)
+	/// </summary>
+	/// <returns>ǰe줸ռơAѦ^ -1</returns>
+	int sendBatchRequest(const std::vector<AskRequest>& requests);
+
+	/// <summary>
+	/// @ӧ㪺 JSON YAPY@_FeƫOdbŪ
+	/// </summary>
+	bool receiveHeader(std::string& header);
+
+	/// <summary>
+	/// ŪeơA̦h length 줸
+	/// </summary>
+	int receive(char* buffer, size_t length);
+
+	/// <summary>
+	///  .bin ɮ׼Y]wesXA᪺ receiveFull XY᪺e
+	/// </summary>
+	/// <param name="encodedSize">sueסAYɤϥ</param>
+	/// <param name="decodedSize">Y᪺</param>
+	/// <returns>Y᪺׬ 0 ɪŪYeAѦ^ false</returns>
+	bool beginBody(BodyEncoding encoding, size_t encodedSize, size_t decodedSize);
+
+	/// <summary>
+	/// Ūn length 줸ըتOAegLY䱵Y
+	/// </summary>
+	size_t receiveFull(char* destination, size_t length);
+
+	/// <summary>
+	/// ǿhO_NegJɮ (io_uring)
+	/// </summary>
+	bool canReceiveToFile() const;
+
+	/// <summary>
+	/// Ūn length 줸ըñqɮת offset mgJAwİϤƥgJAlѶǿhgJ
+	/// </summary>
+	/// <returns>gJ줸ռơAp length ܳsuΥ</returns>
+	size_t receiveToFile(int fileFd, uint64_t offset, size_t length);
+
+	/// <summary>
+	/// ŪeơAsubU@Ӧ^}YFegLYɥlYe
+	/// </summary>
+	bool discardBody(size_t remaining);
+
+	/// <summary>
+	/// eX_uШD socket
+	/// </summary>
+	bool close();
+
+	/// <summary>
+	/// eX_uШDA socketAΩwhPBζmOɪsu
+	/// </summary>
+	void abort();
+
+	bool isOpen() const;
+
+	/// <summary>
+	/// su}ҥBSo͹Lǰeα~AiH浹U@ӽШDϥ
+	/// </summary>
+	bool isHealthy() const;
+
+	/// <summary>
+	/// аOsuwLkϥΡAҦp^YLkѪR
+	/// </summary>
+	void markBroken();
+
+	/// <summary>
+	/// su]ǰeBѩιOɦӤ_AssuiH~F^LkѪR~⤤_
+	/// </summary>
+	bool isInterrupted() const;
+
+	/// <summary>
+	/// ̪@Ѫyz
+	/// </summary>
+	const std::string& lastError() const;
+
+	bool isPipelined() const {
+		return pipelined;
+	}
+
+	/// <summary>
+	/// ثeɥΡGŪvF^ШDɳsuwLkPBAаOla
+	/// </summary>
+	void endLease();
+
+private:
+	struct PendingResponse
+	{
+		std::thread::id owner;
+		std::chrono::steady_clock::time_point sentAt;
+		// |쪺^ơA妸ШDUب̧Ǧ^P@ requestId
+		size_t remaining = 1;
+		bool ready = false;
+		std::string header;
+	};
+
+	std::unique_ptr<Transport> transport;
+	std::unique_ptr<MessageReader> reader;
+	// ثe^egLYA decoder Y
+	std::unique_ptr<Lz4FrameDecoder> decoder;
+	bool decoding = false;
+	std::atomic<bool> broken;
+	std::atomic<bool> interrupted;
+	Metrics* metrics;
+	std::chrono::steady_clock::time_point sentAt;
+	// ШDTwİϡACӽШDƨϥΡF޽uƮɥ sendMutex O@
+	std::string requestBuffer;
+
+	// ޽uƪAA pipelineMutex O@FsendMutex TOШDa̧ǼgJ
+	const bool pipelined;
+	std::mutex sendMutex;
+	std::mutex pipelineMutex;
+	std::condition_variable responseReady;
+	uint64_t nextRequestId = 1;
+	std::map<uint64_t, PendingResponse> pending;
+	// wШD`IAnOU@ӽШDɭƨϥΡAíwAUtmO
+	std::vector<std::map<uint64_t, PendingResponse>::node_type> spareResponses;
+	// |YШDA̰eXǡFƶqWL޽u`סAH vector קK deque ϶tm
+	std::vector<uint64_t> sendOrder;
+	// Ūv֦ŪU@ӼYwİ
+	std::string nextHeader;
+	bool readerBusy = false;
+	std::thread::id readerOwner;
+
+	// аOsu_Aè̶ǿh~XOOɩΫw~
+	void recordFailure(MetricsError error);
+
+	int sendMessage(const std::string& message);
+	size_t receiveDecoded(char* destination, size_t length);
+	bool readHeader(std::string& header);
+	bool receivePipelinedHeader(std::string& header);
+	void registerRequest(uint64_t requestId, size_t responses);
+	void releaseResponse(std::map<uint64_t, PendingResponse>::iterator it);
+	void releaseResponse(uint64_t requestId);
+	void failPending();
+};
@@ -0,0 +1,229 @@
+#include "pch.h"
+#include "ConnectionPool.h"
+#include "Connection.h"
+#include "Logger.h"
+#include "Transport.h"
+#include <algorithm>
+
+PooledConnection::PooledConnection(std::shared_ptr<ConnectionPool> pool, std::shared_ptr<Connection> connection)
+	: pool(std::move(pool)), connection(std::move(connection))
+{
+}
+
+PooledConnection& PooledConnection::operator=(PooledConnection&& other) noexcept
+{
+	if (this != &other) {
+		release();
+		pool = std::move(other.pool);
+		connection = std::move(other.connection);
+	}
+	return *this;
+}
+
+PooledConnection::~PooledConnection()
+{
+	release();
+}
+
+void PooledConnection::release()
+{
+	if (pool && connection) {
+		connection->endLease();
+		pool->release(connection);
+	}
+	connection.reset();
+	pool.reset();
+}
+
+ConnectionPool::ConnectionPool(const std::string& address, const std::string& port, size_t maxSize,
+	std::chrono::milliseconds idleTimeout, size_t pipelineDepth, Metrics* metrics, TransportBackend backend)
+	: address(address), port(port), maxSize(maxSize > 0 ? maxSize : 1), idleTimeout(idleTimeout),
+	pipelineDepth(pipelineDepth > 0 ? pipelineDepth : 1), metrics(metrics), backend(backend)
+{
+}
+
+ConnectionPool::~ConnectionPool()
+{
+	closeAll();
+}
+
+std::shared_ptr<Connection> ConnectionPool::openConnection()
+{
+	auto connection = std::make_shared<Connection>(metrics, pipelineDepth > 1, backend);
+	if (!connection->open(address, port)) {
+		Logger::error("Unable to connect to server");
+		return nullptr;
+	}
+	return connection;
+}
+
+size_t ConnectionPool::warmUp(size_t count)
+{
+	size_t opened = 0;
+	for (size_t i = 0; i < count; i++) {
+		{
+			std::lock_guard<std::mutex> lock(poolMutex);
+			if (closed || totalConnections >= maxSize) {
+				break;
+			}
+			totalConnections++;
+		}
+
+		auto connection = openConnection();
+
+		std::lock_guard<std::mutex> lock(poolMutex);
+		if (!connection) {
+			totalConnections--;
+			break;
+		}
+		entries.push_back({ std::move(connection), 0, std::chrono::steady_clock::now() });
+		opened++;
+	}
+	Logger::debug("Connection pool warmed up with " + std::to_string(opened) + " connections");
+	return opened;
+}
+
+PooledConnection ConnectionPool::acquire(bool idleOnly)
+{
+	std::vector<std::shared_ptr<Connection>> expired;
+	std::shared_ptr<Connection> connection;
+	bool createNew = false;
+
+	{
+		std::unique_lock<std::mutex> lock(poolMutex);
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(DEFAULT_IO_TIMEOUT_MS);
+
+		while (!connection && !createNew) {
+			if (closed) {
+				Logger::error("Connection pool is closed");
+				return PooledConnection();
+			}
+
+			// mL[su
+			auto now = std::chrono::steady_clock::now();
+			for (auto it = entries.begin(); it != entries.end();) {
+				if (it->leases == 0 && now - it->releasedAt > idleTimeout) {
+					expired.push_back(std::move(it->connection));
+					it = entries.erase(it);
+					totalConnections--;
+				}
+				else {
+					++it;
+				}
+			}
+
+			// ܶi椤ШD̤֪suFۦPɨϥγ̪k٪A SendData/ReceiveData ɶqbP@suW
+			PoolEntry* best = nullptr;
+			for (auto& entry : entries) {
+				if (entry.leases >= pipelineDepth || !entry.connection->isHealthy()) {
+					continue;
+				}
+				if (!best || entry.leases < best->leases ||
+					(entry.leases == best->leases && entry.releasedAt >= best->releasedAt)) {
+					best = &entry;
+				}
+			}
+
+			if (best && (best->leases == 0 || (totalConnections >= maxSize && !idleOnly))) {
+				best->leases++;
+				connection = best->connection;
+			}
+			else if (totalConnections < maxSize) {
+				// Smsuɥ}ssuAҦsubϥΤ~@
+				totalConnections++;
+				createNew = true;
+			}
+			else if (idleOnly) {
+				return PooledConnection();
+			}
+			else if (available.wait_until(lock, deadline) == std::cv_status::timeout) {
+				Logger::error("Timed out waiting for a pooled connection");
+				return PooledConnection();
+			}
+		}
+	}
+
+	// b~OɳsuPإ߷ssu
+	for (auto& stale : expired) {
+		Logger::debug("Closing idle connection");
+		stale->abort();
+	}
+
+	if (createNew) {
+		connection = openConnection();
+		std::lock_guard<std::mutex> lock(poolMutex);
+		if (!connection) {
+			totalConnections--;
+			available.notify_one();
+			return PooledConnection();
+		}
+		entries.push_back({ connection, 1, std::chrono::steady_clock::now() });
+	}
+
+	return PooledConnection(shared_from_this(), std::move(connection));
+}
+
+void ConnectionPool::release(const std::shared_ptr<Connection>& connection)
+{
+	bool healthy = connection->isHealthy();
+	bool discard = false;
+	{
+		std::lock_guard<std::mutex> lock(poolMutex);
+		auto it = std::find_if(entries.begin(), entries.end(), [&connection](const PoolEntry& entry) {
+			return entry.connection == connection;
+		});
+		if (it == entries.end()) {
+			return;
+		}
+
+		it->leases--;
+		it->releasedAt = std::chrono::steady_clock::now();
+		// laΤwsuҦɥεᲾ
+		if (it->leases == 0 && (!healthy || closed)) {
+			entries.erase(it);
+			totalConnections--;
+			discard = true;
+		}
+	}
+	if (pipelineDepth > 1) {
+		available.notify_all();
+	}
+	else {
+		available.notify_one();
+	}
+
+	if (discard) {
+		if (!healthy) {
+			Logger::debug("Discarding broken connection");
+		}
+		connection->abort();
+	}
+}
+
+bool ConnectionPool::closeAll()
+{
+	std::vector<std::shared_ptr<Connection>> closing;
+	{
+		std::lock_guard<std::mutex> lock(poolMutex);
+		closed = true;
+		for (auto it = entries.begin(); it != entries.end();) {
+			if (it->leases == 0) {
+				closing.push_back(std::move(it->connection));
+				it = entries.erase(it);
+				totalConnections--;
+			}
+			else {
+				++it;
+			}
+		}
+	}
+	available.notify_all();
+
+	bool success = true;
+	for (auto& connection : closing) {
+		if (!connection->close()) {
+			success = false;
+		}
+	}
+	return success;
+}
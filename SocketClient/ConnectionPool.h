@@ -0,0 +1,112 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "SocketClient.h"
+
+class Connection;
+class ConnectionPool;
+class Metrics;
+
+/// <summary>
+/// qsuɥXsuA}@ΰɦ۰k١F
+/// suoͿ~ɥѳsuAAƨϥ
+/// ޽uƮɦP@suiPɭɵhӽШD
+/// </summary>
+class PooledConnection
+{
+public:
+	PooledConnection() = default;
+	PooledConnection(std::shared_ptr<ConnectionPool> pool, std::shared_ptr<Connection> connection);
+	PooledConnection(PooledConnection&& other) noexcept = default;
+	PooledConnection& operator=(PooledConnection&& other) noexcept;
+	~PooledConnection();
+
+	Connection* operator->() const {
+		return connection.get();
+	}
+
+	Connection& operator*() const {
+		return *connection;
+	}
+
+	explicit operator bool() const {
+		return connection != nullptr;
+	}
+
+private:
+	std::shared_ptr<ConnectionPool> pool;
+	std::shared_ptr<Connection> connection;
+
+	void release();
+};
+
+/// <summary>
+/// suGOd̦h maxSize AȾsuA
+/// ШDɥX@suA\k٭ƨϥΡAmWLOɪsu|Q
+/// pipelineDepth j 1 ɨCsu̦hPɭɵ pipelineDepth ӽШD
+/// </summary>
+class ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
+{
+public:
+	/// <param name="pipelineDepth">CsuPɶi檺ШDƤW</param>
+	/// <param name="metrics">ssuOέpΡAi nullptr</param>
+	/// <param name="backend">ssuϥΪǿh@</param>
+	ConnectionPool(const std::string& address, const std::string& port, size_t maxSize,
+		std::chrono::milliseconds idleTimeout, size_t pipelineDepth = 1, Metrics* metrics = nullptr,
+		TransportBackend backend = TRANSPORT_DEFAULT);
+	~ConnectionPool();
+
+	/// <summary>
+	/// wإ count su
+	/// </summary>
+	/// <returns>\إߪsu</returns>
+	size_t warmUp(size_t count);
+
+	/// <summary>
+	/// ɥX@suAuϥζi椤ШD̤֡B䦸̪k٪suA
+	/// Ҧsuwɫإ߷ssuAwFWɵݨLШDk
+	/// </summary>
+	/// <param name="idleOnly">uɥXmsuΫإ߷ssuASɥߧY^ǪŪ PooledConnection Ӥ</param>
+	/// <returns>suѩιOɦ^ǪŪ PooledConnection</returns>
+	PooledConnection acquire(bool idleOnly = false);
+
+	/// <summary>
+	/// ҦmsuAɥXsubkٮ
+	/// </summary>
+	bool closeAll();
+
+private:
+	struct PoolEntry
+	{
+		std::shared_ptr<Connection> connection;
+		// ɥXШDơA0 ܶm
+		size_t leases;
+		std::chrono::steady_clock::time_point releasedAt;
+	};
+
+	std::string address;
+	std::string port;
+	size_t maxSize;
+	std::chrono::milliseconds idleTimeout;
+	size_t pipelineDepth;
+	Metrics* metrics;
+	TransportBackend backend;
+
+	std::mutex poolMutex;
+	std::condition_variable available;
+	std::vector<PoolEntry> entries;
+	// ]tbإߤsu
+	size_t totalConnections = 0;
+	bool closed = false;
+
+	std::shared_ptr<Connection> openConnection();
+	void release(const std::shared_ptr<Connection>& connection);
+
+	friend class PooledConnection;
+};
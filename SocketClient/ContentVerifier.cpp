@@ -0,0 +1,52 @@
+#include "pch.h"
+#include "ContentVerifier.h"
+#include "Crc32c.h"
+#include "Protocol.h"
+#include <stdio.h>
+
+ContentVerifier::ContentVerifier(const BinFileHeader& header)
+	: checkCrc(header.hasCrc32c), checkSha(!header.sha256.empty()), expectedCrc(header.crc32c), expectedSha(header.sha256)
+{
+}
+
+ContentVerifier ContentVerifier::crcOnly()
+{
+	ContentVerifier verifier;
+	verifier.checkCrc = true;
+	return verifier;
+}
+
+void ContentVerifier::update(const char* data, size_t size)
+{
+	if (checkCrc) {
+		crc = Crc32cUpdate(crc, data, size);
+	}
+	if (checkSha) {
+		sha.update(data, size);
+	}
+	length += size;
+}
+
+void ContentVerifier::combine(const ContentVerifier& part)
+{
+	crc = Crc32cCombine(crc, part.crc, part.length);
+	length += part.length;
+}
+
+bool ContentVerifier::verify(std::string& message)
+{
+	if (checkCrc && crc != expectedCrc) {
+		char text[64];
+		snprintf(text, sizeof(text), "CRC32C mismatch: expected %08x, got %08x", expectedCrc, crc);
+		message = text;
+		return false;
+	}
+	if (checkSha) {
+		std::string actual = sha.finishHex();
+		if (actual != expectedSha) {
+			message = "SHA-256 mismatch: expected " + expectedSha + ", got " + actual;
+			return false;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "Sha256.h"
+
+struct BinFileHeader;
+
+/// <summary>
+/// bj餤̧ǭp .bin ɮפe CRC32C P SHA-256APYѪȤ
+/// YSѪˬdXpFS isEnabled  false
+/// </summary>
+class ContentVerifier
+{
+public:
+	ContentVerifier() = default;
+	explicit ContentVerifier(const BinFileHeader& header);
+
+	/// <summary>
+	/// up CRC32C ӤAqUɦUqOpH combine ^ɮ
+	/// </summary>
+	static ContentVerifier crcOnly();
+
+	bool isEnabled() const {
+		return checkCrc || checkSha;
+	}
+
+	/// <summary>
+	/// uݭn CRC32C ɥiHX֤Op⪺UqFݭn SHA-256 ɤȩǿJ
+	/// </summary>
+	bool isCombinable() const {
+		return !checkSha;
+	}
+
+	/// <summary>
+	/// wJ
+	/// </summary>
+	uint64_t position() const {
+		return length;
+	}
+
+	void update(const char* data, size_t size);
+
+	/// <summary>
+	/// Wt~p⪺U@q (crcOnly)
+	/// </summary>
+	void combine(const ContentVerifier& part);
+
+	/// <summary>
+	/// eJPYȤ
+	/// </summary>
+	/// <returns>Ůɦ^ false ügJ message</returns>
+	bool verify(std::string& message);
+
+private:
+	bool checkCrc = false;
+	bool checkSha = false;
+	uint32_t expectedCrc = 0;
+	std::string expectedSha;
+	uint32_t crc = 0;
+	Sha256 sha;
+	uint64_t length = 0;
+};
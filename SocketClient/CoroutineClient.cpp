@@ -0,0 +1,392 @@
+#include "pch.h"
+#include "CoroutineClient.h"
+#include "AsyncSocket.h"
+#include "ContentVerifier.h"
+#include "EventLoop.h"
+#include "Logger.h"
+#include "MessageReader.h"
+#include "Protocol.h"
+#include <algorithm>
+#include <exception>
+#include <memory>
+
+CoroutineClient::CoroutineClient(EventLoop& loop)
+	: loop(loop)
+{
+	requestBuffer.reserve(REQUEST_BUFFER_SIZE);
+}
+
+CoroutineClient::~CoroutineClient()
+{
+}
+
+Task<bool> CoroutineClient::connect()
+{
+	co_return co_await connect(ServerAddress(), ServerPort());
+}
+
+Task<bool> CoroutineClient::connect(std::string address, std::string port)
+{
+	socket = std::make_unique<AsyncSocket>(loop);
+	reader = std::make_unique<MessageReader>();
+	broken = false;
+
+	// co_await GsJܼƦAP_GGCC 12 b if  co_await ɥiಣͿ~{X
+	bool connected = co_await socket->connect(address, port);
+	if (!connected) {
+		Logger::error("Unable to connect to server " + address + ":" + port);
+		socket.reset();
+		co_return false;
+	}
+	co_return true;
+}
+
+Task<bool> CoroutineClient::close()
+{
+	if (!socket || !socket->isConnected()) {
+		co_return true;
+	}
+
+	// oe_}sШDAshutdown |beXwƤJƫ~ǰe
+	std::string jsonStr = SerializeDisconnectRequest();
+	Logger::debug("Sending disconnect request");
+	int sendResult = co_await socket->send(jsonStr.c_str(), jsonStr.length());
+	bool success = true;
+	if (sendResult < 0) {
+		Logger::error("Failed to send disconnect request: " + std::to_string(socket->lastError()));
+		success = false;
+	}
+	else if (!socket->shutdownSend()) {
+		Logger::error("shutdown failed with error: " + std::to_string(socket->lastError()));
+		success = false;
+	}
+	socket->close();
+	co_return success;
+}
+
+bool CoroutineClient::isConnected() const
+{
+	return socket && socket->isConnected() && !broken;
+}
+
+bool CoroutineClient::checkReady(const char* caller) const
+{
+	if (!isConnected()) {
+		Logger::error(std::string(caller) + " called while not connected");
+		return false;
+	}
+	return true;
+}
+
+Task<bool> CoroutineClient::sendRequest(const AskRequest& request)
+{
+	SerializeRequest(request, 0, requestBuffer);
+	int result = co_await socket->send(requestBuffer.c_str(), requestBuffer.length());
+	if (result < 0) {
+		Logger::error("send failed with error: " + std::to_string(socket->lastError()));
+		broken = true;
+		co_return false;
+	}
+	co_return true;
+}
+
+Task<bool> CoroutineClient::receiveHeader(std::string& header)
+{
+	while (true) {
+		int result = reader->parseHeader(header);
+		if (result > 0) {
+			co_return true;
+		}
+		if (result < 0) {
+			Logger::error(reader->lastError());
+			broken = true;
+			co_return false;
+		}
+
+		size_t space = 0;
+		char* destination = reader->prepareFill(space);
+		int received = co_await socket->receive(destination, space);
+		if (received <= 0) {
+			Logger::error(received == 0 ? "Connection closed by server"
+				: "recv failed with error: " + std::to_string(socket->lastError()));
+			broken = true;
+			co_return false;
+		}
+		reader->commitFill((size_t)received);
+	}
+}
+
+// wİϤƥƻsLhAlتO
+Task<bool> CoroutineClient::receiveFull(char* destination, size_t length)
+{
+	size_t total = reader->take(destination, length);
+	while (total < length) {
+		int received = co_await socket->receive(destination + total, length - total);
+		if (received <= 0) {
+			Logger::error("Failed to receive file content. " +
+				std::string(received == 0 ? "Connection closed by server" : "recv failed with error: " + std::to_string(socket->lastError())) +
+				", Total received so far: " + std::to_string(total) + " of " + std::to_string(length));
+			broken = true;
+			co_return false;
+		}
+		total += (size_t)received;
+	}
+	co_return true;
+}
+
+// ŪɮפeAsui~ϥ
+Task<bool> CoroutineClient::discardBody(size_t remaining)
+{
+	std::unique_ptr<char[]> scratch(new char[READ_CHUNK_SIZE]);
+	while (remaining > 0) {
+		size_t chunkSize = std::min((size_t)READ_CHUNK_SIZE, remaining);
+		bool received = co_await receiveFull(scratch.get(), chunkSize);
+		if (!received) {
+			co_return false;
+		}
+		remaining -= chunkSize;
+	}
+	co_return true;
+}
+
+Task<bool> CoroutineClient::requestBinFile(const AskRequest& request, BinFileHeader& result)
+{
+	Logger::info("Getting binary file info...");
+	bool sent = co_await sendRequest(request);
+	if (!sent) {
+		Logger::error("Failed to send data request for binary file info");
+		co_return false;
+	}
+
+	std::string header;
+	bool received = co_await receiveHeader(header);
+	if (!received) {
+		result.message = "Failed to receive response header";
+		co_return false;
+	}
+
+	ResponseStatus status = ParseBinFileHeader(header, request.knownVersion && *request.knownVersion, result);
+	if (status == RESPONSE_SERVER_ERROR) {
+		Logger::error(result.message);
+		co_return false;
+	}
+	if (status == RESPONSE_MALFORMED) {
+		// Lko򤺮eסAsuAi
+		Logger::error(result.message + " in " + request.askId + "\nHeader content: " + header);
+		broken = true;
+		co_return false;
+	}
+	co_return true;
+}
+
+// ɮפePYˬdX
+static bool verifyContent(const std::string& fileName, ContentVerifier& verifier)
+{
+	std::string message;
+	if (verifier.verify(message)) {
+		return true;
+	}
+	Logger::error("Content of " + fileName + " is corrupted: " + message);
+	return false;
+}
+
+Task<FileInfo*> CoroutineClient::getBinFileInfo(
+	std::string askId,
+	std::string productSeries,
+	std::string applicableProjects,
+	std::string customizeId
+) {
+	co_return co_await getBinFileInfoIfModified(std::move(askId), std::move(productSeries),
+		std::move(applicableProjects), std::move(customizeId), std::string(), nullptr);
+}
+
+Task<FileInfo*> CoroutineClient::getBinFileInfoIfModified(
+	std::string askId,
+	std::string productSeries,
+	std::string applicableProjects,
+	std::string customizeId,
+	std::string knownVersion,
+	bool* notModified
+) {
+	if (notModified) {
+		*notModified = false;
+	}
+	if (!checkReady("GetBinFileInfo")) {
+		co_return nullptr;
+	}
+
+	AskRequest request{ askId.c_str(), productSeries.c_str(), applicableProjects.c_str(), customizeId.c_str(),
+		true, knownVersion.c_str() };
+	BinFileHeader header;
+	bool requested = co_await requestBinFile(request, header);
+	if (!requested) {
+		co_return nullptr;
+	}
+
+	if (header.notModified) {
+		Logger::info("File not modified since version " + knownVersion);
+		if (notModified) {
+			*notModified = true;
+		}
+		co_return nullptr;
+	}
+
+	//  FreeFileInfo 
+	std::unique_ptr<FileInfo> fileInfo(new FileInfo());
+	std::unique_ptr<char[]> data(new char[header.fileSize]);
+	fileInfo->size = header.fileSize;
+	copyString(fileInfo->fileName, header.fileName);
+	copyString(fileInfo->version, header.version);
+
+	// CӰ϶ߧYpˬdXAݭnAŪ@ɮ
+	ContentVerifier verifier(header);
+	size_t totalReceived = 0;
+	Logger::info("Starting file content reception");
+	while (totalReceived < header.fileSize) {
+		size_t chunkSize = std::min((size_t)READ_CHUNK_SIZE, header.fileSize - totalReceived);
+		bool received = co_await receiveFull(data.get() + totalReceived, chunkSize);
+		if (!received) {
+			co_return nullptr;
+		}
+		verifier.update(data.get() + totalReceived, chunkSize);
+		totalReceived += chunkSize;
+	}
+	if (!verifyContent(header.fileName, verifier)) {
+		co_return nullptr;
+	}
+
+	Logger::info("Successfully received file: " + header.fileName);
+	fileInfo->data = data.release();
+	co_return fileInfo.release();
+}
+
+Task<bool> CoroutineClient::getBinFileStream(
+	std::string askId,
+	std::string productSeries,
+	std::string applicableProjects,
+	std::string customizeId,
+	BinFileChunkCallback callback,
+	void* userData,
+	FileInfo* fileInfo
+) {
+	if (!callback) {
+		Logger::error("GetBinFileStream called without callback");
+		co_return false;
+	}
+	if (!checkReady("GetBinFileStream")) {
+		co_return false;
+	}
+
+	AskRequest request{ askId.c_str(), productSeries.c_str(), applicableProjects.c_str(), customizeId.c_str(),
+		true, nullptr };
+	BinFileHeader header;
+	bool requested = co_await requestBinFile(request, header);
+	if (!requested) {
+		co_return false;
+	}
+
+	size_t fileSize = header.fileSize;
+	if (fileInfo) {
+		fileInfo->data = nullptr;
+		fileInfo->size = fileSize;
+		copyString(fileInfo->fileName, header.fileName);
+		copyString(fileInfo->version, header.version);
+	}
+
+	// HTwjp϶å浹IsݡAOζqPɮפjpL
+	std::unique_ptr<char[]> chunk(new char[READ_CHUNK_SIZE]);
+	ContentVerifier verifier(header);
+	size_t totalReceived = 0;
+	Logger::info("Starting file content streaming");
+	while (totalReceived < fileSize) {
+		size_t chunkSize = std::min((size_t)READ_CHUNK_SIZE, fileSize - totalReceived);
+		bool received = co_await receiveFull(chunk.get(), chunkSize);
+		if (!received) {
+			co_return false;
+		}
+		verifier.update(chunk.get(), chunkSize);
+		if (!callback(chunk.get(), chunkSize, totalReceived, fileSize, userData)) {
+			Logger::error("File streaming aborted by callback at offset " + std::to_string(totalReceived));
+			co_await discardBody(fileSize - totalReceived - chunkSize);
+			co_return false;
+		}
+		totalReceived += chunkSize;
+	}
+	if (!verifyContent(header.fileName, verifier)) {
+		co_return false;
+	}
+
+	Logger::info("Successfully streamed file: " + header.fileName);
+	co_return true;
+}
+
+// ѪR MainApp / DefaultParameters ^A^SɮפeAѤvTsu
+template <typename Info>
+static Info* parseInfo(
+	const char* caller,
+	const std::string& header,
+	ResponseStatus (*parse)(const std::string&, Info&, std::string&)
+) {
+	Info info = {};
+	std::string message;
+	ResponseStatus status = parse(header, info, message);
+	if (status == RESPONSE_SERVER_ERROR) {
+		Logger::error(message);
+		return nullptr;
+	}
+	if (status == RESPONSE_MALFORMED) {
+		Logger::error(message + " in " + std::string(caller) + "\nHeader content: " + header);
+		return nullptr;
+	}
+	return new Info(info);
+}
+
+Task<MainAppInfo*> CoroutineClient::getMainAppInfo(std::string productSeries, std::string applicableProjects, std::string customizeId)
+{
+	if (!checkReady("GetMainAppInfo")) {
+		co_return nullptr;
+	}
+
+	Logger::info("Getting main app info...");
+	AskRequest request{ "MainApp", productSeries.c_str(), applicableProjects.c_str(), customizeId.c_str(), false, nullptr };
+	std::string header;
+	bool received = co_await sendRequest(request);
+	if (received) {
+		received = co_await receiveHeader(header);
+	}
+	if (!received) {
+		Logger::error("Failed to get main app info");
+		co_return nullptr;
+	}
+
+	MainAppInfo* info = parseInfo("GetMainAppInfo", header, ParseMainAppInfo);
+	if (info) {
+		Logger::info("Successfully retrieved main app info");
+	}
+	co_return info;
+}
+
+Task<DefaultParametersInfo*> CoroutineClient::getDefaultParametersInfo(std::string productSeries, std::string applicableProjects, std::string customizeId)
+{
+	if (!checkReady("GetDefaultParametersInfo")) {
+		co_return nullptr;
+	}
+
+	Logger::info("Getting default parameters info...");
+	AskRequest request{ "DefaultParameters", productSeries.c_str(), applicableProjects.c_str(), customizeId.c_str(), false, nullptr };
+	std::string header;
+	bool received = co_await sendRequest(request);
+	if (received) {
+		received = co_await receiveHeader(header);
+	}
+	if (!received) {
+		Logger::error("Failed to get default parameters info");
+		co_return nullptr;
+	}
+
+	DefaultParametersInfo* info = parseInfo("GetDefaultParametersInfo", header, ParseDefaultParametersInfo);
+	if (info) {
+		Logger::info("Successfully retrieved default parameters info");
+	}
+	co_return info;
+}
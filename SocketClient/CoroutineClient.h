@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include "SocketClient.h"
+#include "Task.h"
+
+class AsyncSocket;
+class EventLoop;
+class MessageReader;
+struct AskRequest;
+struct BinFileHeader;
+
+/// <summary>
+/// {Ȥ (C++ Aݩ C API)G@ӹҬ@ӯIu@qAϥΤ@su
+/// ҦШDOb EventLoop W檺 TaskAݺɤΰA
+/// ּƴXӰYiPXʼƦʭӤu@q
+/// P@ҦP@ɶui@ӽШDFϥγsuB֨P޽u
+/// ^Ǫ FileInfo H FreeFileInfo AMainAppInfo / DefaultParametersInfo H delete 
+/// </summary>
+class SOCKETCLIENT_API CoroutineClient
+{
+public:
+	explicit CoroutineClient(EventLoop& loop);
+	~CoroutineClient();
+
+	CoroutineClient(const CoroutineClient&) = delete;
+	CoroutineClient& operator=(const CoroutineClient&) = delete;
+
+	/// <summary>
+	/// sAȾ (}P InitializeClientAiܼмg)
+	/// </summary>
+	Task<bool> connect();
+
+	Task<bool> connect(std::string address, std::string port);
+
+	/// <summary>
+	/// eX_uШDsu
+	/// </summary>
+	Task<bool> close();
+
+	bool isConnected() const;
+
+	Task<FileInfo*> getBinFileInfo(
+		std::string askId,
+		std::string productSeries,
+		std::string applicableProjects,
+		std::string customizeId
+	);
+
+	/// <summary>
+	/// .binɮ׸TAѼƦP GetBinFileInfoIfModified
+	/// </summary>
+	Task<FileInfo*> getBinFileInfoIfModified(
+		std::string askId,
+		std::string productSeries,
+		std::string applicableProjects,
+		std::string customizeId,
+		std::string knownVersion,
+		bool* notModified
+	);
+
+	/// <summary>
+	/// Hy覡.binɮסA^Ibƥj骺WIsAѼƦP GetBinFileStream
+	/// </summary>
+	Task<bool> getBinFileStream(
+		std::string askId,
+		std::string productSeries,
+		std::string applicableProjects,
+		std::string customizeId,
+		BinFileChunkCallback callback,
+		void* userData,
+		FileInfo* fileInfo
+	);
+
+	Task<MainAppInfo*> getMainAppInfo(std::string productSeries, std::string applicableProjects, std::string customizeId);
+
+	Task<DefaultParametersInfo*> getDefaultParametersInfo(std::string productSeries, std::string applicableProjects, std::string customizeId);
+
+private:
+	EventLoop& loop;
+	std::unique_ptr<AsyncSocket> socket;
+	std::unique_ptr<MessageReader> reader;
+	// suhPB (ǰeBѩμY榡~)AAШD
+	bool broken = false;
+	// ШDTwİϡACӽШDƨϥ
+	std::string requestBuffer;
+
+	Task<bool> sendRequest(const AskRequest& request);
+	Task<bool> receiveHeader(std::string& header);
+	Task<bool> receiveFull(char* destination, size_t length);
+	Task<bool> discardBody(size_t remaining);
+	Task<bool> requestBinFile(const AskRequest& request, BinFileHeader& header);
+	bool checkReady(const char* caller) const;
+};
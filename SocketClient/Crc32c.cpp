@@ -0,0 +1,192 @@
+#include "pch.h"
+#include "Crc32c.h"
+#include <string.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define CRC32C_X86 1
+#include <nmmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define SSE42_TARGET
+#else
+#include <cpuid.h>
+#define SSE42_TARGET __attribute__((target("sse4.2")))
+#endif
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define CRC32C_ARM 1
+#include <arm_acle.h>
+#endif
+
+#define CRC32C_POLYNOMIAL 0x82F63B78 // 줸Ǫh
+
+// @Bz 8 줸ժd (slicing-by-8)
+struct Crc32cTables
+{
+	uint32_t table[8][256];
+
+	Crc32cTables() {
+		for (uint32_t i = 0; i < 256; i++) {
+			uint32_t crc = i;
+			for (int bit = 0; bit < 8; bit++) {
+				crc = (crc >> 1) ^ ((crc & 1) ? CRC32C_POLYNOMIAL : 0);
+			}
+			table[0][i] = crc;
+		}
+		for (uint32_t i = 0; i < 256; i++) {
+			for (int slice = 1; slice < 8; slice++) {
+				table[slice][i] = (table[slice - 1][i] >> 8) ^ table[0][table[slice - 1][i] & 0xFF];
+			}
+		}
+	}
+};
+
+static uint32_t updatePortable(uint32_t crc, const unsigned char* data, size_t length)
+{
+	static const Crc32cTables tables;
+	const auto& t = tables.table;
+	while (length >= 8) {
+		uint32_t low;
+		uint32_t high;
+		memcpy(&low, data, 4);
+		memcpy(&high, data + 4, 4);
+		// dHpݧǪ줸նǱƦC
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+		low = __builtin_bswap32(low);
+		high = __builtin_bswap32(high);
+#endif
+		low ^= crc;
+		crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^
+			t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^ t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+		data += 8;
+		length -= 8;
+	}
+	while (length-- > 0) {
+		crc = (crc >> 8) ^ t[0][(crc ^ *data++) & 0xFF];
+	}
+	return crc;
+}
+
+#ifdef CRC32C_X86
+SSE42_TARGET static uint32_t updateHardware(uint32_t crc, const unsigned char* data, size_t length)
+{
+	uint64_t value = crc;
+	while (length >= 8) {
+		uint64_t word;
+		memcpy(&word, data, sizeof(word));
+		value = _mm_crc32_u64(value, word);
+		data += 8;
+		length -= 8;
+	}
+	crc = (uint32_t)value;
+	while (length-- > 0) {
+		crc = _mm_crc32_u8(crc, *data++);
+	}
+	return crc;
+}
+
+static bool cpuHasSse42()
+{
+#ifdef _MSC_VER
+	int registers[4];
+	__cpuid(registers, 1);
+	return (registers[2] & (1 << 20)) != 0;
+#else
+	unsigned int eax, ebx, ecx, edx;
+	return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & (1u << 20)) != 0;
+#endif
+}
+#elif defined(CRC32C_ARM)
+static uint32_t updateHardware(uint32_t crc, const unsigned char* data, size_t length)
+{
+	while (length >= 8) {
+		uint64_t word;
+		memcpy(&word, data, sizeof(word));
+		crc = __crc32cd(crc, word);
+		data += 8;
+		length -= 8;
+	}
+	while (length-- > 0) {
+		crc = __crc32cb(crc, *data++);
+	}
+	return crc;
+}
+#endif
+
+typedef uint32_t (*UpdateFunction)(uint32_t crc, const unsigned char* data, size_t length);
+
+// Ĥ@ϥήɨ CPU ܹ@
+static UpdateFunction selectUpdate()
+{
+#if defined(CRC32C_X86)
+	if (cpuHasSse42()) {
+		return updateHardware;
+	}
+#elif defined(CRC32C_ARM)
+	return updateHardware;
+#endif
+	return updatePortable;
+}
+
+uint32_t Crc32cUpdate(uint32_t crc, const void* data, size_t length)
+{
+	static const UpdateFunction function = selectUpdate();
+	return ~function(~crc, (const unsigned char*)data, length);
+}
+
+// GF(2) W 32x32 x}HVq
+static uint32_t matrixTimes(const uint32_t* matrix, uint32_t vector)
+{
+	uint32_t sum = 0;
+	for (; vector != 0; vector >>= 1, matrix++) {
+		if (vector & 1) {
+			sum ^= *matrix;
+		}
+	}
+	return sum;
+}
+
+static void matrixSquare(uint32_t* square, const uint32_t* matrix)
+{
+	for (int i = 0; i < 32; i++) {
+		square[i] = matrixTimes(matrix, matrix[i]);
+	}
+}
+
+// P zlib  crc32_combine ۦPGHx}pb crc1 ᱵW length2  0 줸ժG
+uint32_t Crc32cCombine(uint32_t crc1, uint32_t crc2, uint64_t length2)
+{
+	if (length2 == 0) {
+		return crc1;
+	}
+
+	// odd ɤW@ 0 줸Bl
+	uint32_t even[32];
+	uint32_t odd[32];
+	odd[0] = CRC32C_POLYNOMIAL;
+	uint32_t row = 1;
+	for (int i = 1; i < 32; i++) {
+		odd[i] = row;
+		row <<= 1;
+	}
+	matrixSquare(even, odd);  // 2  0 줸
+	matrixSquare(odd, even);  // 4  0 줸
+
+	// Ĥ@ᬰ@ 0 줸աAC[
+	do {
+		matrixSquare(even, odd);
+		if (length2 & 1) {
+			crc1 = matrixTimes(even, crc1);
+		}
+		length2 >>= 1;
+		if (length2 == 0) {
+			break;
+		}
+		matrixSquare(odd, even);
+		if (length2 & 1) {
+			crc1 = matrixTimes(odd, crc1);
+		}
+		length2 >>= 1;
+	} while (length2 != 0);
+
+	return crc1 ^ crc2;
+}
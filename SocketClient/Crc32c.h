@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/// <summary>
+/// p CRC32C (Castagnoli)AiqJGĤ@qǤJ 0AǤJW@qG
+/// x86 Bz䴩 SSE4.2  ARMv8 sĶɱҥ CRC OɨϥεwOA_hHdp
+/// </summary>
+uint32_t Crc32cUpdate(uint32_t crc, const void* data, size_t length);
+
+/// <summary>
+/// X֬۾Fq CRC32CAoqe CRC32CAݭnsŪe
+/// </summary>
+/// <param name="length2">ĤGq</param>
+uint32_t Crc32cCombine(uint32_t crc1, uint32_t crc2, uint64_t length2);
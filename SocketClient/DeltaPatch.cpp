@@ -0,0 +1,79 @@
+#include "pch.h"
+#include "DeltaPatch.h"
+#include <cstdint>
+
+// Ū LEB128 ܪơGCӦ줸ժC 7 줸ơA̰줸ܫ᭱٦줸
+static bool readVarint(const unsigned char*& ip, const unsigned char* end, uint64_t& value)
+{
+	value = 0;
+	for (int shift = 0; shift < 64; shift += 7) {
+		if (ip >= end) {
+			return false;
+		}
+		unsigned char byte = *ip++;
+		value |= (uint64_t)(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool ApplyDeltaPatch(const char* patch, size_t patchSize, const char* base, size_t baseSize, size_t targetSize,
+	const std::function<bool(const char*, size_t)>& write, std::string& message)
+{
+	const unsigned char* ip = (const unsigned char*)patch;
+	const unsigned char* end = ip + patchSize;
+	uint64_t written = 0;
+
+	while (ip < end) {
+		unsigned char type = *ip++;
+		uint64_t offset = 0;
+		uint64_t length;
+		if (type == DELTA_COPY && !readVarint(ip, end, offset)) {
+			message = "Truncated delta copy instruction";
+			return false;
+		}
+		if (!readVarint(ip, end, length)) {
+			message = "Truncated delta instruction";
+			return false;
+		}
+		if (length > targetSize - written) {
+			message = "Delta output exceeds the file size";
+			return false;
+		}
+
+		const char* source;
+		if (type == DELTA_COPY) {
+			if (offset > baseSize || length > baseSize - offset) {
+				message = "Delta copy outside of the base file";
+				return false;
+			}
+			source = base + offset;
+		}
+		else if (type == DELTA_ADD) {
+			if (length > (uint64_t)(end - ip)) {
+				message = "Truncated delta data";
+				return false;
+			}
+			source = (const char*)ip;
+			ip += length;
+		}
+		else {
+			message = "Unknown delta instruction: " + std::to_string(type);
+			return false;
+		}
+
+		if (length > 0 && !write(source, (size_t)length)) {
+			message = "Failed to write patched content";
+			return false;
+		}
+		written += length;
+	}
+
+	if (written != targetSize) {
+		message = "Delta output is shorter than the file size";
+		return false;
+	}
+	return true;
+}
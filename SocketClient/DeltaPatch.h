@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+// ׸ɸƪO
+#define DELTA_COPY 0  // ᬰªmP
+#define DELTA_ADD 1   // ᬰ׻Pse
+
+/// <summary>
+/// Ht׸ɸƥª .bin ɮײͷs
+/// ׸ɸƬ@sOACӫOH@Ӧ줸ժ}lAmP׬Ҭ LEB128 ܪơG
+/// DELTA_COPY ƻsª@qADELTA_ADD [J򱵦bפ᪺se
+/// </summary>
+/// <param name="base">ªe</param>
+/// <param name="targetSize">sjpAOX`ץۦP</param>
+/// <param name="write">̧ǱseA^ false ɤ</param>
+/// <returns>׸ɸƮ榡~BWXªdοXפŮɦ^ false ügJ message</returns>
+bool ApplyDeltaPatch(const char* patch, size_t patchSize, const char* base, size_t baseSize, size_t targetSize,
+	const std::function<bool(const char*, size_t)>& write, std::string& message);
@@ -0,0 +1,298 @@
+#include "pch.h"
+#include "Transport.h"
+#include "UringTransport.h"
+#include "Logger.h"
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/time.h>
+#include <netdb.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+
+/// <summary>
+/// POSIX D socket @AH epoll ݥiŪ/igóBzO
+/// </summary>
+class EpollTransport : public Transport
+{
+public:
+	~EpollTransport() override {
+		close();
+	}
+
+	bool connect(const char* address, const char* port) override {
+		struct addrinfo* result = NULL, * ptr = NULL, hints;
+
+		memset(&hints, 0, sizeof(hints));
+		hints.ai_family = AF_UNSPEC;
+		hints.ai_socktype = SOCK_STREAM;
+		hints.ai_protocol = IPPROTO_TCP;
+
+		// ѪRAȾa}Mݤf
+		auto resolveStart = std::chrono::steady_clock::now();
+		int iResult = getaddrinfo(address, port, &hints, &result);
+		auto connectStart = std::chrono::steady_clock::now();
+		timing.resolve = connectStart - resolveStart;
+		timing.connect = std::chrono::nanoseconds(0);
+		if (iResult != 0) {
+			errorCode = iResult;
+			Logger::error("getaddrinfo failed with error: " + std::string(gai_strerror(iResult)));
+			return false;
+		}
+
+		epollFd = epoll_create1(EPOLL_CLOEXEC);
+		if (epollFd < 0) {
+			errorCode = errno;
+			Logger::error("epoll_create1 failed with error: " + std::to_string(errorCode));
+			freeaddrinfo(result);
+			return false;
+		}
+
+		// ճsAȾ
+		for (ptr = result; ptr != NULL; ptr = ptr->ai_next) {
+			socketFd = socket(ptr->ai_family, ptr->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, ptr->ai_protocol);
+			if (socketFd < 0) {
+				errorCode = errno;
+				Logger::error("Socket creation failed with error: " + std::to_string(errorCode));
+				freeaddrinfo(result);
+				close();
+				return false;
+			}
+
+			Logger::debug("Attempting to connect to server...");
+			if (connectNonBlocking(ptr->ai_addr, ptr->ai_addrlen)) {
+				setReceiveTimeout(DEFAULT_IO_TIMEOUT_MS);
+				break;
+			}
+
+			::close(socketFd);
+			socketFd = -1;
+			registeredEvents = 0;
+			Logger::debug("Connection attempt failed, trying next address...");
+		}
+
+		freeaddrinfo(result);
+		timing.connect = std::chrono::steady_clock::now() - connectStart;
+
+		if (socketFd < 0) {
+			close();
+			return false;
+		}
+		return true;
+	}
+
+	int send(const char* data, size_t length) override {
+		size_t totalSent = 0;
+		while (totalSent < length) {
+			ssize_t sent = ::send(socketFd, data + totalSent, length - totalSent, MSG_NOSIGNAL);
+			if (sent >= 0) {
+				totalSent += (size_t)sent;
+				continue;
+			}
+			if (errno == EINTR) {
+				continue;
+			}
+			if (errno != EAGAIN && errno != EWOULDBLOCK) {
+				errorCode = errno;
+				return -1;
+			}
+			if (!waitFor(EPOLLOUT, DEFAULT_IO_TIMEOUT_MS)) {
+				return -1;
+			}
+		}
+		return (int)totalSent;
+	}
+
+	int receive(char* buffer, size_t length) override {
+		while (true) {
+			// ŪAuƩ|Fɤ~iJ epoll 
+			ssize_t received = recv(socketFd, buffer, length, 0);
+			if (received >= 0) {
+				return (int)received;
+			}
+			if (errno == EINTR) {
+				continue;
+			}
+			if (errno != EAGAIN && errno != EWOULDBLOCK) {
+				errorCode = errno;
+				return -1;
+			}
+			if (!waitFor(EPOLLIN, DEFAULT_IO_TIMEOUT_MS)) {
+				return -1;
+			}
+		}
+	}
+
+	size_t receiveAll(char* buffer, size_t length) override {
+		errorCode = 0;
+
+		// ȮɤҦA֤ߪqƶJتOA
+		// Oɥѳsuɳ]w SO_RCVTIMEO 
+		int flags = fcntl(socketFd, F_GETFL);
+		if (flags < 0 || fcntl(socketFd, F_SETFL, flags & ~O_NONBLOCK) != 0) {
+			errorCode = errno;
+			return 0;
+		}
+
+		size_t totalReceived = 0;
+		while (totalReceived < length) {
+			ssize_t received = recv(socketFd, buffer + totalReceived, length - totalReceived, MSG_WAITALL);
+			if (received > 0) {
+				totalReceived += (size_t)received;
+				continue;
+			}
+			if (received < 0 && errno == EINTR) {
+				continue;
+			}
+			if (received < 0) {
+				errorCode = (errno == EAGAIN || errno == EWOULDBLOCK) ? ETIMEDOUT : errno;
+			}
+			break;
+		}
+
+		fcntl(socketFd, F_SETFL, flags);
+		return totalReceived;
+	}
+
+	bool shutdownSend() override {
+		if (shutdown(socketFd, SHUT_WR) != 0) {
+			errorCode = errno;
+			return false;
+		}
+		return true;
+	}
+
+	bool close() override {
+		bool success = true;
+		if (socketFd >= 0) {
+			if (::close(socketFd) != 0) {
+				errorCode = errno;
+				success = false;
+			}
+			socketFd = -1;
+		}
+		if (epollFd >= 0) {
+			::close(epollFd);
+			epollFd = -1;
+		}
+		registeredEvents = 0;
+		return success;
+	}
+
+	bool isConnected() const override {
+		return socketFd >= 0;
+	}
+
+	int lastError() const override {
+		return errorCode;
+	}
+
+private:
+	int socketFd = -1;
+	int epollFd = -1;
+	uint32_t registeredEvents = 0;
+	int errorCode = 0;
+
+	bool connectNonBlocking(const struct sockaddr* addr, socklen_t addrlen) {
+		if (::connect(socketFd, addr, addrlen) == 0) {
+			return true;
+		}
+		if (errno != EINPROGRESS) {
+			errorCode = errno;
+			return false;
+		}
+
+		if (!waitFor(EPOLLOUT, DEFAULT_CONNECT_TIMEOUT_MS)) {
+			return false;
+		}
+
+		int soError = 0;
+		socklen_t soErrorLen = sizeof(soError);
+		if (getsockopt(socketFd, SOL_SOCKET, SO_ERROR, &soError, &soErrorLen) != 0) {
+			errorCode = errno;
+			return false;
+		}
+		if (soError != 0) {
+			errorCode = soError;
+			return false;
+		}
+		return true;
+	}
+
+	// uvTҦ receiveAllADާ@Oɥ epoll Bz
+	void setReceiveTimeout(int timeoutMs) {
+		struct timeval timeout;
+		timeout.tv_sec = timeoutMs / 1000;
+		timeout.tv_usec = (timeoutMs % 1000) * 1000;
+		setsockopt(socketFd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+	}
+
+	//  socket NAub`ƥܮɤ~Is epoll_ctl
+	bool waitFor(uint32_t events, int timeoutMs) {
+		struct epoll_event ev;
+		memset(&ev, 0, sizeof(ev));
+		ev.events = events;
+		ev.data.fd = socketFd;
+
+		if (registeredEvents == 0) {
+			if (epoll_ctl(epollFd, EPOLL_CTL_ADD, socketFd, &ev) != 0) {
+				errorCode = errno;
+				return false;
+			}
+		}
+		else if (registeredEvents != events) {
+			if (epoll_ctl(epollFd, EPOLL_CTL_MOD, socketFd, &ev) != 0) {
+				errorCode = errno;
+				return false;
+			}
+		}
+		registeredEvents = events;
+
+		while (true) {
+			struct epoll_event ready;
+			int count = epoll_wait(epollFd, &ready, 1, timeoutMs);
+			if (count > 0) {
+				// ~α_]NAѫ recv/send/getsockopt oڿ~
+				return true;
+			}
+			if (count == 0) {
+				errorCode = ETIMEDOUT;
+				return false;
+			}
+			if (errno != EINTR) {
+				errorCode = errno;
+				return false;
+			}
+		}
+	}
+};
+
+int TransportStartup()
+{
+	return 0;
+}
+
+int TransportCleanup()
+{
+	return 0;
+}
+
+bool IsTimeoutError(int error)
+{
+	return error == ETIMEDOUT || error == EAGAIN || error == EWOULDBLOCK;
+}
+
+std::unique_ptr<Transport> CreateTransport(TransportBackend backend)
+{
+	if (backend == TRANSPORT_IO_URING) {
+		std::unique_ptr<Transport> transport = CreateUringTransport();
+		if (transport) {
+			return transport;
+		}
+	}
+	return std::make_unique<EpollTransport>();
+}
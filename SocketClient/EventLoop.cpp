@@ -0,0 +1,350 @@
+#include "pch.h"
+#include "EventLoop.h"
+#include "Logger.h"
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <exception>
+#include <string>
+#include <thread>
+
+#define MAX_EPOLL_EVENTS 64
+// u@IƶqAWLɱƶ
+#define BLOCKING_THREADS 2
+
+IoAwaiter::IoAwaiter(EventLoop& loop, int fd, uint32_t events, std::chrono::milliseconds timeout)
+	: loop(loop), fd(fd), events(events), deadline(std::chrono::steady_clock::now() + timeout)
+{
+}
+
+IoAwaiter::~IoAwaiter()
+{
+	if (waiting) {
+		loop.removeWaiter(*this);
+	}
+}
+
+bool IoAwaiter::await_suspend(std::coroutine_handle<> awaiting)
+{
+	handle = awaiting;
+	// LkʬݮɤȰAG false
+	return loop.addWaiter(*this);
+}
+
+// spawn u@GߧY}lAbjW槹ۦ
+struct EventLoop::DetachedTask
+{
+	struct promise_type
+	{
+		DetachedTask get_return_object() noexcept {
+			return {};
+		}
+
+		std::suspend_never initial_suspend() const noexcept {
+			return {};
+		}
+
+		std::suspend_never final_suspend() const noexcept {
+			return {};
+		}
+
+		void return_void() const noexcept {
+		}
+
+		void unhandled_exception() const noexcept {
+			std::terminate();
+		}
+	};
+};
+
+EventLoop::EventLoop()
+	: activeTasks(0), stopRequested(false)
+{
+	epollFd = epoll_create1(EPOLL_CLOEXEC);
+	if (epollFd < 0) {
+		Logger::error("epoll_create1 failed with error: " + std::to_string(errno));
+		return;
+	}
+
+	// L post ɳ epoll_wait
+	wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (wakeFd < 0) {
+		Logger::error("eventfd failed with error: " + std::to_string(errno));
+		return;
+	}
+	struct epoll_event ev;
+	memset(&ev, 0, sizeof(ev));
+	ev.events = EPOLLIN;
+	ev.data.fd = wakeFd;
+	if (epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &ev) != 0) {
+		Logger::error("epoll_ctl failed with error: " + std::to_string(errno));
+	}
+}
+
+EventLoop::~EventLoop()
+{
+	// Iu@iऴ| post oӰjAݱƶP椤u@~I
+	{
+		std::unique_lock<std::mutex> lock(blockingMutex);
+		blockingDone.wait(lock, [this] {
+			return blockingCount == 0;
+		});
+		blockingStopping = true;
+	}
+	blockingReady.notify_all();
+	for (auto& thread : blockingThreads) {
+		thread.join();
+	}
+	if (wakeFd >= 0) {
+		::close(wakeFd);
+	}
+	if (epollFd >= 0) {
+		::close(epollFd);
+	}
+}
+
+EventLoop::DetachedTask EventLoop::runDetached(EventLoop& loop, Task<void> task)
+{
+	co_await loop.schedule();
+	try {
+		co_await std::move(task);
+	}
+	catch (const std::exception& e) {
+		Logger::error("Unhandled exception in coroutine: " + std::string(e.what()));
+	}
+	catch (...) {
+		Logger::error("Unhandled non-standard exception in coroutine");
+	}
+	loop.taskFinished();
+}
+
+void EventLoop::spawn(Task<void> task)
+{
+	activeTasks++;
+	runDetached(*this, std::move(task));
+}
+
+void EventLoop::taskFinished()
+{
+	activeTasks--;
+}
+
+void EventLoop::run()
+{
+	while (!stopRequested && activeTasks > 0) {
+		runPosted();
+		if (stopRequested || activeTasks == 0) {
+			break;
+		}
+
+		struct epoll_event events[MAX_EPOLL_EVENTS];
+		int count = epoll_wait(epollFd, events, MAX_EPOLL_EVENTS, nextTimeoutMs());
+		if (count < 0 && errno != EINTR) {
+			Logger::error("epoll_wait failed with error: " + std::to_string(errno));
+			break;
+		}
+		for (int i = 0; i < count; i++) {
+			if (events[i].data.fd == wakeFd) {
+				uint64_t value;
+				while (read(wakeFd, &value, sizeof(value)) > 0) {
+				}
+				continue;
+			}
+			dispatch(events[i].data.fd, events[i].events);
+		}
+		expireTimers();
+		resumeReady();
+	}
+	stopRequested = false;
+}
+
+void EventLoop::stop()
+{
+	stopRequested = true;
+	uint64_t value = 1;
+	if (write(wakeFd, &value, sizeof(value)) < 0) {
+		Logger::error("Failed to wake event loop: " + std::to_string(errno));
+	}
+}
+
+void EventLoop::post(std::coroutine_handle<> handle)
+{
+	{
+		std::lock_guard<std::mutex> lock(postMutex);
+		posted.push_back(handle);
+	}
+	uint64_t value = 1;
+	if (write(wakeFd, &value, sizeof(value)) < 0) {
+		Logger::error("Failed to wake event loop: " + std::to_string(errno));
+	}
+}
+
+void EventLoop::runBlocking(std::function<void()> work)
+{
+	{
+		std::lock_guard<std::mutex> lock(blockingMutex);
+		blockingQueue.push_back(std::move(work));
+		blockingCount++;
+		// u@ƶq֩Wɤ~W[
+		if (blockingThreads.size() < BLOCKING_THREADS && blockingThreads.size() < blockingCount) {
+			blockingThreads.emplace_back(&EventLoop::runBlockingWorker, this);
+		}
+	}
+	blockingReady.notify_one();
+}
+
+void EventLoop::runBlockingWorker()
+{
+	std::unique_lock<std::mutex> lock(blockingMutex);
+	while (true) {
+		blockingReady.wait(lock, [this] {
+			return blockingStopping || !blockingQueue.empty();
+		});
+		if (blockingQueue.empty()) {
+			return;
+		}
+		std::function<void()> work = std::move(blockingQueue.front());
+		blockingQueue.pop_front();
+		lock.unlock();
+		work();
+		work = nullptr;
+		lock.lock();
+		blockingCount--;
+		if (blockingCount == 0) {
+			blockingDone.notify_all();
+		}
+	}
+}
+
+void EventLoop::runPosted()
+{
+	std::vector<std::coroutine_handle<>> handles;
+	{
+		std::lock_guard<std::mutex> lock(postMutex);
+		handles.swap(posted);
+	}
+	for (auto handle : handles) {
+		handle.resume();
+	}
+}
+
+void EventLoop::forget(int fd)
+{
+	//  socket ɮ֤ߦ۰ʲX epoll
+	watches.erase(fd);
+}
+
+bool EventLoop::addWaiter(IoAwaiter& awaiter)
+{
+	Watch& watch = watches[awaiter.fd];
+	IoAwaiter*& slot = awaiter.events == EPOLLIN ? watch.reader : watch.writer;
+	if (slot) {
+		Logger::error("Socket " + std::to_string(awaiter.fd) + " already has a pending wait");
+		return false;
+	}
+
+	slot = &awaiter;
+	if (!arm(awaiter.fd, watch)) {
+		slot = nullptr;
+		return false;
+	}
+	awaiter.timer = timers.emplace(awaiter.deadline, &awaiter);
+	awaiter.waiting = true;
+	return true;
+}
+
+void EventLoop::removeWaiter(IoAwaiter& awaiter)
+{
+	auto it = watches.find(awaiter.fd);
+	if (it != watches.end()) {
+		if (it->second.reader == &awaiter) {
+			it->second.reader = nullptr;
+		}
+		if (it->second.writer == &awaiter) {
+			it->second.writer = nullptr;
+		}
+	}
+	timers.erase(awaiter.timer);
+	awaiter.waiting = false;
+}
+
+void EventLoop::complete(IoAwaiter& awaiter, bool ready)
+{
+	removeWaiter(awaiter);
+	awaiter.ready = ready;
+	readyList.push_back(awaiter.handle);
+}
+
+// H EPOLLONESHOT ʬݥثeݪVAƥoͫ۰ʰΡACݥuݤ@ epoll_ctl
+bool EventLoop::arm(int fd, Watch& watch)
+{
+	struct epoll_event ev;
+	memset(&ev, 0, sizeof(ev));
+	ev.events = (uint32_t)EPOLLONESHOT | (watch.reader ? (uint32_t)EPOLLIN : 0u) | (watch.writer ? (uint32_t)EPOLLOUT : 0u);
+	ev.data.fd = fd;
+	if (epoll_ctl(epollFd, watch.added ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &ev) != 0) {
+		Logger::error("epoll_ctl failed with error: " + std::to_string(errno));
+		return false;
+	}
+	watch.added = true;
+	return true;
+}
+
+void EventLoop::dispatch(int fd, uint32_t events)
+{
+	auto it = watches.find(fd);
+	if (it == watches.end()) {
+		return;
+	}
+	Watch& watch = it->second;
+
+	// ~α_]NAѫ recv/send oڿ~
+	bool failed = (events & (EPOLLERR | EPOLLHUP)) != 0;
+	if (watch.reader && ((events & EPOLLIN) || failed)) {
+		complete(*watch.reader, true);
+	}
+	if (watch.writer && ((events & EPOLLOUT) || failed)) {
+		complete(*watch.writer, true);
+	}
+
+	// t@ӤVbݡAsҥκʬ
+	if ((watch.reader || watch.writer) && !arm(fd, watch)) {
+		if (watch.reader) {
+			complete(*watch.reader, false);
+		}
+		if (watch.writer) {
+			complete(*watch.writer, false);
+		}
+	}
+}
+
+void EventLoop::expireTimers()
+{
+	auto now = std::chrono::steady_clock::now();
+	while (!timers.empty() && timers.begin()->first <= now) {
+		complete(*timers.begin()->second, false);
+	}
+}
+
+int EventLoop::nextTimeoutMs() const
+{
+	if (timers.empty()) {
+		return -1;
+	}
+	auto remaining = timers.begin()->first - std::chrono::steady_clock::now();
+	if (remaining <= std::chrono::nanoseconds(0)) {
+		return 0;
+	}
+	// LiAקKbeӫ
+	return (int)std::chrono::ceil<std::chrono::milliseconds>(remaining).count();
+}
+
+void EventLoop::resumeReady()
+{
+	std::vector<std::coroutine_handle<>> handles;
+	handles.swap(readyList);
+	for (auto handle : handles) {
+		handle.resume();
+	}
+}
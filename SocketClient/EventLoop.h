@@ -0,0 +1,176 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <sys/epoll.h>
+#include "SocketClient.h"
+#include "Task.h"
+
+class EventLoop;
+
+/// <summary>
+///  socket iŪΥigAco_await G false ܹOɩεLkʬ
+/// </summary>
+class IoAwaiter
+{
+public:
+	IoAwaiter(EventLoop& loop, int fd, uint32_t events, std::chrono::milliseconds timeout);
+	// {bݤQPɨʬ
+	~IoAwaiter();
+
+	IoAwaiter(const IoAwaiter&) = delete;
+	IoAwaiter& operator=(const IoAwaiter&) = delete;
+
+	bool await_ready() const noexcept {
+		return false;
+	}
+
+	bool await_suspend(std::coroutine_handle<> awaiting);
+
+	bool await_resume() const noexcept {
+		return ready;
+	}
+
+private:
+	friend class EventLoop;
+
+	EventLoop& loop;
+	int fd;
+	uint32_t events;
+	std::chrono::steady_clock::time_point deadline;
+	std::multimap<std::chrono::steady_clock::time_point, IoAwaiter*>::iterator timer;
+	std::coroutine_handle<> handle;
+	bool waiting = false;
+	bool ready = false;
+};
+
+/// <summary>
+/// ƥj (epoll)Gsocket NιOɮɦbj骺W_ݪ{
+/// @ӰjiPXʤjqsuFݭnh CPU ɦbhӰUإߤ@Ӱj
+///  spawn / post / stop ~禡ubj骺WIs
+/// </summary>
+class SOCKETCLIENT_API EventLoop
+{
+public:
+	EventLoop();
+	~EventLoop();
+
+	EventLoop(const EventLoop&) = delete;
+	EventLoop& operator=(const EventLoop&) = delete;
+
+	/// <summary>
+	/// bjWҰʤu@AݵGFu@Bzҥ~uObx
+	/// </summary>
+	void spawn(Task<void> task);
+
+	/// <summary>
+	/// bثeWjA stop() ΩҦH spawn Ұʪu@
+	/// </summary>
+	void run();
+
+	/// <summary>
+	///  run() bBzثeƥ^
+	/// </summary>
+	void stop();
+
+	/// <summary>
+	/// bj骺W_{
+	/// </summary>
+	void post(std::coroutine_handle<> handle);
+
+	/// <summary>
+	/// bj֦IW몺u@ (Ҧp getaddrinfo)Au@iH post _{
+	/// IƶqTwAĤ@IsɫإߡFjѺcɵݩҦu@
+	/// </summary>
+	void runBlocking(std::function<void()> work);
+
+	/// <summary>
+	/// XvAbj骺U@_
+	/// </summary>
+	auto schedule() {
+		struct Awaiter
+		{
+			EventLoop& loop;
+
+			bool await_ready() const noexcept {
+				return false;
+			}
+
+			void await_suspend(std::coroutine_handle<> awaiting) {
+				loop.post(awaiting);
+			}
+
+			void await_resume() const noexcept {
+			}
+		};
+		return Awaiter{ *this };
+	}
+
+	IoAwaiter waitReadable(int fd, std::chrono::milliseconds timeout) {
+		return IoAwaiter(*this, fd, EPOLLIN, timeout);
+	}
+
+	IoAwaiter waitWritable(int fd, std::chrono::milliseconds timeout) {
+		return IoAwaiter(*this, fd, EPOLLOUT, timeout);
+	}
+
+	/// <summary>
+	///  socket eIsAʬݡFi{bݦ socket
+	/// </summary>
+	void forget(int fd);
+
+private:
+	friend class IoAwaiter;
+
+	struct DetachedTask;
+
+	struct Watch
+	{
+		IoAwaiter* reader = nullptr;
+		IoAwaiter* writer = nullptr;
+		bool added = false;
+	};
+
+	int epollFd = -1;
+	int wakeFd = -1;
+	std::unordered_map<int, Watch> watches;
+	std::multimap<std::chrono::steady_clock::time_point, IoAwaiter*> timers;
+	std::vector<std::coroutine_handle<>> readyList;
+
+	std::mutex postMutex;
+	std::vector<std::coroutine_handle<>> posted;
+	std::atomic<size_t> activeTasks;
+	std::atomic<bool> stopRequested;
+
+	std::mutex blockingMutex;
+	std::condition_variable blockingReady;
+	std::condition_variable blockingDone;
+	std::deque<std::function<void()>> blockingQueue;
+	std::vector<std::thread> blockingThreads;
+	size_t blockingCount = 0;
+	bool blockingStopping = false;
+
+	bool addWaiter(IoAwaiter& awaiter);
+	void removeWaiter(IoAwaiter& awaiter);
+	void complete(IoAwaiter& awaiter, bool ready);
+	bool arm(int fd, Watch& watch);
+	void dispatch(int fd, uint32_t events);
+	void expireTimers();
+	int nextTimeoutMs() const;
+	void resumeReady();
+	void runPosted();
+	void taskFinished();
+	void runBlockingWorker();
+
+	static DetachedTask runDetached(EventLoop& loop, Task<void> task);
+};
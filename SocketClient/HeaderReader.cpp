@@ -0,0 +1,465 @@
+#include "pch.h"
+#include "HeaderReader.h"
+#include <string.h>
+#include <algorithm>
+#include <climits>
+
+#define MAX_HEADER_DEPTH 64 // _P}C̤jh
+
+static int hexValue(char c)
+{
+	if (c >= '0' && c <= '9') {
+		return c - '0';
+	}
+	if (c >= 'a' && c <= 'f') {
+		return c - 'a' + 10;
+	}
+	if (c >= 'A' && c <= 'F') {
+		return c - 'A' + 10;
+	}
+	return -1;
+}
+
+static uint32_t readHex4(const char* p)
+{
+	return (uint32_t)((hexValue(p[0]) << 12) | (hexValue(p[1]) << 8) | (hexValue(p[2]) << 4) | hexValue(p[3]));
+}
+
+// p }l \uXXXX
+static bool isUnicodeEscape(const char* p, const char* end)
+{
+	return end - p >= 6 && p[0] == '\\' && p[1] == 'u' &&
+		hexValue(p[2]) >= 0 && hexValue(p[3]) >= 0 && hexValue(p[4]) >= 0 && hexValue(p[5]) >= 0;
+}
+
+// Ѷ}rA̧ǧCӦ줸ե浹 outputFreadString wT{ǦC榡
+template <typename Output>
+static void decodeString(std::string_view raw, Output output)
+{
+	const char* p = raw.data();
+	const char* end = p + raw.size();
+	while (p < end) {
+		char c = *p++;
+		if (c != '\\') {
+			output(c);
+			continue;
+		}
+		c = *p++;
+		switch (c) {
+		case 'b': output('\b'); break;
+		case 'f': output('\f'); break;
+		case 'n': output('\n'); break;
+		case 'r': output('\r'); break;
+		case 't': output('\t'); break;
+		case 'u': {
+			uint32_t code = readHex4(p);
+			p += 4;
+			// UTF-16 Nzզ@Ӧr
+			if (code >= 0xD800 && code <= 0xDBFF) {
+				code = 0x10000 + ((code - 0xD800) << 10) + (readHex4(p + 2) - 0xDC00);
+				p += 6;
+			}
+			// H UTF-8 X
+			if (code < 0x80) {
+				output((char)code);
+			}
+			else if (code < 0x800) {
+				output((char)(0xC0 | (code >> 6)));
+				output((char)(0x80 | (code & 0x3F)));
+			}
+			else if (code < 0x10000) {
+				output((char)(0xE0 | (code >> 12)));
+				output((char)(0x80 | ((code >> 6) & 0x3F)));
+				output((char)(0x80 | (code & 0x3F)));
+			}
+			else {
+				output((char)(0xF0 | (code >> 18)));
+				output((char)(0x80 | ((code >> 12) & 0x3F)));
+				output((char)(0x80 | ((code >> 6) & 0x3F)));
+				output((char)(0x80 | (code & 0x3F)));
+			}
+			break;
+		}
+		default:
+			// '"'B'\\'B'/'
+			output(c);
+			break;
+		}
+	}
+}
+
+bool HeaderString::equals(std::string_view text) const
+{
+	if (!escaped) {
+		return raw == text;
+	}
+	size_t length = 0;
+	bool equal = true;
+	decodeString(raw, [&](char c) {
+		equal = equal && length < text.size() && text[length] == c;
+		length++;
+	});
+	return equal && length == text.size();
+}
+
+void HeaderString::copyTo(std::string& value) const
+{
+	if (!escaped) {
+		value.assign(raw.data(), raw.size());
+		return;
+	}
+	value.clear();
+	decodeString(raw, [&](char c) {
+		value.push_back(c);
+	});
+}
+
+void HeaderString::copyTo(char* destination, size_t size) const
+{
+	size_t length = 0;
+	if (!escaped) {
+		length = std::min(raw.size(), size - 1);
+		memcpy(destination, raw.data(), length);
+	}
+	else {
+		decodeString(raw, [&](char c) {
+			if (length < size - 1) {
+				destination[length++] = c;
+			}
+		});
+	}
+	destination[length] = '\0';
+}
+
+HeaderReader::HeaderReader(std::string_view text)
+	: begin(text.data()), position(text.data()), end(text.data() + text.size())
+{
+}
+
+void HeaderReader::skipWhitespace()
+{
+	while (position < end && (*position == ' ' || *position == '\t' || *position == '\n' || *position == '\r')) {
+		position++;
+	}
+}
+
+bool HeaderReader::fail(const char* reason)
+{
+	if (!errorText) {
+		errorText = reason;
+		errorOffset = (size_t)(position - begin);
+	}
+	return false;
+}
+
+std::string HeaderReader::error() const
+{
+	return std::string(errorText ? errorText : "No error") + " at offset " + std::to_string(errorOffset);
+}
+
+bool HeaderReader::expect(char c, const char* reason)
+{
+	if (failed()) {
+		return false;
+	}
+	skipWhitespace();
+	if (position >= end || *position != c) {
+		return fail(reason);
+	}
+	position++;
+	return true;
+}
+
+bool HeaderReader::beginObject()
+{
+	if (!expect('{', "Expected an object")) {
+		return false;
+	}
+	if (++depth > MAX_HEADER_DEPTH) {
+		return fail("Nesting too deep");
+	}
+	first = true;
+	return true;
+}
+
+bool HeaderReader::nextMember(HeaderString& key)
+{
+	if (failed()) {
+		return false;
+	}
+	skipWhitespace();
+	if (position < end && *position == '}') {
+		position++;
+		depth--;
+		first = false;
+		return false;
+	}
+	if (!first && !expect(',', "Expected ',' or '}'")) {
+		return false;
+	}
+	first = false;
+	return readString(key) && expect(':', "Expected ':'");
+}
+
+bool HeaderReader::beginArray()
+{
+	if (!expect('[', "Expected an array")) {
+		return false;
+	}
+	if (++depth > MAX_HEADER_DEPTH) {
+		return fail("Nesting too deep");
+	}
+	first = true;
+	return true;
+}
+
+bool HeaderReader::nextElement()
+{
+	if (failed()) {
+		return false;
+	}
+	skipWhitespace();
+	if (position < end && *position == ']') {
+		position++;
+		depth--;
+		first = false;
+		return false;
+	}
+	if (!first && !expect(',', "Expected ',' or ']'")) {
+		return false;
+	}
+	first = false;
+	return true;
+}
+
+bool HeaderReader::readString(HeaderString& value)
+{
+	if (!expect('"', "Expected a string")) {
+		return false;
+	}
+	const char* start = position;
+	value.escaped = false;
+	while (position < end) {
+		unsigned char c = (unsigned char)*position;
+		if (c == '"') {
+			value.raw = std::string_view(start, (size_t)(position - start));
+			position++;
+			return true;
+		}
+		if (c < 0x20) {
+			return fail("Control character in string");
+		}
+		if (c == '\\') {
+			value.escaped = true;
+			if (end - position < 2) {
+				break;
+			}
+			char escape = position[1];
+			if (escape == 'u') {
+				if (!isUnicodeEscape(position, end)) {
+					return fail("Invalid \\u escape");
+				}
+				// Nz沈X{
+				uint32_t code = readHex4(position + 2);
+				if (code >= 0xD800 && code <= 0xDBFF) {
+					if (!isUnicodeEscape(position + 6, end) || readHex4(position + 8) < 0xDC00 || readHex4(position + 8) > 0xDFFF) {
+						return fail("Unpaired surrogate in \\u escape");
+					}
+					position += 6;
+				}
+				else if (code >= 0xDC00 && code <= 0xDFFF) {
+					return fail("Unpaired surrogate in \\u escape");
+				}
+				position += 6;
+				continue;
+			}
+			if (!strchr("\"\\/bfnrt", escape) || escape == '\0') {
+				return fail("Invalid escape");
+			}
+			position += 2;
+			continue;
+		}
+		position++;
+	}
+	return fail("Unterminated string");
+}
+
+// T{ JSON Ʀr榡òAintegral ܨSpƻPƳ
+bool HeaderReader::scanNumber(bool& integral)
+{
+	const char* p = position;
+	if (p < end && *p == '-') {
+		p++;
+	}
+	if (p >= end || *p < '0' || *p > '9') {
+		return fail("Expected a number");
+	}
+	if (*p == '0') {
+		p++;
+	}
+	else {
+		while (p < end && *p >= '0' && *p <= '9') {
+			p++;
+		}
+	}
+	integral = true;
+	if (p < end && *p == '.') {
+		integral = false;
+		p++;
+		if (p >= end || *p < '0' || *p > '9') {
+			return fail("Invalid number");
+		}
+		while (p < end && *p >= '0' && *p <= '9') {
+			p++;
+		}
+	}
+	if (p < end && (*p == 'e' || *p == 'E')) {
+		integral = false;
+		p++;
+		if (p < end && (*p == '+' || *p == '-')) {
+			p++;
+		}
+		if (p >= end || *p < '0' || *p > '9') {
+			return fail("Invalid number");
+		}
+		while (p < end && *p >= '0' && *p <= '9') {
+			p++;
+		}
+	}
+	position = p;
+	return true;
+}
+
+bool HeaderReader::readUnsigned(uint64_t& value)
+{
+	if (failed()) {
+		return false;
+	}
+	skipWhitespace();
+	const char* start = position;
+	bool integral;
+	if (!scanNumber(integral)) {
+		return false;
+	}
+	if (!integral || *start == '-') {
+		position = start;
+		return fail("Expected an unsigned integer");
+	}
+	uint64_t result = 0;
+	for (const char* p = start; p < position; p++) {
+		uint64_t digit = (uint64_t)(*p - '0');
+		if (result > (UINT64_MAX - digit) / 10) {
+			position = start;
+			return fail("Integer out of range");
+		}
+		result = result * 10 + digit;
+	}
+	value = result;
+	return true;
+}
+
+bool HeaderReader::readInteger(int& value)
+{
+	if (failed()) {
+		return false;
+	}
+	skipWhitespace();
+	const char* start = position;
+	bool integral;
+	if (!scanNumber(integral)) {
+		return false;
+	}
+	if (!integral) {
+		position = start;
+		return fail("Expected an integer");
+	}
+	bool negative = *start == '-';
+	int64_t result = 0;
+	for (const char* p = negative ? start + 1 : start; p < position; p++) {
+		result = result * 10 + (*p - '0');
+		if (result > (int64_t)INT_MAX + 1) {
+			position = start;
+			return fail("Integer out of range");
+		}
+	}
+	if (negative) {
+		result = -result;
+	}
+	if (result > INT_MAX) {
+		position = start;
+		return fail("Integer out of range");
+	}
+	value = (int)result;
+	return true;
+}
+
+bool HeaderReader::skipLiteral(const char* literal)
+{
+	size_t length = strlen(literal);
+	if ((size_t)(end - position) < length || memcmp(position, literal, length) != 0) {
+		return fail("Unexpected character");
+	}
+	position += length;
+	return true;
+}
+
+bool HeaderReader::skipValue()
+{
+	if (failed()) {
+		return false;
+	}
+	skipWhitespace();
+	if (position >= end) {
+		return fail("Unexpected end of header");
+	}
+	switch (*position) {
+	case '{': {
+		if (!beginObject()) {
+			return false;
+		}
+		HeaderString key;
+		while (nextMember(key)) {
+			if (!skipValue()) {
+				return false;
+			}
+		}
+		return !failed();
+	}
+	case '[':
+		if (!beginArray()) {
+			return false;
+		}
+		while (nextElement()) {
+			if (!skipValue()) {
+				return false;
+			}
+		}
+		return !failed();
+	case '"': {
+		HeaderString value;
+		return readString(value);
+	}
+	case 't':
+		return skipLiteral("true");
+	case 'f':
+		return skipLiteral("false");
+	case 'n':
+		return skipLiteral("null");
+	default: {
+		bool integral;
+		return scanNumber(integral);
+	}
+	}
+}
+
+bool HeaderReader::finish()
+{
+	if (failed()) {
+		return false;
+	}
+	skipWhitespace();
+	if (position != end) {
+		return fail("Unexpected data after header");
+	}
+	return true;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/// <summary>
+/// Y JSON rAVlr޸Aݭnɤ~Ѷ}r
+/// </summary>
+struct HeaderString
+{
+	std::string_view raw;
+	bool escaped = false;
+
+	/// <summary>
+	/// Ѷ}rO_ text
+	/// </summary>
+	bool equals(std::string_view text) const;
+
+	/// <summary>
+	/// Ѷ}rgJ valueAƨϥ value 즳Ŷ
+	/// </summary>
+	void copyTo(std::string& value) const;
+
+	/// <summary>
+	/// Ѷ}rgJTwתALɺI_A '\0'
+	/// </summary>
+	void copyTo(char* destination, size_t size) const;
+
+	template <size_t N>
+	void copyTo(char (&destination)[N]) const {
+		copyTo(destination, N);
+	}
+};
+
+/// <summary>
+/// ^Y JSON ѪRĢǨXAѩIsݨW٪ŪتcA
+/// إ DOMArꤣƻs줤F{oH skipValue L
+/// 榡~᪺ŪѡA] error o
+/// </summary>
+class HeaderReader
+{
+public:
+	explicit HeaderReader(std::string_view text);
+
+	/// <summary>
+	/// Ū '{'AH nextMember X
+	/// </summary>
+	bool beginObject();
+
+	/// <summary>
+	/// ŪU@WٻP ':'AᥲŪβL
+	/// </summary>
+	/// <returns>󵲧ή榡~ɦ^ falseAH failed Ϥ</returns>
+	bool nextMember(HeaderString& key);
+
+	/// <summary>
+	/// Ū '['AH nextElement X
+	/// </summary>
+	bool beginArray();
+
+	/// <summary>
+	/// U@ӤAᥲŪβL
+	/// </summary>
+	/// <returns>}Cή榡~ɦ^ falseAH failed Ϥ</returns>
+	bool nextElement();
+
+	bool readString(HeaderString& value);
+	bool readUnsigned(uint64_t& value);
+	bool readInteger(int& value);
+	bool skipValue();
+
+	/// <summary>
+	/// T{̥~hȤuѪť
+	/// </summary>
+	bool finish();
+
+	bool failed() const {
+		return errorText != nullptr;
+	}
+
+	/// <summary>
+	/// 榡~yzA]tm
+	/// </summary>
+	std::string error() const;
+
+	/// <summary>
+	/// ]w榡~AѩIsݦ^쫬OŵD
+	/// </summary>
+	bool fail(const char* reason);
+
+private:
+	const char* begin;
+	const char* position;
+	const char* end;
+	const char* errorText = nullptr;
+	size_t errorOffset = 0;
+	// iJΰ}CAU@Τeݭn ','
+	bool first = false;
+	int depth = 0;
+
+	void skipWhitespace();
+	bool expect(char c, const char* reason);
+	bool scanNumber(bool& integral);
+	bool skipLiteral(const char* literal);
+};
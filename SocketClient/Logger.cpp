@@ -0,0 +1,365 @@
+#include "pch.h"
+#include "Logger.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <cstdio>
+#include <fstream>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#define LOG_BATCH_SIZE 64 * 1024 // 64KB
+
+// oaɶAWindows P POSIX wѼƶǤP
+static void toLocalTime(std::time_t time, struct tm& timeinfo)
+{
+#ifdef _WIN32
+	localtime_s(&timeinfo, &time);
+#else
+	localtime_r(&time, &timeinfo);
+#endif
+}
+
+// X찣μзǿ~
+static void writeDebugOutput(const std::string& message)
+{
+#ifdef _WIN32
+	OutputDebugStringA(message.c_str());
+#else
+	std::fputs(message.c_str(), stderr);
+#endif
+}
+
+static std::string formatTime(std::time_t time, const char* format)
+{
+	struct tm timeinfo;
+	toLocalTime(time, timeinfo);
+
+	char buffer[32];
+	size_t length = std::strftime(buffer, sizeof(buffer), format, &timeinfo);
+	return std::string(buffer, length);
+}
+
+/// <summary>
+/// hͲ̡B@O̪wİ (HCǸPBAϥ)
+/// </summary>
+class LogQueue
+{
+public:
+	explicit LogQueue(size_t capacity)
+		: slots(new Slot[capacity]), mask(capacity - 1)
+	{
+		for (size_t i = 0; i < capacity; i++) {
+			slots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	/// <summary>
+	/// J@OAwİϤwɦ^ false
+	/// </summary>
+	bool push(std::string&& record) {
+		size_t position = enqueuePosition.load(std::memory_order_relaxed);
+		while (true) {
+			Slot& slot = slots[position & mask];
+			size_t sequence = slot.sequence.load(std::memory_order_acquire);
+			intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+			if (difference == 0) {
+				if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+					slot.record = std::move(record);
+					slot.sequence.store(position + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (difference < 0) {
+				return false;
+			}
+			else {
+				position = enqueuePosition.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	/// <summary>
+	/// X@OAuѳ@O̩Is
+	/// </summary>
+	bool pop(std::string& record) {
+		Slot& slot = slots[dequeuePosition & mask];
+		size_t sequence = slot.sequence.load(std::memory_order_acquire);
+		if (sequence != dequeuePosition + 1) {
+			return false;
+		}
+		record = std::move(slot.record);
+		slot.sequence.store(dequeuePosition + mask + 1, std::memory_order_release);
+		dequeuePosition++;
+		return true;
+	}
+
+private:
+	struct Slot
+	{
+		std::atomic<size_t> sequence;
+		std::string record;
+	};
+
+	std::unique_ptr<Slot[]> slots;
+	size_t mask;
+	alignas(64) std::atomic<size_t> enqueuePosition{ 0 };
+	alignas(64) size_t dequeuePosition = 0;
+};
+
+/// <summary>
+/// IgɰA֦ߤ@}ҪO
+/// bĤ@OɱҰʡAshutdown ᪺U@OAsҰ
+/// </summary>
+class LogWriter
+{
+public:
+	LogWriter()
+		: queue(LOG_QUEUE_CAPACITY)
+	{
+	}
+
+	~LogWriter() {
+		shutdown();
+	}
+
+	static LogWriter& instance() {
+#ifdef _WIN32
+		// DLL ɫ loader lockALkbѺcɵݰA]ѺcF
+		//  CloseConnection / DestroyClient Is Logger::shutdown 
+		static LogWriter* writer = new LogWriter();
+		return *writer;
+#else
+		static LogWriter writer;
+		return writer;
+#endif
+	}
+
+	void push(std::string&& record) {
+		if (!queue.push(std::move(record))) {
+			dropped.fetch_add(1, std::memory_order_relaxed);
+		}
+		if (!running.load(std::memory_order_acquire)) {
+			start();
+			return;
+		}
+		if (sleeping.load(std::memory_order_relaxed)) {
+			wakeup.notify_one();
+		}
+	}
+
+	void flush() {
+		std::lock_guard<std::mutex> lock(writeMutex);
+		drain();
+	}
+
+	// ügJѾlO
+	void shutdown() {
+		std::lock_guard<std::mutex> workerLock(workerMutex);
+		if (!worker.joinable()) {
+			return;
+		}
+		stopping.store(true);
+		{
+			std::lock_guard<std::mutex> lock(wakeupMutex);
+			wakeup.notify_one();
+		}
+		worker.join();
+		stopping.store(false);
+		running.store(false, std::memory_order_release);
+
+		std::lock_guard<std::mutex> lock(writeMutex);
+		drain();
+	}
+
+private:
+	LogQueue queue;
+	std::atomic<size_t> dropped{ 0 };
+	std::atomic<bool> running{ false };
+	std::atomic<bool> stopping{ false };
+	std::atomic<bool> sleeping{ false };
+	std::mutex workerMutex;
+	std::mutex writeMutex;
+	std::mutex wakeupMutex;
+	std::condition_variable wakeup;
+
+	// HUub writeMutex ɦs
+	std::ofstream logFile;
+	std::string currentDate;
+	std::string logPath;
+	size_t fileSize = 0;
+	std::string batch;
+
+	// ub workerMutex ɦs
+	std::thread worker;
+
+	void start() {
+		std::lock_guard<std::mutex> lock(workerMutex);
+		if (running.load(std::memory_order_relaxed)) {
+			return;
+		}
+		worker = std::thread(&LogWriter::run, this);
+		running.store(true, std::memory_order_release);
+	}
+
+	void run() {
+		while (!stopping.load()) {
+			bool wrote;
+			{
+				std::lock_guard<std::mutex> lock(writeMutex);
+				wrote = drain();
+			}
+			if (wrote) {
+				continue;
+			}
+
+			// SsOɥvAͲ̵o{ sleeping ɤ~AOɽTO||
+			std::unique_lock<std::mutex> lock(wakeupMutex);
+			if (stopping.load()) {
+				break;
+			}
+			sleeping.store(true);
+			wakeup.wait_for(lock, std::chrono::milliseconds(LOG_FLUSH_INTERVAL_MS));
+			sleeping.store(false);
+		}
+	}
+
+	// XҦOç妸gJA^ǬO_gJ
+	bool drain() {
+		std::string record;
+		bool wrote = false;
+
+		size_t droppedCount = dropped.exchange(0, std::memory_order_relaxed);
+		if (droppedCount > 0) {
+			batch += "[" + Logger::getTimestamp() + "][ERROR] " + std::to_string(droppedCount) +
+				" log records dropped, queue full\n";
+		}
+
+		while (queue.pop(record)) {
+			batch += record;
+			if (batch.size() >= LOG_BATCH_SIZE) {
+				write();
+				wrote = true;
+			}
+		}
+		if (!batch.empty()) {
+			write();
+			wrote = true;
+		}
+		if (wrote && logFile.is_open()) {
+			logFile.flush();
+		}
+		return wrote;
+	}
+
+	void write() {
+		try {
+			openLogFile();
+			if (logFile.is_open()) {
+				logFile.write(batch.data(), batch.size());
+				fileSize += batch.size();
+			}
+		}
+		catch (const std::exception& e) {
+			// pGoͥ~AiHҼ{Xtο~ΨLƥΦm
+			writeDebugOutput("Logger Error: " + std::string(e.what()) + "\n");
+		}
+		batch.clear();
+	}
+
+	// ɤsɮסAWL 10MB hsRW .old
+	void openLogFile() {
+		std::string date = Logger::getCurrentDate();
+		if (logFile.is_open() && date == currentDate && fileSize <= MAX_LOG_SIZE) {
+			return;
+		}
+
+		if (logFile.is_open()) {
+			logFile.close();
+		}
+
+		if (date != currentDate) {
+			currentDate = date;
+			logPath = Logger::getLogFilePath(date);
+		}
+
+		if (std::filesystem::exists(logPath) && std::filesystem::file_size(logPath) > MAX_LOG_SIZE) {
+			std::string backupPath = logPath + ".old";
+
+			// R³ƥɮ
+			std::filesystem::remove(backupPath);
+
+			// sRWeɮ
+			std::filesystem::rename(logPath, backupPath);
+		}
+
+		logFile.open(logPath, std::ios::app | std::ios::binary);
+		logFile.seekp(0, std::ios::end);
+		fileSize = logFile.is_open() ? (size_t)logFile.tellp() : 0;
+	}
+};
+
+void Logger::log(const std::string& level, const std::string& message) {
+	std::string record;
+	record.reserve(level.size() + message.size() + 25);
+	record += "[";
+	record += getTimestamp();
+	record += "][";
+	record += level;
+	record += "] ";
+	record += message;
+	record += "\n";
+
+	LogWriter::instance().push(std::move(record));
+}
+
+void Logger::flush() {
+	LogWriter::instance().flush();
+}
+
+void Logger::shutdown() {
+	LogWriter::instance().shutdown();
+}
+
+std::string Logger::getCurrentDate() {
+	auto now = std::chrono::system_clock::now();
+	return formatTime(std::chrono::system_clock::to_time_t(now), "%Y%m%d");
+}
+
+std::string Logger::getLogDirectory() {
+	std::filesystem::path logDir = "logs";
+
+	// TO logs Ƨsb
+	if (!std::filesystem::exists(logDir)) {
+		try {
+			std::filesystem::create_directories(logDir);
+		}
+		catch (const std::filesystem::filesystem_error& e) {
+			// pGLkЫظƧAiݭn^heؿ
+			return "log";
+		}
+	}
+	return logDir.string();
+}
+
+std::string Logger::getTimestamp() {
+	// P@O@ή榡ƵG
+	thread_local std::time_t cachedTime = 0;
+	thread_local std::string cachedTimestamp;
+
+	auto now = std::chrono::system_clock::now();
+	std::time_t time = std::chrono::system_clock::to_time_t(now);
+	if (time != cachedTime) {
+		cachedTime = time;
+		cachedTimestamp = formatTime(time, "%Y-%m-%d %H:%M:%S");
+	}
+	return cachedTimestamp;
+}
+
+std::string Logger::getLogFilePath(const std::string& date) {
+	std::string logDir = getLogDirectory();
+	return logDir + "/" + date + "-socket_client.log";
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+
+#define MAX_LOG_SIZE 10 * 1024 * 1024 // 10MB
+#define LOG_QUEUE_CAPACITY 8192
+#define LOG_FLUSH_INTERVAL_MS 100
+
+/// <summary>
+/// DPBOGIsݥutd榡ƨéJLwİϡA
+/// ѭI妸gJ֨ɮסAóBzɮפjpPC鴫
+/// </summary>
+class Logger
+{
+public:
+	static void log(const std::string& level, const std::string& message);
+
+	static void info(const std::string& message) {
+		log("INFO", message);
+	}
+
+	static void error(const std::string& message) {
+		log("ERROR", message);
+	}
+
+	static void debug(const std::string& message) {
+		log("DEBUG", message);
+	}
+
+	/// <summary>
+	/// NCOߧYgJɮ
+	/// </summary>
+	static void flush();
+
+	/// <summary>
+	/// IgɰügJѾlOA᪺O|sҰʰ
+	/// Windows W DLL eIs ( CloseConnection / DestroyClient Bz)
+	/// </summary>
+	static void shutdown();
+
+private:
+	static std::string getCurrentDate();
+	static std::string getLogDirectory();
+	static std::string getTimestamp();
+	static std::string getLogFilePath(const std::string& date);
+
+	friend class LogWriter;
+};
@@ -0,0 +1,295 @@
+#include "pch.h"
+#include "Lz4Decoder.h"
+#include "MessageReader.h"
+#include <string.h>
+#include <algorithm>
+
+#define LZ4_FRAME_MAGIC 0x184D2204
+#define LZ4_HISTORY_SIZE 64 * 1024 // ZW
+#define LZ4_MIN_MATCH 4
+
+static uint32_t readLittleEndian32(const unsigned char* data)
+{
+	return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+// Ū 15 H 255 򪺪
+static bool readLength(const unsigned char*& ip, const unsigned char* end, size_t& length)
+{
+	unsigned char byte;
+	do {
+		if (ip >= end) {
+			return false;
+		}
+		byte = *ip++;
+		length += byte;
+	} while (byte == 255);
+	return true;
+}
+
+ptrdiff_t DecompressLz4Block(const char* source, size_t sourceSize, const char* history, char* destination, size_t capacity)
+{
+	const unsigned char* ip = (const unsigned char*)source;
+	const unsigned char* inputEnd = ip + sourceSize;
+	char* op = destination;
+	char* outputEnd = destination + capacity;
+
+	while (true) {
+		if (ip >= inputEnd) {
+			return -1;
+		}
+		unsigned token = *ip++;
+
+		size_t literalLength = token >> 4;
+		if (literalLength == 15 && !readLength(ip, inputEnd, literalLength)) {
+			return -1;
+		}
+		if ((size_t)(inputEnd - ip) < literalLength || (size_t)(outputEnd - op) < literalLength) {
+			return -1;
+		}
+		memcpy(op, ip, literalLength);
+		op += literalLength;
+		ip += literalLength;
+
+		// ϶̫@ӧǦCur
+		if (ip == inputEnd) {
+			break;
+		}
+
+		if (inputEnd - ip < 2) {
+			return -1;
+		}
+		size_t offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+		ip += 2;
+		if (offset == 0 || (size_t)(op - history) < offset) {
+			return -1;
+		}
+
+		size_t matchLength = token & 15;
+		if (matchLength == 15 && !readLength(ip, inputEnd, matchLength)) {
+			return -1;
+		}
+		matchLength += LZ4_MIN_MATCH;
+		if ((size_t)(outputEnd - op) < matchLength) {
+			return -1;
+		}
+
+		const char* match = op - offset;
+		if (offset == 1) {
+			// Rϰ (Ҧp 0xFF) YᬰZ 1 
+			memset(op, *match, matchLength);
+		}
+		else if (offset >= matchLength) {
+			memcpy(op, match, matchLength);
+		}
+		else {
+			// ӷPت|Av줸սƻsHƫe˦
+			for (size_t i = 0; i < matchLength; i++) {
+				op[i] = match[i];
+			}
+		}
+		op += matchLength;
+	}
+	return op - destination;
+}
+
+void Lz4FrameDecoder::begin(size_t encodedSize, size_t decodedSize)
+{
+	this->encodedSize = encodedSize;
+	this->decodedSize = decodedSize;
+	consumed = 0;
+	decoded = 0;
+	headerRead = false;
+	finished = false;
+	malformed = false;
+	errorMessage.clear();
+	windowEnd = 0;
+	pendingBegin = 0;
+}
+
+bool Lz4FrameDecoder::fail(const std::string& message)
+{
+	malformed = true;
+	errorMessage = message;
+	return false;
+}
+
+bool Lz4FrameDecoder::readInput(MessageReader& reader, char* destination, size_t length)
+{
+	if (length > encodedSize - consumed) {
+		return fail("Compressed body is longer than encodedSize");
+	}
+	size_t received = reader.readFull(destination, length);
+	consumed += received;
+	if (received < length) {
+		errorMessage = reader.lastError();
+		return false;
+	}
+	return true;
+}
+
+bool Lz4FrameDecoder::readFrameHeader(MessageReader& reader)
+{
+	// magic (4)BFLGBBDA FLG ae (8)Br ID (4) PYˬdX (1)
+	unsigned char descriptor[6];
+	if (!readInput(reader, (char*)descriptor, sizeof(descriptor))) {
+		return false;
+	}
+	if (readLittleEndian32(descriptor) != LZ4_FRAME_MAGIC) {
+		return fail("Compressed body is not an LZ4 frame");
+	}
+	unsigned char flags = descriptor[4];
+	if ((flags >> 6) != 1) {
+		return fail("Unsupported LZ4 frame version");
+	}
+	if (flags & 0x01) {
+		return fail("LZ4 dictionaries are not supported");
+	}
+	independentBlocks = (flags & 0x20) != 0;
+	blockChecksum = (flags & 0x10) != 0;
+	contentChecksum = (flags & 0x04) != 0;
+	bool hasContentSize = (flags & 0x08) != 0;
+
+	int blockSizeId = (descriptor[5] >> 4) & 0x07;
+	if (blockSizeId < 4) {
+		return fail("Invalid LZ4 block size");
+	}
+	// 4: 64KBB5: 256KBB6: 1MBB7: 4MB
+	blockMaxSize = (size_t)1 << (8 + 2 * blockSizeId);
+
+	unsigned char rest[9];
+	size_t restSize = hasContentSize ? 9 : 1;
+	if (!readInput(reader, (char*)rest, restSize)) {
+		return false;
+	}
+	if (hasContentSize) {
+		uint64_t contentSize = readLittleEndian32(rest) | ((uint64_t)readLittleEndian32(rest + 4) << 32);
+		if (contentSize != decodedSize) {
+			return fail("LZ4 content size does not match the header");
+		}
+	}
+
+	input.resize(blockMaxSize);
+	window.resize(independentBlocks ? blockMaxSize : LZ4_HISTORY_SIZE + blockMaxSize);
+	headerRead = true;
+	return true;
+}
+
+bool Lz4FrameDecoder::readFrameEnd(MessageReader& reader)
+{
+	unsigned char end[8];
+	size_t endSize = contentChecksum ? 8 : 4;
+	if (!readInput(reader, (char*)end, endSize)) {
+		return false;
+	}
+	if (readLittleEndian32(end) != 0) {
+		return fail("LZ4 frame is longer than the decoded size");
+	}
+	if (consumed != encodedSize) {
+		return fail("Compressed body is shorter than encodedSize");
+	}
+	finished = true;
+	return true;
+}
+
+// ϶̮ۨɫOd̫ 64KBAU@Ӱ϶iHѷ
+char* Lz4FrameDecoder::prepareWindow()
+{
+	if (independentBlocks) {
+		windowEnd = 0;
+	}
+	else if (windowEnd + blockMaxSize > window.size()) {
+		size_t keep = std::min(windowEnd, (size_t)LZ4_HISTORY_SIZE);
+		memmove(window.data(), window.data() + windowEnd - keep, keep);
+		windowEnd = keep;
+	}
+	pendingBegin = windowEnd;
+	return window.data() + windowEnd;
+}
+
+size_t Lz4FrameDecoder::read(MessageReader& reader, char* destination, size_t length)
+{
+	if (!headerRead && !readFrameHeader(reader)) {
+		return 0;
+	}
+
+	size_t produced = 0;
+	while (produced < length) {
+		if (pendingBegin < windowEnd) {
+			size_t count = std::min(windowEnd - pendingBegin, length - produced);
+			memcpy(destination + produced, window.data() + pendingBegin, count);
+			pendingBegin += count;
+			produced += count;
+			continue;
+		}
+		if (decoded >= decodedSize) {
+			fail("LZ4 frame is shorter than the decoded size");
+			return produced;
+		}
+
+		unsigned char sizeField[4];
+		if (!readInput(reader, (char*)sizeField, sizeof(sizeField))) {
+			return produced;
+		}
+		uint32_t blockSize = readLittleEndian32(sizeField);
+		bool stored = (blockSize & 0x80000000) != 0;
+		blockSize &= 0x7FFFFFFF;
+		if (blockSize == 0) {
+			fail("LZ4 frame is shorter than the decoded size");
+			return produced;
+		}
+		if (blockSize > blockMaxSize) {
+			fail("LZ4 block exceeds the maximum block size");
+			return produced;
+		}
+
+		// ϶WߥBѾlŶɪXAgL
+		char* target = destination + produced;
+		size_t room = length - produced;
+		bool direct = independentBlocks && room >= (stored ? blockSize : blockMaxSize);
+		if (!direct) {
+			target = prepareWindow();
+		}
+
+		size_t blockDecoded;
+		if (stored) {
+			if (!readInput(reader, target, blockSize)) {
+				return produced;
+			}
+			blockDecoded = blockSize;
+		}
+		else {
+			if (!readInput(reader, input.data(), blockSize)) {
+				return produced;
+			}
+			const char* history = independentBlocks ? target : window.data();
+			ptrdiff_t result = DecompressLz4Block(input.data(), blockSize, history, target, blockMaxSize);
+			if (result < 0) {
+				fail("Corrupted LZ4 block");
+				return produced;
+			}
+			blockDecoded = (size_t)result;
+		}
+		if (blockChecksum && !readInput(reader, (char*)sizeField, sizeof(sizeField))) {
+			return produced;
+		}
+
+		decoded += blockDecoded;
+		if (decoded > decodedSize) {
+			fail("LZ4 frame is longer than the decoded size");
+			return produced;
+		}
+		if (direct) {
+			produced += blockDecoded;
+		}
+		else {
+			windowEnd += blockDecoded;
+		}
+	}
+
+	// TɥXeiH
+	if (decoded == decodedSize && pendingBegin == windowEnd && !finished && !readFrameEnd(reader)) {
+		return 0;
+	}
+	return produced;
+}
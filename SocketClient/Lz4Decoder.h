@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class MessageReader;
+
+/// <summary>
+/// LZ4 frame 榡yYGqsuŪYeXAOζqPɮפjpL
+/// ϶WߥBتŶeǤ@Ӱ϶ɪYتOA_hgLwİ
+///  frame  xxHash ˬdXA]䴩r
+/// </summary>
+class Lz4FrameDecoder
+{
+public:
+	/// <summary>
+	/// }lY@Ӧ^e
+	/// </summary>
+	/// <param name="encodedSize">suYe</param>
+	/// <param name="decodedSize">Y᪺</param>
+	void begin(size_t encodedSize, size_t decodedSize);
+
+	/// <summary>
+	/// Yn length 줸ըتOAX̫@q@Ū frame 
+	/// </summary>
+	/// <returns>X줸ռơAp length ܳsu_Τe榡~ (isMalformed)</returns>
+	size_t read(MessageReader& reader, char* destination, size_t length);
+
+	/// <summary>
+	/// wqsuŪYe
+	/// </summary>
+	size_t consumedInput() const {
+		return consumed;
+	}
+
+	/// <summary>
+	/// |qsuŪYe
+	/// </summary>
+	size_t remainingInput() const {
+		return encodedSize - consumed;
+	}
+
+	/// <summary>
+	/// ҦewXB frame wŪ
+	/// </summary>
+	bool isFinished() const {
+		return finished;
+	}
+
+	/// <summary>
+	/// ̪@ read ѬO_]Ye榡~ (ӫDsuD)
+	/// </summary>
+	bool isMalformed() const {
+		return malformed;
+	}
+
+	const std::string& lastError() const {
+		return errorMessage;
+	}
+
+private:
+	size_t encodedSize = 0;
+	size_t decodedSize = 0;
+	size_t consumed = 0;
+	// wYסA]t|X
+	size_t decoded = 0;
+	bool headerRead = false;
+	bool finished = false;
+	bool malformed = false;
+	std::string errorMessage;
+
+	// frame yz
+	bool independentBlocks = false;
+	bool blockChecksum = false;
+	bool contentChecksum = false;
+	size_t blockMaxSize = 0;
+
+	// Y϶
+	std::vector<char> input;
+	// LkX϶Y즹BF϶̮ۨɫOde 64KB @諸ӷ
+	std::vector<char> window;
+	size_t windowEnd = 0;
+	size_t pendingBegin = 0;
+
+	bool readInput(MessageReader& reader, char* destination, size_t length);
+	bool readFrameHeader(MessageReader& reader);
+	bool readFrameEnd(MessageReader& reader);
+	bool fail(const std::string& message);
+	char* prepareWindow();
+};
+
+/// <summary>
+/// Y@ LZ4 ϶
+/// </summary>
+/// <param name="history">iѷӪ̫emA϶W߮ɵ destination</param>
+/// <returns>Y᪺סA榡~ζWX capacity ɦ^ -1</returns>
+ptrdiff_t DecompressLz4Block(const char* source, size_t sourceSize, const char* history, char* destination, size_t capacity);
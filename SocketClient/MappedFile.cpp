@@ -0,0 +1,137 @@
+#include "pch.h"
+#include "MappedFile.h"
+#include "Logger.h"
+#include <stdlib.h>
+#include <mutex>
+#include <unordered_map>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+struct Mapping
+{
+	size_t size;
+#ifdef _WIN32
+	HANDLE file;
+	HANDLE mapping;
+#endif
+};
+
+// ثeĪMgAFreeFileInfo ̦P_ data 覡
+static std::mutex mappingMutex;
+static std::unordered_map<char*, Mapping> mappings;
+
+// ɮ׵LkMgAH@Ӧ줸ժtmNæP˵nO
+static char* mapEmpty()
+{
+	char* data = static_cast<char*>(malloc(1));
+	if (data) {
+		std::lock_guard<std::mutex> lock(mappingMutex);
+		mappings[data] = Mapping{ 0 };
+	}
+	return data;
+}
+
+char* MapFile(const std::string& path, size_t size)
+{
+	if (size == 0) {
+		return mapEmpty();
+	}
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE) {
+		Logger::error("Failed to open " + path + ": " + std::to_string(GetLastError()));
+		return nullptr;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || (unsigned long long)fileSize.QuadPart != size) {
+		Logger::error("Unexpected size of " + path);
+		CloseHandle(file);
+		return nullptr;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+	if (mapping == NULL) {
+		Logger::error("CreateFileMapping failed for " + path + ": " + std::to_string(GetLastError()));
+		CloseHandle(file);
+		return nullptr;
+	}
+
+	char* data = static_cast<char*>(MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, size));
+	if (data == NULL) {
+		Logger::error("MapViewOfFile failed for " + path + ": " + std::to_string(GetLastError()));
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return nullptr;
+	}
+
+	std::lock_guard<std::mutex> lock(mappingMutex);
+	mappings[data] = Mapping{ size, file, mapping };
+	return data;
+#else
+	int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		Logger::error("Failed to open " + path + ": " + std::to_string(errno));
+		return nullptr;
+	}
+
+	struct stat info;
+	if (fstat(fd, &info) != 0 || (size_t)info.st_size != size) {
+		Logger::error("Unexpected size of " + path);
+		close(fd);
+		return nullptr;
+	}
+
+	// MAP_PRIVATEGIsݥiק鷺eӤvT֨ɮ
+	void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (address == MAP_FAILED) {
+		Logger::error("mmap failed for " + path + ": " + std::to_string(errno));
+		return nullptr;
+	}
+	madvise(address, size, MADV_SEQUENTIAL);
+
+	char* data = static_cast<char*>(address);
+	std::lock_guard<std::mutex> lock(mappingMutex);
+	mappings[data] = Mapping{ size };
+	return data;
+#endif
+}
+
+bool UnmapFile(char* data)
+{
+	Mapping mapping;
+	{
+		std::lock_guard<std::mutex> lock(mappingMutex);
+		auto it = mappings.find(data);
+		if (it == mappings.end()) {
+			return false;
+		}
+		mapping = it->second;
+		mappings.erase(it);
+	}
+
+	if (mapping.size == 0) {
+		free(data);
+		return true;
+	}
+
+#ifdef _WIN32
+	UnmapViewOfFile(data);
+	CloseHandle(mapping.mapping);
+	CloseHandle(mapping.file);
+#else
+	munmap(data, mapping.size);
+#endif
+	return true;
+}
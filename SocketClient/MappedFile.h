@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/// <summary>
+/// H copy-on-write 覡Nɮ׬MgOAIsݭק鷺e|g^ɮ
+/// Mg|nOb{wA UnmapFile (FreeFileInfo) Ѱ
+/// </summary>
+/// <param name="path">ɮ׸|</param>
+/// <param name="size">wɮפjpAŮɵ</param>
+/// <returns>Mg_l}AѦ^ nullptr</returns>
+char* MapFile(const std::string& path, size_t size);
+
+/// <summary>
+/// Y data  MapFile GhѰMg
+/// </summary>
+/// <returns>true ܤwѰMgFfalse  data OMgO</returns>
+bool UnmapFile(char* data);
@@ -0,0 +1,180 @@
+#include "pch.h"
+#include "MessageReader.h"
+#include "Transport.h"
+#include <string.h>
+#include <algorithm>
+
+MessageReader::MessageReader()
+	: transport(nullptr), buffer(READ_CHUNK_SIZE)
+{
+}
+
+MessageReader::MessageReader(Transport& transport)
+	: transport(&transport), buffer(READ_CHUNK_SIZE)
+{
+}
+
+int MessageReader::readHeader(std::string& header)
+{
+	resetScan();
+	while (true) {
+		int result = parseHeader(header);
+		if (result != 0) {
+			return result;
+		}
+
+		int received = fill();
+		if (received <= 0) {
+			return received;
+		}
+	}
+}
+
+int MessageReader::parseHeader(std::string& header)
+{
+	malformed = false;
+
+	// qWym~
+	for (size_t i = begin + scanPosition; i < end; i++) {
+		char c = buffer[i];
+		if (depth == 0) {
+			// Y}leu\ťզr
+			if (c == '{') {
+				depth = 1;
+				begin = i;
+			}
+			else if (c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+				errorMessage = "Unexpected byte before JSON header: " + std::to_string((unsigned char)c);
+				malformed = true;
+				return -1;
+			}
+			continue;
+		}
+		if (inString) {
+			if (escaped) {
+				escaped = false;
+			}
+			else if (c == '\\') {
+				escaped = true;
+			}
+			else if (c == '"') {
+				inString = false;
+			}
+			continue;
+		}
+		if (c == '"') {
+			inString = true;
+		}
+		else if (c == '{' || c == '[') {
+			depth++;
+		}
+		else if ((c == '}' || c == ']') && --depth == 0) {
+			header.assign(buffer.data() + begin, i + 1 - begin);
+			begin = i + 1;
+			resetScan();
+			return (int)header.size();
+		}
+	}
+
+	if (depth == 0) {
+		// uťզrA
+		begin = end;
+	}
+	scanPosition = end - begin;
+
+	if (end - begin >= MAX_HEADER_SIZE) {
+		errorMessage = "JSON header exceeds " + std::to_string(MAX_HEADER_SIZE) + " bytes";
+		malformed = true;
+		return -1;
+	}
+	return 0;
+}
+
+int MessageReader::read(char* destination, size_t length)
+{
+	if (length == 0) {
+		return 0;
+	}
+
+	if (begin < end) {
+		return (int)take(destination, length);
+	}
+
+	// wİϤwšAIsݪO
+	int received = transport->receive(destination, length);
+	if (received < 0) {
+		errorMessage = "Receive failed with error: " + std::to_string(transport->lastError());
+	}
+	return received;
+}
+
+size_t MessageReader::readFull(char* destination, size_t length)
+{
+	size_t copied = take(destination, length);
+	if (copied == length) {
+		return length;
+	}
+
+	size_t received = transport->receiveAll(destination + copied, length - copied);
+	if (copied + received < length) {
+		errorMessage = transport->lastError() != 0
+			? "Receive failed with error: " + std::to_string(transport->lastError())
+			: "Connection closed by server";
+	}
+	return copied + received;
+}
+
+size_t MessageReader::take(char* destination, size_t length)
+{
+	size_t count = std::min(length, end - begin);
+	if (count > 0) {
+		memcpy(destination, buffer.data() + begin, count);
+		begin += count;
+	}
+	return count;
+}
+
+char* MessageReader::prepareFill(size_t& space)
+{
+	// NBzƲwİ϶}YAnXRŶ
+	if (begin > 0) {
+		memmove(buffer.data(), buffer.data() + begin, end - begin);
+		end -= begin;
+		begin = 0;
+	}
+	if (buffer.size() - end < READ_CHUNK_SIZE / 2) {
+		buffer.resize(buffer.size() * 2);
+	}
+	space = buffer.size() - end;
+	return buffer.data() + end;
+}
+
+void MessageReader::commitFill(size_t received)
+{
+	end += received;
+}
+
+int MessageReader::fill()
+{
+	size_t space;
+	char* destination = prepareFill(space);
+	int received = transport->receive(destination, space);
+	if (received < 0) {
+		errorMessage = "Receive failed with error: " + std::to_string(transport->lastError());
+		return -1;
+	}
+	if (received == 0) {
+		errorMessage = "Connection closed by server";
+		return 0;
+	}
+	commitFill((size_t)received);
+	return received;
+}
+
+void MessageReader::resetScan()
+{
+	scanPosition = 0;
+	depth = 0;
+	inString = false;
+	escaped = false;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class Transport;
+
+#define READ_CHUNK_SIZE 64 * 1024 // 64KB
+#define MAX_HEADER_SIZE 1024 * 1024 // 1MB
+
+/// <summary>
+/// TŪGqs TCP ƬyX JSON YPe
+/// JSON YYj (H̥~hAtP_)A
+/// PY@_쪺hlƷ|OdUӡAѫŪeɨϥ
+/// sǿhɥѩIsݦۦ汵 (prepareFill / commitFill)AuϥνwİϪΥ\
+/// </summary>
+class MessageReader
+{
+public:
+	MessageReader();
+	explicit MessageReader(Transport& transport);
+
+	/// <summary>
+	/// Ū@ӧ㪺 JSON Y
+	/// </summary>
+	/// <param name="header">㪺 JSON r</param>
+	/// <returns>YסAsu^ 0Aѩή榡~^ -1</returns>
+	int readHeader(std::string& header);
+
+	/// <summary>
+	/// ŪeơAuνwİϤw쪺줸
+	/// </summary>
+	/// <returns>Ū줸ռơAsu^ 0AѦ^ -1</returns>
+	int read(char* destination, size_t length);
+
+	/// <summary>
+	/// Ūn length 줸ըتO
+	/// wİϤƥƻsLhAlѶǿhAgLwİ
+	/// </summary>
+	/// <returns>Ū줸ռơAp length ܳsuΥ</returns>
+	size_t readFull(char* destination, size_t length);
+
+	/// <summary>
+	/// qwİϤX@ӧ㪺 JSON YAsơFyi׫OdUIs
+	/// </summary>
+	/// <returns>YסAƤ^ 0A榡~^ -1</returns>
+	int parseHeader(std::string& header);
+
+	/// <summary>
+	/// oigJsƪŶAnɾzXRwİ
+	/// </summary>
+	/// <param name="space">igJ줸ռ</param>
+	char* prepareFill(size_t& space);
+
+	/// <summary>
+	/// T{ prepareFill gJ줸ռ
+	/// </summary>
+	void commitFill(size_t received);
+
+	/// <summary>
+	/// XwİϤơA̦h length 줸
+	/// </summary>
+	/// <returns>X줸ռ</returns>
+	size_t take(char* destination, size_t length);
+
+	/// <summary>
+	/// wİϤ|Ϊ줸ռ
+	/// </summary>
+	size_t buffered() const {
+		return end - begin;
+	}
+
+	/// <summary>
+	/// ̪@Ѫyz
+	/// </summary>
+	const std::string& lastError() const {
+		return errorMessage;
+	}
+
+	/// <summary>
+	/// ̪@ readHeader ѬO_]Ʈ榡~ (ӫDsuD)
+	/// </summary>
+	bool isMalformed() const {
+		return malformed;
+	}
+
+private:
+	Transport* transport;
+	std::vector<char> buffer;
+	size_t begin = 0;
+	size_t end = 0;
+
+	// YyAAhOdAקKƱy
+	size_t scanPosition = 0;
+	int depth = 0;
+	bool inString = false;
+	bool escaped = false;
+
+	std::string errorMessage;
+	bool malformed = false;
+
+	int fill();
+	void resetScan();
+};
@@ -0,0 +1,279 @@
+#include "pch.h"
+#include "Metrics.h"
+#include "Logger.h"
+#include <string.h>
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+static const char* const phaseNames[METRICS_PHASE_COUNT] = {
+	"dns", "connect", "send", "first_byte", "body", "parse", "request"
+};
+
+static const char* const errorNames[METRICS_ERROR_COUNT] = {
+	"connect", "send", "receive", "timeout", "protocol", "server", "checksum"
+};
+
+static const double summaryQuantiles[] = { 0.5, 0.9, 0.99, 0.999 };
+
+static int highestBit(uint64_t value)
+{
+	int bit = 0;
+	while (value >>= 1) {
+		bit++;
+	}
+	return bit;
+}
+
+LatencyHistogram::LatencyHistogram()
+	: totalCount(0), totalNs(0), maxNs(0)
+{
+	for (auto& bucket : buckets) {
+		bucket.store(0, std::memory_order_relaxed);
+	}
+}
+
+size_t LatencyHistogram::bucketIndex(uint64_t value)
+{
+	if (value < HISTOGRAM_SUB_BUCKET_COUNT) {
+		return (size_t)value;
+	}
+	int magnitude = highestBit(value);
+	if (magnitude > HISTOGRAM_MAX_MAGNITUDE) {
+		return HISTOGRAM_BUCKET_COUNT - 1;
+	}
+	int shift = magnitude - HISTOGRAM_SUB_BUCKET_BITS;
+	size_t subBucket = (size_t)(value >> shift) - HISTOGRAM_SUB_BUCKET_COUNT;
+	return (size_t)(shift + 1) * HISTOGRAM_SUB_BUCKET_COUNT + subBucket;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index)
+{
+	if (index < HISTOGRAM_SUB_BUCKET_COUNT) {
+		return index;
+	}
+	int shift = (int)(index / HISTOGRAM_SUB_BUCKET_COUNT) - 1;
+	uint64_t subBucket = index % HISTOGRAM_SUB_BUCKET_COUNT;
+	uint64_t lower = (HISTOGRAM_SUB_BUCKET_COUNT + subBucket) << shift;
+	return lower + ((uint64_t)1 << shift) - 1;
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds duration)
+{
+	uint64_t value = duration.count() > 0 ? (uint64_t)duration.count() : 0;
+	buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+	totalCount.fetch_add(1, std::memory_order_relaxed);
+	totalNs.fetch_add(value, std::memory_order_relaxed);
+
+	uint64_t currentMax = maxNs.load(std::memory_order_relaxed);
+	while (value > currentMax && !maxNs.compare_exchange_weak(currentMax, value, std::memory_order_relaxed)) {
+	}
+}
+
+void LatencyHistogram::summarize(LatencySummary& summary) const
+{
+	// ƻs@AקKpLgJyʤƤ@P
+	std::array<uint64_t, HISTOGRAM_BUCKET_COUNT> counts;
+	uint64_t total = 0;
+	for (size_t i = 0; i < HISTOGRAM_BUCKET_COUNT; i++) {
+		counts[i] = buckets[i].load(std::memory_order_relaxed);
+		total += counts[i];
+	}
+
+	memset(&summary, 0, sizeof(summary));
+	summary.count = total;
+	if (total == 0) {
+		return;
+	}
+
+	uint64_t maxValue = maxNs.load(std::memory_order_relaxed);
+	summary.meanUs = (double)totalNs.load(std::memory_order_relaxed) / (double)totalCount.load(std::memory_order_relaxed) / 1000.0;
+	summary.maxUs = (double)maxValue / 1000.0;
+
+	double* targets[] = { &summary.p50Us, &summary.p90Us, &summary.p99Us, &summary.p999Us };
+	uint64_t seen = 0;
+	size_t target = 0;
+	for (size_t i = 0; i < HISTOGRAM_BUCKET_COUNT && target < 4; i++) {
+		seen += counts[i];
+		while (target < 4 && seen > 0 && (double)seen >= summaryQuantiles[target] * (double)total) {
+			*targets[target] = (double)std::min(bucketUpperBound(i), maxValue) / 1000.0;
+			target++;
+		}
+	}
+}
+
+Metrics::Metrics()
+	: requests(0), bytesSent(0), bytesReceived(0), cacheHits(0), cacheMisses(0), resumes(0), deltas(0)
+{
+	for (auto& error : errors) {
+		error.store(0, std::memory_order_relaxed);
+	}
+}
+
+void Metrics::recordPhase(MetricsPhase phase, std::chrono::nanoseconds duration)
+{
+	phases[phase].record(duration);
+}
+
+void Metrics::recordRequest(std::chrono::nanoseconds duration)
+{
+	requests.fetch_add(1, std::memory_order_relaxed);
+	phases[METRICS_PHASE_REQUEST].record(duration);
+}
+
+void Metrics::recordError(MetricsError error)
+{
+	errors[error].fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::addBytesSent(size_t bytes)
+{
+	bytesSent.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void Metrics::addBytesReceived(size_t bytes)
+{
+	bytesReceived.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void Metrics::recordCacheHit()
+{
+	cacheHits.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::recordCacheMiss()
+{
+	cacheMisses.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::recordResume()
+{
+	resumes.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::recordDelta()
+{
+	deltas.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::snapshot(ClientMetrics& metrics) const
+{
+	for (int i = 0; i < METRICS_PHASE_COUNT; i++) {
+		phases[i].summarize(metrics.phases[i]);
+	}
+	metrics.requests = requests.load(std::memory_order_relaxed);
+	metrics.bytesSent = bytesSent.load(std::memory_order_relaxed);
+	metrics.bytesReceived = bytesReceived.load(std::memory_order_relaxed);
+	for (int i = 0; i < METRICS_ERROR_COUNT; i++) {
+		metrics.errors[i] = errors[i].load(std::memory_order_relaxed);
+	}
+	metrics.cacheHits = cacheHits.load(std::memory_order_relaxed);
+	metrics.cacheMisses = cacheMisses.load(std::memory_order_relaxed);
+	metrics.resumes = resumes.load(std::memory_order_relaxed);
+	metrics.deltas = deltas.load(std::memory_order_relaxed);
+}
+
+// Prometheus ҭȻݸϱ׽uB޸P
+static std::string escapeLabel(const std::string& value)
+{
+	std::string escaped;
+	escaped.reserve(value.size());
+	for (char c : value) {
+		if (c == '\\' || c == '"') {
+			escaped += '\\';
+			escaped += c;
+		}
+		else if (c == '\n') {
+			escaped += "\\n";
+		}
+		else {
+			escaped += c;
+		}
+	}
+	return escaped;
+}
+
+static std::string formatSeconds(double seconds)
+{
+	char text[64];
+	snprintf(text, sizeof(text), "%.9f", seconds);
+	return text;
+}
+
+bool Metrics::writePrometheus(const std::string& path, const std::string& station) const
+{
+	ClientMetrics metrics;
+	snapshot(metrics);
+
+	std::string stationLabel = "station=\"" + escapeLabel(station) + "\"";
+	std::string text;
+
+	text += "# HELP socketclient_phase_duration_seconds Latency of each request phase.\n";
+	text += "# TYPE socketclient_phase_duration_seconds summary\n";
+	for (int i = 0; i < METRICS_PHASE_COUNT; i++) {
+		const LatencySummary& summary = metrics.phases[i];
+		const char* quantileNames[] = { "0.5", "0.9", "0.99", "0.999" };
+		double quantileValues[] = { summary.p50Us, summary.p90Us, summary.p99Us, summary.p999Us };
+		std::string labels = stationLabel + ",phase=\"" + phaseNames[i] + "\"";
+		for (int q = 0; q < 4; q++) {
+			text += "socketclient_phase_duration_seconds{" + labels + ",quantile=\"" + quantileNames[q] + "\"} " +
+				formatSeconds(quantileValues[q] / 1e6) + "\n";
+		}
+		text += "socketclient_phase_duration_seconds_sum{" + labels + "} " +
+			formatSeconds((double)phases[i].sumNs() / 1e9) + "\n";
+		text += "socketclient_phase_duration_seconds_count{" + labels + "} " +
+			std::to_string(summary.count) + "\n";
+	}
+
+	struct Counter
+	{
+		const char* name;
+		const char* help;
+		unsigned long long value;
+	};
+	const Counter counters[] = {
+		{ "socketclient_requests_total", "Requests issued through the client API.", metrics.requests },
+		{ "socketclient_bytes_sent_total", "Bytes sent to the server.", metrics.bytesSent },
+		{ "socketclient_bytes_received_total", "Bytes received from the server.", metrics.bytesReceived },
+		{ "socketclient_cache_hits_total", "Bin file requests served from the local cache.", metrics.cacheHits },
+		{ "socketclient_cache_misses_total", "Bin file requests downloaded after a cache lookup.", metrics.cacheMisses },
+		{ "socketclient_resumes_total", "Bin file downloads resumed after a lost connection.", metrics.resumes },
+		{ "socketclient_deltas_total", "Cached bin files updated by applying a delta patch.", metrics.deltas },
+	};
+	for (const auto& counter : counters) {
+		text += std::string("# HELP ") + counter.name + " " + counter.help + "\n";
+		text += std::string("# TYPE ") + counter.name + " counter\n";
+		text += std::string(counter.name) + "{" + stationLabel + "} " + std::to_string(counter.value) + "\n";
+	}
+
+	text += "# HELP socketclient_errors_total Failed operations by type.\n";
+	text += "# TYPE socketclient_errors_total counter\n";
+	for (int i = 0; i < METRICS_ERROR_COUNT; i++) {
+		text += "socketclient_errors_total{" + stationLabel + ",type=\"" + errorNames[i] + "\"} " +
+			std::to_string(metrics.errors[i]) + "\n";
+	}
+
+	std::string temporaryPath = path + ".tmp";
+	{
+		std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			Logger::error("Failed to open metrics file: " + temporaryPath);
+			return false;
+		}
+		file.write(text.data(), text.size());
+		if (!file.good()) {
+			Logger::error("Failed to write metrics file: " + temporaryPath);
+			return false;
+		}
+	}
+
+	std::error_code error;
+	std::filesystem::rename(temporaryPath, path, error);
+	if (error) {
+		Logger::error("Failed to rename " + temporaryPath + ": " + error.message());
+		std::filesystem::remove(temporaryPath, error);
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include "SocketClient.h"
+
+// C 2 ϶A 2^HISTOGRAM_SUB_BUCKET_BITS A۹~t 3%
+#define HISTOGRAM_SUB_BUCKET_BITS 5
+#define HISTOGRAM_SUB_BUCKET_COUNT (1 << HISTOGRAM_SUB_BUCKET_BITS)
+// ̤jiO 2^42 ` ( 73 )AWLȰOb̫@
+#define HISTOGRAM_MAX_MAGNITUDE 42
+#define HISTOGRAM_BUCKET_COUNT ((HISTOGRAM_MAX_MAGNITUDE - HISTOGRAM_SUB_BUCKET_BITS + 2) * HISTOGRAM_SUB_BUCKET_COUNT)
+
+/// <summary>
+/// HDR 𪽤ϡGHƤqBquʤO`ơA
+/// OɥulWAiѦhӰPɼgJ
+/// </summary>
+class LatencyHistogram
+{
+public:
+	LatencyHistogram();
+
+	void record(std::chrono::nanoseconds duration);
+
+	/// <summary>
+	/// pⵧơBPUʤ (L)
+	/// </summary>
+	void summarize(LatencySummary& summary) const;
+
+	uint64_t count() const {
+		return totalCount.load(std::memory_order_relaxed);
+	}
+
+	uint64_t sumNs() const {
+		return totalNs.load(std::memory_order_relaxed);
+	}
+
+private:
+	std::array<std::atomic<uint64_t>, HISTOGRAM_BUCKET_COUNT> buckets;
+	std::atomic<uint64_t> totalCount;
+	std::atomic<uint64_t> totalNs;
+	std::atomic<uint64_t> maxNs;
+
+	static size_t bucketIndex(uint64_t value);
+	static uint64_t bucketUpperBound(size_t index);
+};
+
+/// <summary>
+/// ȤݹҪįέpGUqB줸ռƻPU~
+/// </summary>
+class Metrics
+{
+public:
+	Metrics();
+
+	void recordPhase(MetricsPhase phase, std::chrono::nanoseconds duration);
+	void recordRequest(std::chrono::nanoseconds duration);
+	void recordError(MetricsError error);
+	void addBytesSent(size_t bytes);
+	void addBytesReceived(size_t bytes);
+	void recordCacheHit();
+	void recordCacheMiss();
+	void recordResume();
+	void recordDelta();
+
+	void snapshot(ClientMetrics& metrics) const;
+
+	/// <summary>
+	/// H Prometheus r榡gJɮ (gȦsɦAWAŪݤ|ݨg@be)
+	/// </summary>
+	/// <param name="station">XA@ station </param>
+	bool writePrometheus(const std::string& path, const std::string& station) const;
+
+private:
+	std::array<LatencyHistogram, METRICS_PHASE_COUNT> phases;
+	std::atomic<uint64_t> requests;
+	std::atomic<uint64_t> bytesSent;
+	std::atomic<uint64_t> bytesReceived;
+	std::array<std::atomic<uint64_t>, METRICS_ERROR_COUNT> errors;
+	std::atomic<uint64_t> cacheHits;
+	std::atomic<uint64_t> cacheMisses;
+	std::atomic<uint64_t> resumes;
+	std::atomic<uint64_t> deltas;
+};
+
+/// <summary>
+/// b}@ΰɰO@ШDΨ`Ӯ
+/// </summary>
+class RequestTimer
+{
+public:
+	explicit RequestTimer(Metrics& metrics)
+		: metrics(metrics), start(std::chrono::steady_clock::now())
+	{
+	}
+
+	~RequestTimer() {
+		metrics.recordRequest(std::chrono::steady_clock::now() - start);
+	}
+
+	RequestTimer(const RequestTimer&) = delete;
+	RequestTimer& operator=(const RequestTimer&) = delete;
+
+private:
+	Metrics& metrics;
+	std::chrono::steady_clock::time_point start;
+};
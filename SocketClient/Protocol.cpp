@@ -0,0 +1,607 @@
+#include "pch.h"
+#include "Protocol.h"
+#include "HeaderReader.h"
+#include "Sha256.h"
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+#define DEFAULT_PORT "443"
+#define DEFAULT_ADDRESS "nenweb.supreme.com.tw"
+#define ADDRESS_ENV "SOCKETCLIENT_ADDRESS"
+#define PORT_ENV "SOCKETCLIENT_PORT"
+
+// ŪܼơA]wɦ^ǪŦr
+static std::string getEnvironment(const char* name)
+{
+#ifdef _WIN32
+	char* value = nullptr;
+	size_t length = 0;
+	if (_dupenv_s(&value, &length, name) != 0 || value == nullptr) {
+		return std::string();
+	}
+	std::string result(value);
+	free(value);
+	return result;
+#else
+	const char* value = getenv(name);
+	return value ? std::string(value) : std::string();
+#endif
+}
+
+// AȾ}iܼмgAΩկhDΥAȾ
+std::string ServerAddress()
+{
+	std::string address = getEnvironment(ADDRESS_ENV);
+	return address.empty() ? DEFAULT_ADDRESS : address;
+}
+
+std::string ServerPort()
+{
+	std::string port = getEnvironment(PORT_ENV);
+	return port.empty() ? DEFAULT_PORT : port;
+}
+
+static std::time_t getCurrentTimestamp()
+{
+	auto now = std::chrono::system_clock::now();
+	std::chrono::system_clock::time_point time_point = now;
+	return std::chrono::system_clock::to_time_t(time_point);
+}
+
+// H JSON rXAWhP nlohmann::json::dump ۦPFD ASCII 줸խ˿X
+static void appendString(std::string& output, const char* text)
+{
+	static const char hex[] = "0123456789abcdef";
+	if (!text) {
+		text = "";
+	}
+	output.push_back('"');
+	const char* run = text;
+	for (const char* p = text; ; p++) {
+		unsigned char c = (unsigned char)*p;
+		if (c != '\0' && c >= 0x20 && c != '"' && c != '\\') {
+			continue;
+		}
+		// ݸ檺@[J
+		output.append(run, (size_t)(p - run));
+		if (c == '\0') {
+			break;
+		}
+		run = p + 1;
+		output.push_back('\\');
+		switch (c) {
+		case '"': output.push_back('"'); break;
+		case '\\': output.push_back('\\'); break;
+		case '\b': output.push_back('b'); break;
+		case '\f': output.push_back('f'); break;
+		case '\n': output.push_back('n'); break;
+		case '\r': output.push_back('r'); break;
+		case '\t': output.push_back('t'); break;
+		default:
+			output.append("u00", 3);
+			output.push_back(hex[c >> 4]);
+			output.push_back(hex[c & 0xF]);
+			break;
+		}
+	}
+	output.push_back('"');
+}
+
+static void appendUnsigned(std::string& output, uint64_t value)
+{
+	char digits[20];
+	size_t length = 0;
+	do {
+		digits[length++] = (char)('0' + value % 10);
+		value /= 10;
+	} while (value != 0);
+	while (length > 0) {
+		output.push_back(digits[--length]);
+	}
+}
+
+static void appendInteger(std::string& output, int64_t value)
+{
+	if (value < 0) {
+		output.push_back('-');
+		appendUnsigned(output, 0 - (uint64_t)value);
+	}
+	else {
+		appendUnsigned(output, (uint64_t)value);
+	}
+}
+
+// @ШDAtAPɶWOF̦WٱƧǡAPeH nlohmann::json ͪTۦP
+static void appendAsk(std::string& output, const AskRequest& request)
+{
+	if (request.isGetFile && request.acceptCompressed) {
+		output.append("\"acceptEncoding\":[\"lz4\"],");
+	}
+	output.append("\"askContent\":{\"applicableProjects\":");
+	appendString(output, request.applicableProjects);
+	output.append(",\"customizeId\":");
+	appendString(output, request.customizeId);
+	output.append(",\"productSeries\":");
+	appendString(output, request.productSeries);
+	output.append("},\"askId\":");
+	appendString(output, request.askId);
+	output.append(request.isGetFile ? ",\"isGetFile\":true" : ",\"isGetFile\":false");
+	if (request.isGetFile && request.knownSha256 && *request.knownSha256) {
+		output.append(",\"knownSha256\":");
+		appendString(output, request.knownSha256);
+	}
+	if (request.knownVersion && *request.knownVersion) {
+		output.append(",\"knownVersion\":");
+		appendString(output, request.knownVersion);
+	}
+	if (request.range.length > 0) {
+		output.append(",\"range\":{\"length\":");
+		appendUnsigned(output, request.range.length);
+		output.append(",\"offset\":");
+		appendUnsigned(output, request.range.offset);
+		output.push_back('}');
+	}
+}
+
+// requestId PɶWOAbL줧
+static void appendTrailer(std::string& output, uint64_t requestId)
+{
+	if (requestId != 0) {
+		output.append(",\"requestId\":");
+		appendUnsigned(output, requestId);
+	}
+	output.append(",\"timestamp\":");
+	appendInteger(output, (int64_t)getCurrentTimestamp());
+	output.push_back('}');
+}
+
+void SerializeRequest(const AskRequest& request, uint64_t requestId, std::string& output)
+{
+	output.clear();
+	output.push_back('{');
+	appendAsk(output, request);
+	appendTrailer(output, requestId);
+}
+
+std::string SerializeRequest(const AskRequest& request, uint64_t requestId)
+{
+	std::string output;
+	output.reserve(REQUEST_BUFFER_SIZE);
+	SerializeRequest(request, requestId, output);
+	return output;
+}
+
+void SerializeBatchRequest(const std::vector<AskRequest>& requests, uint64_t requestId, std::string& output)
+{
+	output.clear();
+	output.append("{\"batch\":[");
+	for (size_t i = 0; i < requests.size(); i++) {
+		if (i > 0) {
+			output.push_back(',');
+		}
+		output.push_back('{');
+		appendAsk(output, requests[i]);
+		output.push_back('}');
+	}
+	output.push_back(']');
+	appendTrailer(output, requestId);
+}
+
+std::string SerializeBatchRequest(const std::vector<AskRequest>& requests, uint64_t requestId)
+{
+	std::string output;
+	SerializeBatchRequest(requests, requestId, output);
+	return output;
+}
+
+std::string SerializeDisconnectRequest()
+{
+	return "{\"command\":\"disconnect\"}";
+}
+
+uint64_t ParseResponseId(const std::string& header)
+{
+	HeaderReader reader(header);
+	HeaderString key;
+	uint64_t requestId = 0;
+	if (!reader.beginObject()) {
+		return 0;
+	}
+	while (reader.nextMember(key)) {
+		if (key.equals("requestId")) {
+			if (!reader.readUnsigned(requestId)) {
+				return 0;
+			}
+		}
+		else if (!reader.skipValue()) {
+			return 0;
+		}
+	}
+	return reader.finish() ? requestId : 0;
+}
+
+// ̧ǨXY̥~hGstatus P message bŪAL浹 member ŪβLF
+// Ū status  error ɨXAȾTA_h浹 complete ˬdn
+template <typename Member, typename Complete>
+static ResponseStatus parseResponse(const std::string& header, std::string& message, HeaderString& status,
+	Member member, Complete complete)
+{
+	HeaderReader reader(header);
+	HeaderString key;
+	HeaderString serverMessage;
+	bool hasMessage = false;
+	status = HeaderString();
+	if (reader.beginObject()) {
+		while (reader.nextMember(key)) {
+			bool read;
+			if (key.equals("status")) {
+				read = reader.readString(status);
+			}
+			else if (key.equals("message")) {
+				read = hasMessage = reader.readString(serverMessage);
+			}
+			else {
+				read = member(key, reader);
+			}
+			if (!read) {
+				break;
+			}
+		}
+	}
+	if (!reader.finish()) {
+		message = "Invalid response header: " + reader.error();
+		return RESPONSE_MALFORMED;
+	}
+
+	if (status.equals("error")) {
+		if (!hasMessage) {
+			message = "Invalid response header: missing message";
+			return RESPONSE_MALFORMED;
+		}
+		serverMessage.copyTo(message);
+		return RESPONSE_SERVER_ERROR;
+	}
+	const char* missing = complete();
+	if (missing) {
+		message = "Invalid response header: missing " + std::string(missing);
+		return RESPONSE_MALFORMED;
+	}
+	return RESPONSE_OK;
+}
+
+// Ū start / end Ϭq
+static bool readZone(HeaderReader& reader, ShieldedZone& zone)
+{
+	HeaderString key;
+	bool hasStart = false;
+	bool hasEnd = false;
+	if (!reader.beginObject()) {
+		return false;
+	}
+	while (reader.nextMember(key)) {
+		bool read;
+		if (key.equals("start")) {
+			read = hasStart = reader.readInteger(zone.start);
+		}
+		else if (key.equals("end")) {
+			read = hasEnd = reader.readInteger(zone.end);
+		}
+		else {
+			read = reader.skipValue();
+		}
+		if (!read) {
+			return false;
+		}
+	}
+	if (reader.failed()) {
+		return false;
+	}
+	return (hasStart && hasEnd) || reader.fail("Shielded zone without start and end");
+}
+
+ResponseStatus ParseBinFileHeader(const std::string& header, bool conditional, BinFileHeader& result)
+{
+	// 쪽gJ resultAƨϥΨrꪺŶ
+	result.fileSize = 0;
+	result.ranged = false;
+	result.range = ByteRange{ 0, 0 };
+	result.fileName.clear();
+	result.version.clear();
+	result.notModified = false;
+	result.encoding = BODY_ENCODING_IDENTITY;
+	result.encodedSize = 0;
+	result.sha256.clear();
+	result.hasCrc32c = false;
+	result.crc32c = 0;
+	result.delta = false;
+	result.deltaBase.clear();
+	result.patchSize = 0;
+
+	HeaderString status;
+	HeaderString encoding;
+	HeaderString crc32c;
+	bool hasFileSize = false;
+	bool hasFileName = false;
+	bool hasEncoding = false;
+	bool hasEncodedSize = false;
+	bool hasRangeOffset = false;
+	bool hasRangeLength = false;
+	bool hasDeltaBase = false;
+	bool hasPatchSize = false;
+	uint64_t value = 0;
+
+	auto member = [&](const HeaderString& key, HeaderReader& reader) {
+		HeaderString text;
+		if (key.equals("fileSize")) {
+			hasFileSize = reader.readUnsigned(value);
+			result.fileSize = (size_t)value;
+			return hasFileSize;
+		}
+		if (key.equals("fileName")) {
+			hasFileName = reader.readString(text);
+			text.copyTo(result.fileName);
+			return hasFileName;
+		}
+		if (key.equals("Version")) {
+			if (!reader.readString(text)) {
+				return false;
+			}
+			text.copyTo(result.version);
+			return true;
+		}
+		if (key.equals("range")) {
+			// 䴩dШDAȾ^ rangeAeɮ
+			result.ranged = true;
+			if (!reader.beginObject()) {
+				return false;
+			}
+			HeaderString rangeKey;
+			while (reader.nextMember(rangeKey)) {
+				bool read;
+				if (rangeKey.equals("offset")) {
+					read = hasRangeOffset = reader.readUnsigned(result.range.offset);
+				}
+				else if (rangeKey.equals("length")) {
+					read = hasRangeLength = reader.readUnsigned(result.range.length);
+				}
+				else {
+					read = reader.skipValue();
+				}
+				if (!read) {
+					return false;
+				}
+			}
+			return !reader.failed();
+		}
+		if (key.equals("encoding")) {
+			return hasEncoding = reader.readString(encoding);
+		}
+		if (key.equals("encodedSize")) {
+			hasEncodedSize = reader.readUnsigned(value);
+			result.encodedSize = (size_t)value;
+			return hasEncodedSize;
+		}
+		if (key.equals("sha256")) {
+			if (!reader.readString(text)) {
+				return false;
+			}
+			text.copyTo(result.sha256);
+			return true;
+		}
+		if (key.equals("crc32c")) {
+			return result.hasCrc32c = reader.readString(crc32c);
+		}
+		if (key.equals("delta")) {
+			// t^uΩШDAeɮת׸ɸơAMΫH sha256 
+			result.delta = true;
+			if (!reader.beginObject()) {
+				return false;
+			}
+			HeaderString deltaKey;
+			while (reader.nextMember(deltaKey)) {
+				bool read;
+				if (deltaKey.equals("baseVersion")) {
+					read = hasDeltaBase = reader.readString(text);
+					text.copyTo(result.deltaBase);
+				}
+				else if (deltaKey.equals("patchSize")) {
+					read = hasPatchSize = reader.readUnsigned(value);
+					result.patchSize = (size_t)value;
+				}
+				else {
+					read = reader.skipValue();
+				}
+				if (!read) {
+					return false;
+				}
+			}
+			return !reader.failed();
+		}
+		return reader.skipValue();
+	};
+
+	auto complete = [&]() -> const char* {
+		result.notModified = status.equals("notModified");
+		if (!result.notModified && !hasFileSize) {
+			return "fileSize";
+		}
+		if (!result.notModified && !hasFileName) {
+			return "fileName";
+		}
+		if (result.ranged && !(hasRangeOffset && hasRangeLength)) {
+			return "range offset or length";
+		}
+		if (hasEncoding && encoding.equals("lz4") && !hasEncodedSize) {
+			return "encodedSize";
+		}
+		if (result.delta && !(hasDeltaBase && hasPatchSize)) {
+			return "delta baseVersion or patchSize";
+		}
+		return nullptr;
+	};
+
+	ResponseStatus parsed = parseResponse(header, result.message, status, member, complete);
+	if (parsed != RESPONSE_OK) {
+		return parsed;
+	}
+
+	if (result.notModified) {
+		if (!conditional) {
+			// aШD notModifiedALkP_O_ɮפe
+			result.message = "Unexpected notModified response";
+			return RESPONSE_MALFORMED;
+		}
+		result.fileSize = 0;
+	}
+	if (result.ranged && (result.range.offset > result.fileSize || result.range.length > result.fileSize - result.range.offset)) {
+		result.message = "Range exceeds file size";
+		return RESPONSE_MALFORMED;
+	}
+
+	// {o acceptEncoding AȾ^ encodingAeY
+	if (hasEncoding && encoding.equals("lz4")) {
+		result.encoding = BODY_ENCODING_LZ4;
+	}
+	else if (hasEncoding && !encoding.equals("identity")) {
+		std::string name;
+		encoding.copyTo(name);
+		result.message = "Unsupported encoding: " + name;
+		return RESPONSE_MALFORMED;
+	}
+	else {
+		result.encodedSize = 0;
+	}
+
+	// ˬdXҬɮתȡAHQir
+	if (!result.sha256.empty() && (result.sha256.size() != SHA256_DIGEST_SIZE * 2 ||
+		result.sha256.find_first_not_of("0123456789abcdefABCDEF") != std::string::npos)) {
+		result.message = "Invalid sha256: " + result.sha256;
+		return RESPONSE_MALFORMED;
+	}
+	// һP֨ҥHpgAjgKnbΤ@ഫ
+	for (char& c : result.sha256) {
+		if (c >= 'A' && c <= 'F') {
+			c = (char)(c - 'A' + 'a');
+		}
+	}
+	if (result.hasCrc32c) {
+		char text[16];
+		crc32c.copyTo(text);
+		size_t length = strlen(text);
+		if (length != 8 || strspn(text, "0123456789abcdefABCDEF") != length) {
+			result.message = "Invalid crc32c: " + std::string(text);
+			return RESPONSE_MALFORMED;
+		}
+		result.crc32c = (uint32_t)strtoul(text, nullptr, 16);
+	}
+
+	if (result.delta && (!conditional || result.ranged || result.sha256.empty())) {
+		result.message = "Unexpected delta response";
+		return RESPONSE_MALFORMED;
+	}
+	return RESPONSE_OK;
+}
+
+// MainApp / DefaultParameters @PA fill gJc
+static bool readInfoMember(const HeaderString& key, HeaderReader& reader, char (&version)[256], char (&blVersion)[256],
+	int& calibrationOffset, int& found)
+{
+	HeaderString text;
+	if (key.equals("Version")) {
+		if (!reader.readString(text)) {
+			return false;
+		}
+		text.copyTo(version);
+		found |= 1;
+		return true;
+	}
+	if (key.equals("BLVersion")) {
+		if (!reader.readString(text)) {
+			return false;
+		}
+		text.copyTo(blVersion);
+		found |= 2;
+		return true;
+	}
+	if (key.equals("CalibrationOffset")) {
+		if (!reader.readInteger(calibrationOffset)) {
+			return false;
+		}
+		found |= 4;
+		return true;
+	}
+	return reader.skipValue();
+}
+
+// readInfoMember Ū쪺줤ʤ֪Ĥ@
+static const char* missingInfoMember(int found)
+{
+	if (!(found & 1)) {
+		return "Version";
+	}
+	if (!(found & 2)) {
+		return "BLVersion";
+	}
+	if (!(found & 4)) {
+		return "CalibrationOffset";
+	}
+	return nullptr;
+}
+
+ResponseStatus ParseMainAppInfo(const std::string& header, MainAppInfo& info, std::string& message)
+{
+	HeaderString status;
+	int found = 0;
+	return parseResponse(header, message, status,
+		[&](const HeaderString& key, HeaderReader& reader) {
+			return readInfoMember(key, reader, info.version, info.blVersion, info.calibrationOffset, found);
+		},
+		[&]() {
+			return missingInfoMember(found);
+		});
+}
+
+ResponseStatus ParseDefaultParametersInfo(const std::string& header, DefaultParametersInfo& info, std::string& message)
+{
+	HeaderString status;
+	int found = 0;
+	bool hasZoneCount = false;
+	// ϬqgJ infoAWL 50 ӪL
+	int zoneEntries = 0;
+	return parseResponse(header, message, status,
+		[&](const HeaderString& key, HeaderReader& reader) {
+			if (key.equals("ShieldedZoneCount")) {
+				return hasZoneCount = reader.readInteger(info.shieldedZoneCount);
+			}
+			if (key.equals("ShieldedZone")) {
+				zoneEntries = 0;
+				if (!reader.beginArray()) {
+					return false;
+				}
+				while (reader.nextElement()) {
+					bool read = zoneEntries < 50 ? readZone(reader, info.shieldedZone[zoneEntries]) : reader.skipValue();
+					if (!read) {
+						return false;
+					}
+					zoneEntries++;
+				}
+				return !reader.failed();
+			}
+			return readInfoMember(key, reader, info.version, info.blVersion, info.calibrationOffset, found);
+		},
+		[&]() -> const char* {
+			const char* missing = missingInfoMember(found);
+			if (missing) {
+				return missing;
+			}
+			if (!hasZoneCount) {
+				return "ShieldedZoneCount";
+			}
+			// ShieldedZoneCount Ϭqsb
+			if (zoneEntries < std::min(info.shieldedZoneCount, 50)) {
+				return "ShieldedZone entries";
+			}
+			return nullptr;
+		});
+}
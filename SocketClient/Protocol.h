@@ -0,0 +1,159 @@
+#pragma once
+
+#include <string.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SocketClient.h"
+
+// ƻsrTwתATO '\0'
+template <size_t N>
+inline void copyString(char (&destination)[N], const std::string& source)
+{
+	size_t length = std::min(source.size(), N - 1);
+	memcpy(destination, source.data(), length);
+	destination[length] = '\0';
+}
+
+/// <summary>
+/// ɮפe줸սd
+/// </summary>
+struct ByteRange
+{
+	uint64_t offset;
+	// 0 ܤwd
+	uint64_t length;
+};
+
+/// <summary>
+/// .bin ɮפebsusX
+/// </summary>
+enum BodyEncoding
+{
+	BODY_ENCODING_IDENTITY,  // Y
+	BODY_ENCODING_LZ4,       // LZ4 frame 榡
+};
+
+/// <summary>
+/// @ӽШDeA妸ШDCӶإP
+/// </summary>
+struct AskRequest
+{
+	const char* askId;
+	const char* productSeries;
+	const char* applicableProjects;
+	const char* customizeId;
+	bool isGetFile;
+	// wɮתADŮɪAȾۦPhu^ notModified
+	const char* knownVersion;
+	// uoɮפe@Alength  0 ɨoɮ
+	ByteRange range = { 0, 0 };
+	// iYɮפeAu|Yݳ]w (SendData IsݦۦŪe)
+	bool acceptCompressed = false;
+	//  knownVersion ɮפe SHA-256ADŮɪAȾiH^۹Ӥet
+	const char* knownSha256 = nullptr;
+};
+
+/// <summary>
+/// .bin ɮצ^Y
+/// </summary>
+struct BinFileHeader
+{
+	// ɮתjpAd^P
+	size_t fileSize = 0;
+	// AȾu^ǤFШDdAe׬ range.length
+	bool ranged = false;
+	ByteRange range = { 0, 0 };
+	std::string fileName;
+	// AȾѮɬŦrAɤgJ֨
+	std::string version;
+	// ШDPAȾۦPASɮפe
+	bool notModified = false;
+	// Yɳsue׬ encodedSizeAYᬰ bodySize()
+	BodyEncoding encoding = BODY_ENCODING_IDENTITY;
+	size_t encodedSize = 0;
+	// ɮת SHA-256 (Qi)AAȾѮɬŦr
+	std::string sha256;
+	// ɮת CRC32C
+	bool hasCrc32c = false;
+	uint32_t crc32c = 0;
+	// eMΨ deltaBase t׸ɸơA׬ patchSize
+	bool delta = false;
+	std::string deltaBase;
+	size_t patchSize = 0;
+	// ѭ]
+	std::string message;
+
+	// Y᪺e
+	size_t bodySize() const {
+		if (delta) {
+			return patchSize;
+		}
+		return ranged ? (size_t)range.length : fileSize;
+	}
+};
+
+/// <summary>
+/// ^YѪRG
+/// </summary>
+enum ResponseStatus
+{
+	RESPONSE_OK,
+	RESPONSE_SERVER_ERROR,  // AȾ^ status  errorAsuiϥ
+	RESPONSE_MALFORMED,     // Y榡~ALko򤺮e
+};
+
+/// <summary>
+/// AȾ}Aiܼ SOCKETCLIENT_ADDRESS мgAΩկhDΥAȾ
+/// </summary>
+std::string ServerAddress();
+
+/// <summary>
+/// AȾsAiܼ SOCKETCLIENT_PORT мg
+/// </summary>
+std::string ServerPort();
+
+#define REQUEST_BUFFER_SIZE 512 // ШDTwİϪleqA@몺ШDݭnAXR
+
+/// <summary>
+/// ͽШDT
+/// </summary>
+/// <param name="requestId">޽uƮɪШDsA0 ܤa</param>
+std::string SerializeRequest(const AskRequest& request, uint64_t requestId = 0);
+
+/// <summary>
+/// ͽШDT outputAN즳eíƨϥΨŶAeqɤtmO
+/// </summary>
+void SerializeRequest(const AskRequest& request, uint64_t requestId, std::string& output);
+
+/// <summary>
+/// ͧ妸ШDTAAȾ̧Ǧ^CӶ
+/// </summary>
+std::string SerializeBatchRequest(const std::vector<AskRequest>& requests, uint64_t requestId = 0);
+
+/// <summary>
+/// ͧ妸ШDT outputAN즳eíƨϥΨŶ
+/// </summary>
+void SerializeBatchRequest(const std::vector<AskRequest>& requests, uint64_t requestId, std::string& output);
+
+/// <summary>
+/// _uШDT
+/// </summary>
+std::string SerializeDisconnectRequest();
+
+/// <summary>
+/// ^Y requestIdASεLkѪRɦ^ 0
+/// </summary>
+uint64_t ParseResponseId(const std::string& header);
+
+/// <summary>
+/// ѪR .bin ɮצ^YAѭ]gJ result.message
+/// </summary>
+/// <param name="conditional">ШDO_a knownVersionAa notModified 榡~</param>
+ResponseStatus ParseBinFileHeader(const std::string& header, bool conditional, BinFileHeader& result);
+
+ResponseStatus ParseMainAppInfo(const std::string& header, MainAppInfo& info, std::string& message);
+
+ResponseStatus ParseDefaultParametersInfo(const std::string& header, DefaultParametersInfo& info, std::string& message);
@@ -0,0 +1,252 @@
+#include "pch.h"
+#include "Sha256.h"
+#include <string.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define SHA256_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define SHA_NI_TARGET
+#else
+#include <cpuid.h>
+#define SHA_NI_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+#endif
+#endif
+
+static const uint32_t roundConstants[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static inline uint32_t rotateRight(uint32_t value, int bits)
+{
+	return (value >> bits) | (value << (32 - bits));
+}
+
+Sha256::Sha256()
+{
+	static const uint32_t initialState[8] = {
+		0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+	};
+	memcpy(state, initialState, sizeof(state));
+}
+
+// i⪺@AҦxҥiϥ
+static void transformPortable(uint32_t state[8], const uint8_t* data, size_t blocks)
+{
+	for (size_t index = 0; index < blocks; index++, data += SHA256_BLOCK_SIZE) {
+		uint32_t w[64];
+		for (int i = 0; i < 16; i++) {
+			w[i] = ((uint32_t)data[i * 4] << 24) | ((uint32_t)data[i * 4 + 1] << 16) |
+				((uint32_t)data[i * 4 + 2] << 8) | (uint32_t)data[i * 4 + 3];
+		}
+		for (int i = 16; i < 64; i++) {
+			uint32_t s0 = rotateRight(w[i - 15], 7) ^ rotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+			uint32_t s1 = rotateRight(w[i - 2], 17) ^ rotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+			w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+		}
+
+		uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+		uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+		for (int i = 0; i < 64; i++) {
+			uint32_t s1 = rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25);
+			uint32_t choose = (e & f) ^ (~e & g);
+			uint32_t temp1 = h + s1 + choose + roundConstants[i] + w[i];
+			uint32_t s0 = rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22);
+			uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+			uint32_t temp2 = s0 + majority;
+			h = g;
+			g = f;
+			f = e;
+			e = d + temp1;
+			d = c;
+			c = b;
+			b = a;
+			a = temp1 + temp2;
+		}
+
+		state[0] += a;
+		state[1] += b;
+		state[2] += c;
+		state[3] += d;
+		state[4] += e;
+		state[5] += f;
+		state[6] += g;
+		state[7] += h;
+	}
+}
+
+#ifdef SHA256_X86
+// H SHA-NI OBzGC _mm_sha256rnds2_epu32 ATƵ{ msg1/msg2 p
+SHA_NI_TARGET static void transformShaNi(uint32_t state[8], const uint8_t* data, size_t blocks)
+{
+	const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+	// AsƦCOϥΪ ABEF / CDGH
+	__m128i temp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state[0]), 0xB1);
+	__m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state[4]), 0x1B);
+	__m128i state0 = _mm_alignr_epi8(temp, state1, 8);
+	state1 = _mm_blend_epi16(state1, temp, 0xF0);
+
+	for (size_t index = 0; index < blocks; index++, data += SHA256_BLOCK_SIZE) {
+		__m128i savedState0 = state0;
+		__m128i savedState1 = state1;
+		__m128i messages[4];
+
+		// Cե|F g զPɭp⤧XջݭnT
+		for (int g = 0; g < 16; g++) {
+			if (g < 4) {
+				messages[g] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + g * 16)), byteSwap);
+			}
+			__m128i message = _mm_add_epi32(messages[g % 4], _mm_loadu_si128((const __m128i*)&roundConstants[g * 4]));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, message);
+			if (g >= 3 && g <= 14) {
+				__m128i& next = messages[(g + 1) % 4];
+				next = _mm_add_epi32(next, _mm_alignr_epi8(messages[g % 4], messages[(g + 3) % 4], 4));
+				next = _mm_sha256msg2_epu32(next, messages[g % 4]);
+			}
+			state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(message, 0x0E));
+			if (g >= 1 && g <= 12) {
+				messages[(g + 3) % 4] = _mm_sha256msg1_epu32(messages[(g + 3) % 4], messages[g % 4]);
+			}
+		}
+
+		state0 = _mm_add_epi32(state0, savedState0);
+		state1 = _mm_add_epi32(state1, savedState1);
+	}
+
+	temp = _mm_shuffle_epi32(state0, 0x1B);
+	state1 = _mm_shuffle_epi32(state1, 0xB1);
+	_mm_storeu_si128((__m128i*)&state[0], _mm_blend_epi16(temp, state1, 0xF0));
+	_mm_storeu_si128((__m128i*)&state[4], _mm_alignr_epi8(state1, temp, 8));
+}
+
+static bool cpuHasShaNi()
+{
+#ifdef _MSC_VER
+	int registers[4];
+	__cpuid(registers, 0);
+	if (registers[0] < 7) {
+		return false;
+	}
+	__cpuidex(registers, 7, 0);
+	bool sha = (registers[1] & (1 << 29)) != 0;
+	__cpuid(registers, 1);
+	return sha && (registers[2] & (1 << 19)) != 0 && (registers[2] & (1 << 9)) != 0;
+#else
+	unsigned int eax, ebx, ecx, edx;
+	if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) || (ebx & (1u << 29)) == 0) {
+		return false;
+	}
+	// t SSE4.1 P SSSE3
+	return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & (1u << 19)) != 0 && (ecx & (1u << 9)) != 0;
+#endif
+}
+#endif
+
+typedef void (*TransformFunction)(uint32_t state[8], const uint8_t* data, size_t blocks);
+
+// Ĥ@ϥήɨ CPU ܹ@
+static TransformFunction selectTransform()
+{
+#ifdef SHA256_X86
+	if (cpuHasShaNi()) {
+		return transformShaNi;
+	}
+#endif
+	return transformPortable;
+}
+
+void Sha256::transform(const uint8_t* data, size_t blocks)
+{
+	static const TransformFunction function = selectTransform();
+	function(state, data, blocks);
+}
+
+void Sha256::update(const void* data, size_t length)
+{
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	totalLength += length;
+
+	// ɺWѤU϶
+	if (blockLength > 0) {
+		size_t fill = SHA256_BLOCK_SIZE - blockLength;
+		if (fill > length) {
+			fill = length;
+		}
+		memcpy(block + blockLength, bytes, fill);
+		blockLength += fill;
+		bytes += fill;
+		length -= fill;
+		if (blockLength < SHA256_BLOCK_SIZE) {
+			return;
+		}
+		transform(block, 1);
+		blockLength = 0;
+	}
+
+	// 㪺϶BzAgLȦs
+	size_t blocks = length / SHA256_BLOCK_SIZE;
+	if (blocks > 0) {
+		transform(bytes, blocks);
+		bytes += blocks * SHA256_BLOCK_SIZE;
+		length -= blocks * SHA256_BLOCK_SIZE;
+	}
+
+	if (length > 0) {
+		memcpy(block, bytes, length);
+		blockLength = length;
+	}
+}
+
+void Sha256::finish(uint8_t digest[SHA256_DIGEST_SIZE])
+{
+	uint64_t bitLength = totalLength * 8;
+
+	block[blockLength++] = 0x80;
+	if (blockLength > SHA256_BLOCK_SIZE - 8) {
+		memset(block + blockLength, 0, SHA256_BLOCK_SIZE - blockLength);
+		transform(block, 1);
+		blockLength = 0;
+	}
+	memset(block + blockLength, 0, SHA256_BLOCK_SIZE - 8 - blockLength);
+	for (int i = 0; i < 8; i++) {
+		block[SHA256_BLOCK_SIZE - 1 - i] = (uint8_t)(bitLength >> (i * 8));
+	}
+	transform(block, 1);
+
+	for (int i = 0; i < 8; i++) {
+		digest[i * 4] = (uint8_t)(state[i] >> 24);
+		digest[i * 4 + 1] = (uint8_t)(state[i] >> 16);
+		digest[i * 4 + 2] = (uint8_t)(state[i] >> 8);
+		digest[i * 4 + 3] = (uint8_t)state[i];
+	}
+}
+
+std::string Sha256::finishHex()
+{
+	static const char digits[] = "0123456789abcdef";
+	uint8_t digest[SHA256_DIGEST_SIZE];
+	finish(digest);
+
+	std::string text(SHA256_DIGEST_SIZE * 2, '0');
+	for (int i = 0; i < SHA256_DIGEST_SIZE; i++) {
+		text[i * 2] = digits[digest[i] >> 4];
+		text[i * 2 + 1] = digits[digest[i] & 0x0F];
+	}
+	return text;
+}
+
+std::string Sha256::hex(const void* data, size_t length)
+{
+	Sha256 sha;
+	sha.update(data, length);
+	return sha.finishHex();
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#define SHA256_DIGEST_SIZE 32
+#define SHA256_BLOCK_SIZE 64
+
+/// <summary>
+/// SHA-256 AiqJFx86 Bz䴩 SHA-NI ɨϥεwO
+/// </summary>
+class Sha256
+{
+public:
+	Sha256();
+
+	void update(const void* data, size_t length);
+
+	/// <summary>
+	/// pügJ 32 줸ժKnAݭsإߪ~Aϥ
+	/// </summary>
+	void finish(uint8_t digest[SHA256_DIGEST_SIZE]);
+
+	/// <summary>
+	/// pæ^ 64 rQiKn
+	/// </summary>
+	std::string finishHex();
+
+	/// <summary>
+	/// pqƪQiKn
+	/// </summary>
+	static std::string hex(const void* data, size_t length);
+
+private:
+	uint32_t state[8];
+	uint8_t block[SHA256_BLOCK_SIZE];
+	size_t blockLength = 0;
+	uint64_t totalLength = 0;
+
+	void transform(const uint8_t* data, size_t blocks);
+};
@@ -1,521 +1,706 @@
-#define WIN32_LEAN_AND_MEAN
-
 #include "pch.h"
 #include "SocketClient.h"
-#include <windows.h>
-#include <winsock2.h>
-#include <ws2tcpip.h>
-#include <stdlib.h>
-#include <stdio.h>
-#include <chrono>
-#include <string>
-#include <fstream>
-#include <thread>
-#include <mutex>
-#include <filesystem>
-#include <iomanip>
-#include <sstream>
-#include "json.hpp"
-
-using json = nlohmann::json;
-
-#pragma comment(lib, "Ws2_32.lib")
-#pragma comment(lib, "Mswsock.lib")
-#pragma comment(lib, "AdvApi32.lib")
-
-#define DEFAULT_BUFLEN 512
-#define DEFAULT_PORT "443"
-#define DEFAULT_ADDRESS "nenweb.supreme.com.tw"
-#define LOG_FILE_PATH "socket_client.log"
-#define MAX_LOG_SIZE 10 * 1024 * 1024 // 10MB
-
-class Logger
-{
-public:
-	static void log(const std::string& level, const std::string& message) {
-		std::lock_guard<std::mutex> lock(logMutex);
-		std::ofstream logFile(LOG_FILE_PATH, std::ios::app);
-
-		try {
-			std::string logPath = getLogFilePath();
-			std::ofstream logFile(logPath, std::ios::app);
-
-			if (logFile.is_open()) {
-				// ˬdɮפjpApGWL 10MB hsRW
-				logFile.seekp(0, std::ios::end);
-				if (logFile.tellp() > (10 * 1024 * 1024)) {
-					logFile.close();
-					std::string backupPath = logPath + ".old";
-
-					// R³ƥɮ
-					std::filesystem::remove(backupPath);
-
-					// sRWeɮ
-					std::filesystem::rename(logPath, backupPath);
-
-					// s}ɮ
-					logFile.open(logPath);
-				}
-
-				logFile << "[" << getTimestamp() << "][" << level << "] " << message << std::endl;
-				logFile.close();
-			}
-		}
-		catch (const std::exception& e) {
-			// pGoͥ~AiHҼ{Xtο~ΨLƥΦm
-			OutputDebugStringA(("Logger Error: " + std::string(e.what()) + "\n").c_str());
-		}
-	}
+#include "Client.h"
+#include "Logger.h"
+#include "MappedFile.h"
+#include <memory>
+#include <vector>
 
-	static void info(const std::string& message) {
-		log("INFO", message);
+struct SocketClientHandle
+{
+	explicit SocketClientHandle(const ClientOptions& options)
+		: client(options)
+	{
 	}
 
-	static void error(const std::string& message) {
-		log("ERROR", message);
-	}
+	Client client;
+};
 
-	static void debug(const std::string& message) {
-		log("DEBUG", message);
-	}
+// ª API ϥΪw]ȤݡFNAקKb DLL ɤ~su
+static Client& defaultClient()
+{
+	static SocketClientHandle* handle = new SocketClientHandle(Client::defaultOptions());
+	return handle->client;
+}
 
-private:
-	static std::mutex logMutex;
+// IsݪrbШDeOҦġAƻs浹 I/O 
+static std::string copyArgument(const char* value)
+{
+	return value ? std::string(value) : std::string();
+}
 
-	static std::string getCurrentDate() {
-		auto now = std::chrono::system_clock::now();
-		auto time = std::chrono::system_clock::to_time_t(now);
-		struct tm timeinfo;
-		localtime_s(&timeinfo, &time);
-		
-		std::ostringstream oss;
-		oss << std::put_time(&timeinfo, "%Y%m%d");
-		return oss.str();
-	}
+static AsyncRequest getBinFileInfoAsync(
+	Client& client,
+	const char* askId,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	const char* knownVersion,
+	AsyncCompletionCallback callback,
+	void* userData
+) {
+	return client.submitAsync([&client, askId = copyArgument(askId), productSeries = copyArgument(productSeries),
+		applicableProjects = copyArgument(applicableProjects), customizeId = copyArgument(customizeId),
+		knownVersion = copyArgument(knownVersion)]() {
+		AsyncResult result = {};
+		result.fileInfo = client.getBinFileInfoIfModified(askId.c_str(), productSeries.c_str(), applicableProjects.c_str(),
+			customizeId.c_str(), knownVersion.c_str(), &result.notModified);
+		result.success = result.fileInfo != nullptr || result.notModified;
+		return result;
+	}, callback, userData);
+}
 
-	static std::string getLogDirectory() {
-		std::filesystem::path logDir = "logs";
+static AsyncRequest getBinFileStreamAsync(
+	Client& client,
+	const char* askId,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	BinFileChunkCallback chunkCallback,
+	void* chunkUserData,
+	AsyncCompletionCallback callback,
+	void* userData
+) {
+	return client.submitAsync([&client, askId = copyArgument(askId), productSeries = copyArgument(productSeries),
+		applicableProjects = copyArgument(applicableProjects), customizeId = copyArgument(customizeId),
+		chunkCallback, chunkUserData]() {
+		AsyncResult result = {};
+		std::unique_ptr<FileInfo> fileInfo(new FileInfo());
+		result.success = client.getBinFileStream(askId.c_str(), productSeries.c_str(), applicableProjects.c_str(),
+			customizeId.c_str(), chunkCallback, chunkUserData, fileInfo.get());
+		if (result.success) {
+			result.fileInfo = fileInfo.release();
+		}
+		return result;
+	}, callback, userData);
+}
 
-		// TO logs Ƨsb
-		if (!std::filesystem::exists(logDir)) {
-			try {
-				std::filesystem::create_directories(logDir);
-			}
-			catch (const std::filesystem::filesystem_error& e) {
-				// pGLkЫظƧAiݭn^heؿ
-				return "log";
-			}
+static AsyncRequest getBinFileToPathAsync(
+	Client& client,
+	const char* askId,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	const char* destinationPath,
+	AsyncCompletionCallback callback,
+	void* userData
+) {
+	return client.submitAsync([&client, askId = copyArgument(askId), productSeries = copyArgument(productSeries),
+		applicableProjects = copyArgument(applicableProjects), customizeId = copyArgument(customizeId),
+		destinationPath = copyArgument(destinationPath)]() {
+		AsyncResult result = {};
+		std::unique_ptr<FileInfo> fileInfo(new FileInfo());
+		result.success = client.getBinFileToPath(askId.c_str(), productSeries.c_str(), applicableProjects.c_str(),
+			customizeId.c_str(), destinationPath.c_str(), fileInfo.get());
+		if (result.success) {
+			result.fileInfo = fileInfo.release();
 		}
-		return logDir.string();
-	}
+		return result;
+	}, callback, userData);
+}
+
+static AsyncRequest getMainAppInfoAsync(
+	Client& client,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	AsyncCompletionCallback callback,
+	void* userData
+) {
+	return client.submitAsync([&client, productSeries = copyArgument(productSeries),
+		applicableProjects = copyArgument(applicableProjects), customizeId = copyArgument(customizeId)]() {
+		AsyncResult result = {};
+		result.mainAppInfo = client.getMainAppInfo(productSeries.c_str(), applicableProjects.c_str(), customizeId.c_str());
+		result.success = result.mainAppInfo != nullptr;
+		return result;
+	}, callback, userData);
+}
 
-	static std::string getTimestamp() {
-		auto now = std::chrono::system_clock::now();
-		auto time = std::chrono::system_clock::to_time_t(now);
-		struct tm timeinfo;
-		localtime_s(&timeinfo, &time);
+static AsyncRequest getDefaultParametersInfoAsync(
+	Client& client,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	AsyncCompletionCallback callback,
+	void* userData
+) {
+	return client.submitAsync([&client, productSeries = copyArgument(productSeries),
+		applicableProjects = copyArgument(applicableProjects), customizeId = copyArgument(customizeId)]() {
+		AsyncResult result = {};
+		result.defaultParametersInfo = client.getDefaultParametersInfo(productSeries.c_str(), applicableProjects.c_str(),
+			customizeId.c_str());
+		result.success = result.defaultParametersInfo != nullptr;
+		return result;
+	}, callback, userData);
+}
 
-		std::ostringstream oss;
-		oss << std::put_time(&timeinfo, "%Y-%m-%d %H:%M:%S");
-		return oss.str();
+static AsyncRequest getBatchAsync(
+	Client& client,
+	const BatchQuery* queries,
+	int count,
+	BatchResult* results,
+	AsyncCompletionCallback callback,
+	void* userData
+) {
+	if (count < 0 || (count > 0 && (!queries || !results))) {
+		return nullptr;
 	}
 
-	static std::string getLogFilePath() {
-		std::string logDir = getLogDirectory();
-		std::string currentDate = getCurrentDate();
-		return logDir + "/" + currentDate + "-socket_client.log";
+	// CӶ 4 ӦrAƻsA
+	auto strings = std::make_shared<std::vector<std::string>>();
+	strings->reserve((size_t)count * 4);
+	for (int i = 0; i < count; i++) {
+		for (const char* value : { queries[i].askId, queries[i].productSeries, queries[i].applicableProjects, queries[i].customizeId }) {
+			strings->push_back(copyArgument(value));
+		}
 	}
-};
+	std::vector<BatchQuery> copies(queries, queries + count);
+	for (int i = 0; i < count; i++) {
+		copies[i].askId = (*strings)[i * 4].c_str();
+		copies[i].productSeries = (*strings)[i * 4 + 1].c_str();
+		copies[i].applicableProjects = (*strings)[i * 4 + 2].c_str();
+		copies[i].customizeId = (*strings)[i * 4 + 3].c_str();
+	}
+
+	return client.submitAsync([&client, strings, copies = std::move(copies), count, results]() {
+		AsyncResult result = {};
+		result.success = client.getBatch(copies.data(), count, results);
+		return result;
+	}, callback, userData);
+}
 
-std::mutex Logger::logMutex;
+void InitClientOptions(ClientOptions* options)
+{
+	if (options) {
+		*options = Client::defaultOptions();
+	}
+}
 
-SOCKET ConnectSocket = INVALID_SOCKET;
-bool isInitialized = false;
+ClientHandle CreateClient()
+{
+	return new SocketClientHandle(Client::defaultOptions());
+}
 
-static std::time_t getCurrentTimestamp()
+ClientHandle CreateClientWithOptions(const ClientOptions* options)
 {
-	auto now = std::chrono::system_clock::now();
-	std::chrono::system_clock::time_point time_point = now;
-	return std::chrono::system_clock::to_time_t(time_point);
+	return new SocketClientHandle(options ? *options : Client::defaultOptions());
 }
 
-bool InitializeClient(
-	const char* stationType, 
-	const char* stationName, 
+void DestroyClient(ClientHandle client)
+{
+	delete client;
+	// OADLL ɤ|椤F᪺O|sҰ
+	Logger::shutdown();
+}
+
+bool ClientInitialize(
+	ClientHandle client,
+	const char* stationType,
+	const char* stationName,
 	const char* stationId,
 	const char* operatorId
 ) {
-	Logger::info("Initializing client...");
-	Logger::debug("Station Type: " + std::string(stationType) +
-		", Station Name: " + std::string(stationName) +
-		", Station ID: " + std::string(stationId) +
-		", Operator ID: " + std::string(operatorId));
-
-	if (isInitialized) {
-		Logger::info("Client already initialized");
-		return true;
+	if (!client) {
+		return false;
 	}
+	return client->client.initialize(stationType, stationName, stationId, operatorId);
+}
 
-	WSAData wsaData;
-	struct addrinfo* result = NULL, * ptr = NULL, hints;
-	int iResult;
-
-	// l Winsock
-	iResult = WSAStartup(MAKEWORD(2, 2), &wsaData);
-	if (iResult != 0) {
-		Logger::error("WSAStartup failed with error: " + std::to_string(iResult));
-		return false;
+int ClientSendData(
+	ClientHandle client,
+	const char* askId,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	bool isGetFile
+) {
+	if (!client) {
+		return -1;
 	}
+	return client->client.sendData(askId, productSeries, applicableProjects, customizeId, isGetFile);
+}
 
-	ZeroMemory(&hints, sizeof(hints));
-	hints.ai_family = AF_UNSPEC;
-	hints.ai_socktype = SOCK_STREAM;
-	hints.ai_protocol = IPPROTO_TCP;
+int ClientReceiveData(ClientHandle client, char* buffer, int bufferSize)
+{
+	if (!client) {
+		return -1;
+	}
+	return client->client.receiveData(buffer, bufferSize);
+}
 
-	// ѪRAȾa}Mݤf
-	iResult = getaddrinfo(DEFAULT_ADDRESS, DEFAULT_PORT, &hints, &result);
-	if (iResult != 0) {
-		Logger::error("getaddrinfo failed with error: " + std::to_string(iResult));
-		WSACleanup();
+bool ClientCloseConnection(ClientHandle client)
+{
+	if (!client) {
 		return false;
 	}
+	bool closed = client->client.closeConnection();
+	Logger::shutdown();
+	return closed;
+}
 
-	// ճsAȾ
-	for (ptr = result; ptr != NULL; ptr = ptr->ai_next) {
-		ConnectSocket = socket(ptr->ai_family, ptr->ai_socktype, ptr->ai_protocol);
-		if (ConnectSocket == INVALID_SOCKET) {
-			Logger::error("Socket creation failed with error: " + std::to_string(WSAGetLastError()));
-			WSACleanup();
-			return false;
-		}
-
-		Logger::debug("Attempting to connect to server...");
-		iResult = connect(ConnectSocket, ptr->ai_addr, (int)ptr->ai_addrlen);
-		if (iResult == SOCKET_ERROR) {
-			closesocket(ConnectSocket);
-			ConnectSocket = INVALID_SOCKET;
-			Logger::debug("Connection attempt failed, trying next address...");
-			continue;
-		}
-		break;
+FileInfo* ClientGetBinFileInfo(
+	ClientHandle client,
+	const char* askId,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId
+) {
+	if (!client) {
+		return nullptr;
 	}
+	return client->client.getBinFileInfo(askId, productSeries, applicableProjects, customizeId);
+}
 
-	freeaddrinfo(result);
+FileInfo* ClientGetBinFileInfoIfModified(
+	ClientHandle client,
+	const char* askId,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	const char* knownVersion,
+	bool* notModified
+) {
+	if (notModified) {
+		*notModified = false;
+	}
+	if (!client) {
+		return nullptr;
+	}
+	return client->client.getBinFileInfoIfModified(askId, productSeries, applicableProjects, customizeId,
+		knownVersion, notModified);
+}
 
-	if (ConnectSocket == INVALID_SOCKET) {
-		Logger::error("Unable to connect to server");
-		WSACleanup();
+bool ClientGetBinFileStream(
+	ClientHandle client,
+	const char* askId,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	BinFileChunkCallback callback,
+	void* userData,
+	FileInfo* fileInfo
+) {
+	if (!client) {
 		return false;
 	}
-
-	Logger::info("Client initialized successfully");
-	isInitialized = true;
-	return true;
+	return client->client.getBinFileStream(askId, productSeries, applicableProjects, customizeId,
+		callback, userData, fileInfo);
 }
 
-int SendData(
+bool ClientGetBinFileToPath(
+	ClientHandle client,
 	const char* askId,
 	const char* productSeries,
 	const char* applicableProjects,
 	const char* customizeId,
-	bool isGetFile = false
+	const char* destinationPath,
+	FileInfo* fileInfo
 ) {
-	if (!isInitialized || ConnectSocket == INVALID_SOCKET) {
-		Logger::error("Attempt to send data while not initialized");
-		return -1;
+	if (!client) {
+		return false;
 	}
+	return client->client.getBinFileToPath(askId, productSeries, applicableProjects, customizeId,
+		destinationPath, fileInfo);
+}
 
-	Logger::info("Sending data to server...");
+MainAppInfo* ClientGetMainAppInfo(ClientHandle client, const char* productSeries, const char* applicableProjects, const char* customizeId)
+{
+	if (!client) {
+		return nullptr;
+	}
+	return client->client.getMainAppInfo(productSeries, applicableProjects, customizeId);
+}
 
-	std::time_t timestamp = getCurrentTimestamp();
-	json askContent = { {"productSeries", productSeries}, {"applicableProjects", applicableProjects}, {"customizeId", customizeId} };
-	json data = {
-		{"timestamp", timestamp},
-		{"askId", askId},
-		{"askContent", askContent},
-		{"isGetFile", isGetFile}
-	};
+DefaultParametersInfo* ClientGetDefaultParametersInfo(ClientHandle client, const char* productSeries, const char* applicableProjects, const char* customizeId)
+{
+	if (!client) {
+		return nullptr;
+	}
+	return client->client.getDefaultParametersInfo(productSeries, applicableProjects, customizeId);
+}
 
-	std::string jsonStr = data.dump();
+bool ClientGetBatch(ClientHandle client, const BatchQuery* queries, int count, BatchResult* results)
+{
+	if (!client) {
+		return false;
+	}
+	return client->client.getBatch(queries, count, results);
+}
 
-	int iResult = send(ConnectSocket, jsonStr.c_str(), (int)jsonStr.length(), 0);
-	if (iResult == SOCKET_ERROR) {
-		Logger::error("Send failed with error: " + std::to_string(WSAGetLastError()));
-		return -1;
+void ClientSetInfoCacheTtl(ClientHandle client, int ttlMs)
+{
+	if (client) {
+		client->client.setInfoCacheTtl(ttlMs);
 	}
+}
 
-	Logger::info("Data sent successfully: " + std::to_string(iResult) + " bytes");
-	return iResult;
+void ClientInvalidateInfoCache(ClientHandle client)
+{
+	if (client) {
+		client->client.invalidateInfoCache();
+	}
 }
 
-FileInfo* GetBinFileInfo(
+AsyncRequest ClientGetBinFileInfoAsync(
+	ClientHandle client,
 	const char* askId,
 	const char* productSeries,
 	const char* applicableProjects,
-	const char* customizeId
+	const char* customizeId,
+	AsyncCompletionCallback callback,
+	void* userData
 ) {
-	if (!isInitialized || ConnectSocket == INVALID_SOCKET) {
-		Logger::error("GetBinFileInfo called while not initialized");
+	if (!client) {
 		return nullptr;
 	}
+	return getBinFileInfoAsync(client->client, askId, productSeries, applicableProjects, customizeId, nullptr,
+		callback, userData);
+}
 
-	Logger::info("Getting binary file info...");
-
-	// oeШDT
-	int sendResult = SendData(askId, productSeries, applicableProjects, customizeId, true);
-	if (sendResult <= 0) {
-		Logger::error("Failed to send data request for binary file info");
+AsyncRequest ClientGetBinFileInfoIfModifiedAsync(
+	ClientHandle client,
+	const char* askId,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	const char* knownVersion,
+	AsyncCompletionCallback callback,
+	void* userData
+) {
+	if (!client) {
 		return nullptr;
 	}
+	return getBinFileInfoAsync(client->client, askId, productSeries, applicableProjects, customizeId, knownVersion,
+		callback, userData);
+}
 
-	//  JSON header
-	char headerBuffer[4096];
-	int headerResult = recv(ConnectSocket, headerBuffer, 4096, 0);
-	if (headerResult <= 0) {
-		Logger::error("Failed to receive header data. Result: " + std::to_string(headerResult));
+AsyncRequest ClientGetBinFileStreamAsync(
+	ClientHandle client,
+	const char* askId,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	BinFileChunkCallback chunkCallback,
+	void* chunkUserData,
+	AsyncCompletionCallback callback,
+	void* userData
+) {
+	if (!client) {
 		return nullptr;
 	}
-	headerBuffer[headerResult] = '\0';
-
-	try {
-		// ѪR JSON header
-		auto headerJson = json::parse(headerBuffer);
-		if (headerJson["status"] == "error") {
-			std::string message = headerJson["message"];
-			Logger::error(message);
-			return nullptr;
-		}
+	return getBinFileStreamAsync(client->client, askId, productSeries, applicableProjects, customizeId,
+		chunkCallback, chunkUserData, callback, userData);
+}
 
-		size_t fileSize = headerJson["fileSize"];
-		std::string fileName = headerJson["fileName"];
-
-		// إ FileInfo c
-		FileInfo* fileInfo = new FileInfo();
-		fileInfo->data = new char[fileSize];
-		fileInfo->size = fileSize;
-		strncpy_s(fileInfo->fileName, fileName.c_str(), sizeof(fileInfo->fileName) - 1);
-
-		// ɮפe
-		size_t totalReceived = 0;
-		char buffer[4096];
-
-		Logger::info("Starting file content reception");
-		while (totalReceived < fileSize) {
-			int bytesReceived = recv(ConnectSocket, buffer,
-				min(sizeof(buffer), (int)fileSize - (int)totalReceived), 0);
-			if (bytesReceived <= 0) {
-				Logger::error("Failed to receive file content. Bytes received: " +
-					std::to_string(bytesReceived) +
-					", Total received so far: " + std::to_string(totalReceived) +
-					" of " + std::to_string(fileSize));
-				delete[] fileInfo->data;
-				delete fileInfo;
-				return nullptr;
-			}
-
-			memcpy(fileInfo->data + totalReceived, buffer, bytesReceived);
-			totalReceived += bytesReceived;
-		}
+AsyncRequest ClientGetBinFileToPathAsync(
+	ClientHandle client,
+	const char* askId,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	const char* destinationPath,
+	AsyncCompletionCallback callback,
+	void* userData
+) {
+	if (!client) {
+		return nullptr;
+	}
+	return getBinFileToPathAsync(client->client, askId, productSeries, applicableProjects, customizeId,
+		destinationPath, callback, userData);
+}
 
-		Logger::info("Successfully received file: " + fileName);
-		return fileInfo;
+AsyncRequest ClientGetMainAppInfoAsync(
+	ClientHandle client,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	AsyncCompletionCallback callback,
+	void* userData
+) {
+	if (!client) {
+		return nullptr;
 	}
-	catch (const json::exception& e) {
-		Logger::error("JSON parsing error in GetBinFileInfo: " + std::string(e.what()) +
-			"\nHeader content: " + std::string(headerBuffer));
+	return getMainAppInfoAsync(client->client, productSeries, applicableProjects, customizeId, callback, userData);
+}
+
+AsyncRequest ClientGetDefaultParametersInfoAsync(
+	ClientHandle client,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	AsyncCompletionCallback callback,
+	void* userData
+) {
+	if (!client) {
 		return nullptr;
 	}
-	catch (const std::exception& e) {
-		Logger::error("Unexpected error in GetBinFileInfo: " + std::string(e.what()));
+	return getDefaultParametersInfoAsync(client->client, productSeries, applicableProjects, customizeId,
+		callback, userData);
+}
+
+AsyncRequest ClientGetBatchAsync(
+	ClientHandle client,
+	const BatchQuery* queries,
+	int count,
+	BatchResult* results,
+	AsyncCompletionCallback callback,
+	void* userData
+) {
+	if (!client) {
 		return nullptr;
 	}
+	return getBatchAsync(client->client, queries, count, results, callback, userData);
 }
 
-void FreeFileInfo(FileInfo* fileInfo)
+bool ClientGetMetrics(ClientHandle client, ClientMetrics* metrics)
 {
-	if (fileInfo) {
-		delete[] fileInfo->data;
-		delete fileInfo;
+	if (!client) {
+		return false;
 	}
+	return client->client.getMetrics(metrics);
 }
 
-MainAppInfo* GetMainAppInfo(const char* productSeries, const char* applicableProjects, const char* customizeId) {
-	if (!isInitialized || ConnectSocket == INVALID_SOCKET) {
-		Logger::error("GetMainAppInfo called while not initialized");
-		return nullptr;
+bool ClientDumpMetrics(ClientHandle client, const char* path)
+{
+	if (!client) {
+		return false;
 	}
+	return client->client.dumpMetrics(path);
+}
 
-	Logger::info("Getting main app info...");
+bool InitializeClient(
+	const char* stationType,
+	const char* stationName,
+	const char* stationId,
+	const char* operatorId
+) {
+	return defaultClient().initialize(stationType, stationName, stationId, operatorId);
+}
 
-	// oeШDT
-	int sendResult = SendData("MainApp", productSeries, applicableProjects, customizeId, false);
-	if (sendResult <= 0) {
-		Logger::error("Failed to send data request for main app info");
-		return nullptr;
-	}
+int SendData(
+	const char* askId,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	bool isGetFile = false
+) {
+	return defaultClient().sendData(askId, productSeries, applicableProjects, customizeId, isGetFile);
+}
 
-	//  JSON header
-	char headerBuffer[4096];
-	int headerResult = recv(ConnectSocket, headerBuffer, 4096, 0);
-	if (headerResult <= 0) {
-		Logger::error("Failed to receive header data. Result: " + std::to_string(headerResult));
-		return nullptr;
-	}
-	headerBuffer[headerResult] = '\0';
+FileInfo* GetBinFileInfo(
+	const char* askId,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId
+) {
+	return defaultClient().getBinFileInfo(askId, productSeries, applicableProjects, customizeId);
+}
 
-	try {
-		// ѪR JSON header
-		auto headerJson = json::parse(headerBuffer);
-		if (headerJson["status"] == "error") {
-			std::string message = headerJson["message"];
-			Logger::error(message);
-			return nullptr;
-		}
+FileInfo* GetBinFileInfoIfModified(
+	const char* askId,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	const char* knownVersion,
+	bool* notModified
+) {
+	return defaultClient().getBinFileInfoIfModified(askId, productSeries, applicableProjects, customizeId,
+		knownVersion, notModified);
+}
 
-		std::string version = headerJson["Version"];
-		std::string blVersion = headerJson["BLVersion"];
-		int calibrationOffset = headerJson["CalibrationOffset"];
+bool GetBinFileStream(
+	const char* askId,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	BinFileChunkCallback callback,
+	void* userData,
+	FileInfo* fileInfo
+) {
+	return defaultClient().getBinFileStream(askId, productSeries, applicableProjects, customizeId,
+		callback, userData, fileInfo);
+}
 
-		MainAppInfo* mainAppInfo = new MainAppInfo();
-		strncpy_s(mainAppInfo->version, version.c_str(), sizeof(mainAppInfo->version) - 1);
-		strncpy_s(mainAppInfo->blVersion, blVersion.c_str(), sizeof(mainAppInfo->blVersion) - 1);
-		mainAppInfo->calibrationOffset = calibrationOffset;
+bool GetBinFileToPath(
+	const char* askId,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	const char* destinationPath,
+	FileInfo* fileInfo
+) {
+	return defaultClient().getBinFileToPath(askId, productSeries, applicableProjects, customizeId,
+		destinationPath, fileInfo);
+}
 
-		Logger::info("Successfully retrieved main app info");
-		return mainAppInfo;
-	}
-	catch (const json::exception& e) {
-		Logger::error("JSON parsing error in GetMainAppInfo: " + std::string(e.what()) +
-			"\nHeader content: " + std::string(headerBuffer));
-		return nullptr;
-	}
-	catch (const std::exception& e) {
-		Logger::error("Unexpected error in GetMainAppInfo: " + std::string(e.what()));
-		return nullptr;
+void FreeFileInfo(FileInfo* fileInfo)
+{
+	if (fileInfo) {
+		// ѧ֨Ѫɮ׬MgO
+		if (!UnmapFile(fileInfo->data)) {
+			delete[] fileInfo->data;
+		}
+		delete fileInfo;
 	}
 }
 
+MainAppInfo* GetMainAppInfo(const char* productSeries, const char* applicableProjects, const char* customizeId) {
+	return defaultClient().getMainAppInfo(productSeries, applicableProjects, customizeId);
+}
+
 DefaultParametersInfo* GetDefaultParametersInfo(const char* productSeries, const char* applicableProjects, const char* customizeId) {
-	if (!isInitialized || ConnectSocket == INVALID_SOCKET) {
-		Logger::error("GetDefaultParametersInfo called while not initialized");
-		return nullptr;
-	}
+	return defaultClient().getDefaultParametersInfo(productSeries, applicableProjects, customizeId);
+}
 
-	Logger::info("Getting default parameters info...");
+bool GetBatch(const BatchQuery* queries, int count, BatchResult* results) {
+	return defaultClient().getBatch(queries, count, results);
+}
 
-	// oeШDT
-	int sendResult = SendData("DefaultParameters", productSeries, applicableProjects, customizeId, false);
-	if (sendResult <= 0) {
-		Logger::error("Failed to send data request for default parameters");
-		return nullptr;
+void FreeBatchResults(BatchResult* results, int count)
+{
+	if (!results) {
+		return;
 	}
-
-	//  JSON header
-	char headerBuffer[4096];
-	int headerResult = recv(ConnectSocket, headerBuffer, 4096, 0);
-	if (headerResult <= 0) {
-		Logger::error("Failed to receive header data. Result: " + std::to_string(headerResult));
-		return nullptr;
+	for (int i = 0; i < count; i++) {
+		delete results[i].mainAppInfo;
+		delete results[i].defaultParametersInfo;
+		FreeFileInfo(results[i].fileInfo);
+		results[i].mainAppInfo = nullptr;
+		results[i].defaultParametersInfo = nullptr;
+		results[i].fileInfo = nullptr;
 	}
-	headerBuffer[headerResult] = '\0';
+}
 
-	try {
-		// ѪR JSON header
-		auto headerJson = json::parse(headerBuffer);
-		if (headerJson["status"] == "error") {
-			std::string message = headerJson["message"];
-			Logger::error(message);
-			return nullptr;
-		}
+void SetInfoCacheTtl(int ttlMs) {
+	defaultClient().setInfoCacheTtl(ttlMs);
+}
 
-		std::string version = headerJson["Version"];
-		std::string blVersion = headerJson["BLVersion"];
-
-		DefaultParametersInfo* defaultParaInfo = new DefaultParametersInfo();
-		strncpy_s(defaultParaInfo->version, version.c_str(), sizeof(defaultParaInfo->version) - 1);
-		strncpy_s(defaultParaInfo->blVersion, blVersion.c_str(), sizeof(defaultParaInfo->blVersion) - 1);
-		defaultParaInfo->calibrationOffset = headerJson["CalibrationOffset"];
-		
-		defaultParaInfo->shieldedZoneCount = headerJson["ShieldedZoneCount"];
-		auto& zones = headerJson["ShieldedZone"];
-		for (int i = 0; i < defaultParaInfo->shieldedZoneCount && i < 50; i++) {
-			defaultParaInfo->shieldedZone[i].start = zones[i]["start"];
-			defaultParaInfo->shieldedZone[i].end = zones[i]["end"];
-		}
+void InvalidateInfoCache() {
+	defaultClient().invalidateInfoCache();
+}
 
-		Logger::info("Successfully retrieved default parameters info");
-		return defaultParaInfo;
-	}
-	catch (const json::exception& e) {
-		Logger::error("JSON parsing error in GetDefaultParametersInfo: " + std::string(e.what()) +
-			"\nHeader content: " + std::string(headerBuffer));
-		return nullptr;
-	}
-	catch (const std::exception& e) {
-		Logger::error("Unexpected error in GetDefaultParametersInfo: " + std::string(e.what()));
-		return nullptr;
-	}
+AsyncRequest GetBinFileInfoAsync(
+	const char* askId,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	AsyncCompletionCallback callback,
+	void* userData
+) {
+	return getBinFileInfoAsync(defaultClient(), askId, productSeries, applicableProjects, customizeId, nullptr,
+		callback, userData);
 }
 
-int ReceiveData(char* buffer, int bufferSize) {
-	if (!isInitialized || ConnectSocket == INVALID_SOCKET) {
-		return -1;
-	}
+AsyncRequest GetBinFileInfoIfModifiedAsync(
+	const char* askId,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	const char* knownVersion,
+	AsyncCompletionCallback callback,
+	void* userData
+) {
+	return getBinFileInfoAsync(defaultClient(), askId, productSeries, applicableProjects, customizeId, knownVersion,
+		callback, userData);
+}
 
-	int iResult = recv(ConnectSocket, buffer, bufferSize, 0);
-	if (iResult > 0) {
-		// TOrŦפ
-		buffer[iResult] = '\0';
-	}
-	return iResult;
+AsyncRequest GetBinFileStreamAsync(
+	const char* askId,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	BinFileChunkCallback chunkCallback,
+	void* chunkUserData,
+	AsyncCompletionCallback callback,
+	void* userData
+) {
+	return getBinFileStreamAsync(defaultClient(), askId, productSeries, applicableProjects, customizeId,
+		chunkCallback, chunkUserData, callback, userData);
 }
 
-bool CloseConnection() {
-	Logger::info("Closing connection...");
-	if (ConnectSocket != INVALID_SOCKET) {
-		// oe_}sШD
-		json disconnectRequest;
-		disconnectRequest["command"] = "disconnect";
-		std::string jsonStr = disconnectRequest.dump();
-
-		Logger::debug("Sending disconnect request");
-		int sendResult = send(ConnectSocket, jsonStr.c_str(), (int)jsonStr.length(), 0);
-
-		if (sendResult == SOCKET_ERROR) {
-			// oeѡAsɵoͿ~
-			Logger::error("Failed to send disconnect request: " + std::to_string(WSAGetLastError()));
-			return false;
-		}
+AsyncRequest GetBinFileToPathAsync(
+	const char* askId,
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	const char* destinationPath,
+	AsyncCompletionCallback callback,
+	void* userData
+) {
+	return getBinFileToPathAsync(defaultClient(), askId, productSeries, applicableProjects, customizeId,
+		destinationPath, callback, userData);
+}
 
-		// ݤ@pqɶATOAȾШD
-		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+AsyncRequest GetMainAppInfoAsync(
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	AsyncCompletionCallback callback,
+	void* userData
+) {
+	return getMainAppInfoAsync(defaultClient(), productSeries, applicableProjects, customizeId, callback, userData);
+}
 
-		if (shutdown(ConnectSocket, SD_SEND) == SOCKET_ERROR) {
-			// oeqDɵoͿ~
-			Logger::error("shutdown failed with error: " + std::to_string(WSAGetLastError()));
-			return false;
-		}
+AsyncRequest GetDefaultParametersInfoAsync(
+	const char* productSeries,
+	const char* applicableProjects,
+	const char* customizeId,
+	AsyncCompletionCallback callback,
+	void* userData
+) {
+	return getDefaultParametersInfoAsync(defaultClient(), productSeries, applicableProjects, customizeId,
+		callback, userData);
+}
 
-		if (closesocket(ConnectSocket) == SOCKET_ERROR) {
-			//  socket ɵoͿ~
-			Logger::error("closesocket failed with error: " + std::to_string(WSAGetLastError()));
-			return false;
-		}
+AsyncRequest GetBatchAsync(
+	const BatchQuery* queries,
+	int count,
+	BatchResult* results,
+	AsyncCompletionCallback callback,
+	void* userData
+) {
+	return getBatchAsync(defaultClient(), queries, count, results, callback, userData);
+}
 
-		ConnectSocket = INVALID_SOCKET;
+bool WaitAsyncRequest(AsyncRequest request, int timeoutMs)
+{
+	if (!request) {
+		return false;
 	}
-	if (isInitialized) {
-		if (WSACleanup() == SOCKET_ERROR) {
-			// Mz Windows Sockets ɵoͿ~
-			Logger::error("WSACleanup failed with error: " + std::to_string(WSAGetLastError()));
-			return false;
-		}
-		isInitialized = false;
+	return request->wait(timeoutMs);
+}
+
+bool TakeAsyncResult(AsyncRequest request, AsyncResult* result)
+{
+	if (!request || !result) {
+		return false;
+	}
+	return request->take(*result);
+}
+
+void FreeAsyncRequest(AsyncRequest request)
+{
+	if (request) {
+		request->release();
 	}
+}
+
+int ReceiveData(char* buffer, int bufferSize) {
+	return defaultClient().receiveData(buffer, bufferSize);
+}
+
+bool CloseConnection() {
+	bool closed = defaultClient().closeConnection();
+	Logger::shutdown();
+	return closed;
+}
+
+bool GetClientMetrics(ClientMetrics* metrics) {
+	return defaultClient().getMetrics(metrics);
+}
 
-	// 
-	Logger::info("Connection closed successfully");
-	return true;
+bool DumpClientMetrics(const char* path) {
+	return defaultClient().dumpMetrics(path);
 }
 
 //BOOL APIENTRY DllMain(
@@ -535,4 +720,4 @@ bool CloseConnection() {
 //		break;
 //	}
 //	return TRUE;
-//}
\ No newline at end of file
+//}
@@ -1,10 +1,16 @@
 #pragma once
 
+#if defined(SOCKETCLIENT_STATIC)
+#define SOCKETCLIENT_API
+#elif defined(_WIN32)
 #ifdef SOCKETCLIENT_EXPORTS
 #define SOCKETCLIENT_API __declspec(dllexport)
 #else
 #define SOCKETCLIENT_API __declspec(dllimport)
 #endif // SOCKETCLIENT_EXPORTS
+#else
+#define SOCKETCLIENT_API __attribute__((visibility("default")))
+#endif // _WIN32
 
 #include <string>
 #include <fstream>
@@ -15,6 +21,7 @@ extern "C" {
         char* data;
         size_t size;
         char fileName[256];
+        char version[256];      // AȾ^ɮתAiǵ GetBinFileInfoIfModifiedFѮɬŦr
     };
 
     struct MainAppInfo {
@@ -92,6 +99,76 @@ extern "C" {
         const char* customizeId
     );
 
+    /// <summary>
+    /// .binɮ׸TGШDawɮתAAȾۦPɤǰeɮפe
+    /// </summary>
+    /// <param name="askId">I</param>
+    /// <param name="productSeries">~tC</param>
+    /// <param name="applicableProjects">AαM</param>
+    /// <param name="customizeId">ȻsID</param>
+    /// <param name="knownVersion">wɮת (e FileInfo::version)ANULL ΪŦrɦP GetBinFileInfo</param>
+    /// <param name="notModified">i NULLAۦPɳ] true</param>
+    /// <returns>ɮפwsɦ^ɮ׸TFۦPΥѮɦ^ NULLAH notModified Ϥ</returns>
+    SOCKETCLIENT_API FileInfo* GetBinFileInfoIfModified(
+        const char* askId,
+        const char* productSeries,
+        const char* applicableProjects,
+        const char* customizeId,
+        const char* knownVersion,
+        bool* notModified
+    );
+
+    /// <summary>
+    /// y^IAC@Ӱ϶Is@
+    /// </summary>
+    /// <param name="data">϶ơAȦb^I</param>
+    /// <param name="size">϶jp</param>
+    /// <param name="offset">϶bɮפm</param>
+    /// <param name="fileSize">ɮ`jp</param>
+    /// <param name="userData">IsݶǤJ</param>
+    /// <returns>true ~򱵦Afalse </returns>
+    typedef bool (*BinFileChunkCallback)(const char* data, size_t size, size_t offset, size_t fileSize, void* userData);
+
+    /// <summary>
+    /// Hy覡.binɮסA䱵浹^IBzAOdɮ
+    /// </summary>
+    /// <param name="askId">I</param>
+    /// <param name="productSeries">~tC</param>
+    /// <param name="applicableProjects">AαM</param>
+    /// <param name="customizeId">ȻsID</param>
+    /// <param name="callback">϶^I</param>
+    /// <param name="userData">ǵ^I</param>
+    /// <param name="fileInfo">i NULLA\ɶJɦWPjp (data  NULL)</param>
+    /// <returns>true ܧ㱵</returns>
+    SOCKETCLIENT_API bool GetBinFileStream(
+        const char* askId,
+        const char* productSeries,
+        const char* applicableProjects,
+        const char* customizeId,
+        BinFileChunkCallback callback,
+        void* userData,
+        FileInfo* fileInfo
+    );
+
+    /// <summary>
+    /// .binɮרêgJw|AgJ destinationPath.partAW
+    /// </summary>
+    /// <param name="askId">I</param>
+    /// <param name="productSeries">~tC</param>
+    /// <param name="applicableProjects">AαM</param>
+    /// <param name="customizeId">ȻsID</param>
+    /// <param name="destinationPath">تɮ׸|</param>
+    /// <param name="fileInfo">i NULLA\ɶJɦWPjp (data  NULL)</param>
+    /// <returns>true ɮפwgJ</returns>
+    SOCKETCLIENT_API bool GetBinFileToPath(
+        const char* askId,
+        const char* productSeries,
+        const char* applicableProjects,
+        const char* customizeId,
+        const char* destinationPath,
+        FileInfo* fileInfo
+    );
+
     /// <summary>
     /// 귽AYɮ׻귽
     /// </summary>
@@ -114,4 +191,535 @@ extern "C" {
     /// <param name="customizeId">ȻsID</param>
     /// <returns></returns>
     SOCKETCLIENT_API DefaultParametersInfo* GetDefaultParametersInfo(const char* productSeries, const char* applicableProjects, const char* customizeId);
+
+    /// <summary>
+    /// 妸ШD
+    /// </summary>
+    enum BatchQueryType
+    {
+        BATCH_QUERY_MAIN_APP,
+        BATCH_QUERY_DEFAULT_PARAMETERS,
+        BATCH_QUERY_BIN_FILE,
+    };
+
+    struct BatchQuery
+    {
+        BatchQueryType type;
+        const char* askId;              // IA BATCH_QUERY_BIN_FILE ϥ
+        const char* productSeries;
+        const char* applicableProjects;
+        const char* customizeId;
+    };
+
+    struct BatchResult
+    {
+        BatchQueryType type;
+        bool success;
+        char message[256];              // ѭ]
+        //  type J䤤@Al NULLFH FreeBatchResults 
+        MainAppInfo* mainAppInfo;
+        DefaultParametersInfo* defaultParametersInfo;
+        FileInfo* fileInfo;
+    };
+
+    /// <summary>
+    /// H@ШDohT (Ҧp MainAppBDefaultParameters P .bin ɮ)Auݤ@
+    /// ӧOإѤvTL
+    /// </summary>
+    /// <param name="queries">ШD</param>
+    /// <param name="count">ؼ</param>
+    /// <param name="results">Isݰtm count ӵGA queries ǶJ</param>
+    /// <returns>Ҧس\ɦ^ true</returns>
+    SOCKETCLIENT_API bool GetBatch(const BatchQuery* queries, int count, BatchResult* results);
+
+    /// <summary>
+    ///  GetBatch GTPɮסAresults }CѩIs
+    /// </summary>
+    SOCKETCLIENT_API void FreeBatchResults(BatchResult* results, int count);
+
+    /// <summary>
+    /// ]w GetMainAppInfo / GetDefaultParametersInfo O֨Ĵ
+    /// ĴۦPѼƪШD^ǧ֨eƥAgL
+    /// </summary>
+    /// <param name="ttlMs">Ĵ (@)A0 ܤ֨FܧɲMw֨e</param>
+    SOCKETCLIENT_API void SetInfoCacheTtl(int ttlMs);
+
+    /// <summary>
+    /// M GetMainAppInfo / GetDefaultParametersInfo ֨eAUШDsVAȾd
+    /// </summary>
+    SOCKETCLIENT_API void InvalidateInfoCache();
+
+    /// <summary>
+    /// ȤݹҥNXACӹҾ֦ۤvsu
+    /// P@ҥiѦhӰPɩIsACӽШDUۭɥΤ@su
+    /// W褣aҰѼƪ禡ϥε{ww]
+    /// </summary>
+    typedef struct SocketClientHandle* ClientHandle;
+
+    /// <summary>
+    /// ǿh@
+    /// </summary>
+    enum TransportBackend
+    {
+        TRANSPORT_DEFAULT,      // Windows  WinsockALinux  epoll
+        TRANSPORT_IO_URING,     // Linux 6.0 HW io_uringA䴩ɨϥιw]@
+    };
+
+    /// <summary>
+    /// Ȥݳ]wAH InitClientOptions Jw]ȦAקݭn
+    /// </summary>
+    struct ClientOptions
+    {
+        int poolSize;       // sujpAYPɶi檺ШDƤWAlƮɹwإߡAj 1 ɤiϥ SendData / ReceiveDataFw] 1
+        int idleTimeoutMs;  // msuOdɶ (@)AWLAUШDssuFw] 60000
+        const char* cacheDirectory;         // .bin ɮק֨ؿANULL ΪŦrܤϥΧ֨Fw] NULL
+        unsigned long long cacheMaxBytes;   // ֨jpW (줸)AWLɧR̤[ϥΪɮסA0 ܤFw] 0
+        int infoCacheTtlMs;                 // MainApp / DefaultParameters TO֨Ĵ (@)A0 ܤ֨Fw] 0
+        int pipelineDepth;                  // CsuPɶi檺ШDƤWAj 1 ɱҥκ޽u (iϥ SendData / ReceiveData)Fw] 1
+        TransportBackend transportBackend;  // ǿh@ATRANSPORT_IO_URING AXPɤUjqɮתhDFw] TRANSPORT_DEFAULT
+        int rangeConnections;               // j .bin ɮפqPɤUsu (GetBinFileInfo / GetBinFileToPath)A1 ܤqFw] 1
+        int resumeAttempts;                 // .bin ɮפU_ɭssuñq_m~ASseɳs򭫸ժƤWA0 ܤǡFw] 3
+    };
+
+    /// <summary>
+    /// Jw]Ȥݳ]w
+    /// </summary>
+    SOCKETCLIENT_API void InitClientOptions(ClientOptions* options);
+
+    /// <summary>
+    /// إ߫Ȥݹ
+    /// </summary>
+    /// <returns>ҥNXAϥΧݩIs DestroyClient</returns>
+    SOCKETCLIENT_API ClientHandle CreateClient();
+
+    /// <summary>
+    /// Hw]wإ߫Ȥݹ
+    /// </summary>
+    /// <param name="options">Ȥݳ]wANULL ܨϥιw]</param>
+    /// <returns>ҥNXAϥΧݩIs DestroyClient</returns>
+    SOCKETCLIENT_API ClientHandle CreateClientWithOptions(const ClientOptions* options);
+
+    /// <summary>
+    /// suȤݹ
+    /// </summary>
+    /// <param name="client">ҥNX</param>
+    SOCKETCLIENT_API void DestroyClient(ClientHandle client);
+
+    /// <summary>
+    /// lƫȤݹҨósܪAȾAѼƦP InitializeClient
+    /// </summary>
+    SOCKETCLIENT_API bool ClientInitialize(
+        ClientHandle client,
+        const char* stationType,
+        const char* stationName,
+        const char* stationId,
+        const char* operatorId
+    );
+
+    /// <summary>
+    /// ǰeơAѼƦP SendData
+    /// </summary>
+    SOCKETCLIENT_API int ClientSendData(
+        ClientHandle client,
+        const char* askId,
+        const char* productSeries,
+        const char* applicableProjects,
+        const char* customizeId,
+        bool isGetFile
+    );
+
+    /// <summary>
+    /// ƾڡAѼƦP ReceiveData
+    /// </summary>
+    SOCKETCLIENT_API int ClientReceiveData(ClientHandle client, char* buffer, int bufferSize);
+
+    /// <summary>
+    /// ҪҦsuAҤiAl
+    /// </summary>
+    SOCKETCLIENT_API bool ClientCloseConnection(ClientHandle client);
+
+    /// <summary>
+    /// .binɮ׸TAѼƦP GetBinFileInfo
+    /// </summary>
+    SOCKETCLIENT_API FileInfo* ClientGetBinFileInfo(
+        ClientHandle client,
+        const char* askId,
+        const char* productSeries,
+        const char* applicableProjects,
+        const char* customizeId
+    );
+
+    /// <summary>
+    /// .binɮ׸TAѼƦP GetBinFileInfoIfModified
+    /// </summary>
+    SOCKETCLIENT_API FileInfo* ClientGetBinFileInfoIfModified(
+        ClientHandle client,
+        const char* askId,
+        const char* productSeries,
+        const char* applicableProjects,
+        const char* customizeId,
+        const char* knownVersion,
+        bool* notModified
+    );
+
+    /// <summary>
+    /// Hy覡.binɮסAѼƦP GetBinFileStream
+    /// </summary>
+    SOCKETCLIENT_API bool ClientGetBinFileStream(
+        ClientHandle client,
+        const char* askId,
+        const char* productSeries,
+        const char* applicableProjects,
+        const char* customizeId,
+        BinFileChunkCallback callback,
+        void* userData,
+        FileInfo* fileInfo
+    );
+
+    /// <summary>
+    /// .binɮרügJw|AѼƦP GetBinFileToPath
+    /// </summary>
+    SOCKETCLIENT_API bool ClientGetBinFileToPath(
+        ClientHandle client,
+        const char* askId,
+        const char* productSeries,
+        const char* applicableProjects,
+        const char* customizeId,
+        const char* destinationPath,
+        FileInfo* fileInfo
+    );
+
+    /// <summary>
+    /// uWsɸTAѼƦP GetMainAppInfo
+    /// </summary>
+    SOCKETCLIENT_API MainAppInfo* ClientGetMainAppInfo(ClientHandle client, const char* productSeries, const char* applicableProjects, const char* customizeId);
+
+    /// <summary>
+    /// uWsѼƸTAѼƦP GetDefaultParametersInfo
+    /// </summary>
+    SOCKETCLIENT_API DefaultParametersInfo* ClientGetDefaultParametersInfo(ClientHandle client, const char* productSeries, const char* applicableProjects, const char* customizeId);
+
+    /// <summary>
+    /// 妸ШDAѼƦP GetBatch
+    /// </summary>
+    SOCKETCLIENT_API bool ClientGetBatch(ClientHandle client, const BatchQuery* queries, int count, BatchResult* results);
+
+    /// <summary>
+    /// ]wҪT֨ĴAѼƦP SetInfoCacheTtl
+    /// </summary>
+    SOCKETCLIENT_API void ClientSetInfoCacheTtl(ClientHandle client, int ttlMs);
+
+    /// <summary>
+    /// MҪT֨
+    /// </summary>
+    SOCKETCLIENT_API void ClientInvalidateInfoCache(ClientHandle client);
+
+    /// <summary>
+    /// DPBШDNXAШDb{w I/O WAIs
+    /// H TakeAsyncResult oGAϥΧݩIs FreeAsyncRequest
+    /// </summary>
+    typedef struct SocketClientAsyncRequest* AsyncRequest;
+
+    /// <summary>
+    /// DPBШD^IAb I/O WIsAɧ֪^
+    /// ^IiIs TakeAsyncResultAiP@ҩIs DestroyClient
+    /// </summary>
+    /// <param name="request">ШD</param>
+    /// <param name="userData">IsݶǤJ</param>
+    typedef void (*AsyncCompletionCallback)(AsyncRequest request, void* userData);
+
+    /// <summary>
+    /// DPBШDGA̽ШD禡JAl NULL
+    /// </summary>
+    struct AsyncResult
+    {
+        bool success;
+        bool notModified;                               // GetBinFileInfoIfModifiedAsyncGۦP
+        FileInfo* fileInfo;                             // .bin ɮ׽ШDAH FreeFileInfo FStream / ToPath  data  NULL
+        MainAppInfo* mainAppInfo;                       // GetMainAppInfoAsyncAH delete 
+        DefaultParametersInfo* defaultParametersInfo;   // GetDefaultParametersInfoAsyncAH delete 
+    };
+
+    /// <summary>
+    /// DPB.binɮ׸TAѼƦP GetBinFileInfo
+    /// </summary>
+    /// <param name="callback">^IAi NULL (H WaitAsyncRequest )</param>
+    /// <param name="userData">ǵ^I</param>
+    /// <returns>ШDNXAѮɦ^ NULL</returns>
+    SOCKETCLIENT_API AsyncRequest GetBinFileInfoAsync(
+        const char* askId,
+        const char* productSeries,
+        const char* applicableProjects,
+        const char* customizeId,
+        AsyncCompletionCallback callback,
+        void* userData
+    );
+
+    /// <summary>
+    /// DPB.binɮ׸TAѼƦP GetBinFileInfoIfModifiedAۦP AsyncResult::notModified  true
+    /// </summary>
+    SOCKETCLIENT_API AsyncRequest GetBinFileInfoIfModifiedAsync(
+        const char* askId,
+        const char* productSeries,
+        const char* applicableProjects,
+        const char* customizeId,
+        const char* knownVersion,
+        AsyncCompletionCallback callback,
+        void* userData
+    );
+
+    /// <summary>
+    /// DPBHy覡.binɮסA϶^Ib I/O WIsAlѼƦP GetBinFileStream
+    /// </summary>
+    SOCKETCLIENT_API AsyncRequest GetBinFileStreamAsync(
+        const char* askId,
+        const char* productSeries,
+        const char* applicableProjects,
+        const char* customizeId,
+        BinFileChunkCallback chunkCallback,
+        void* chunkUserData,
+        AsyncCompletionCallback callback,
+        void* userData
+    );
+
+    /// <summary>
+    /// DPB.binɮרügJw|AѼƦP GetBinFileToPath
+    /// </summary>
+    SOCKETCLIENT_API AsyncRequest GetBinFileToPathAsync(
+        const char* askId,
+        const char* productSeries,
+        const char* applicableProjects,
+        const char* customizeId,
+        const char* destinationPath,
+        AsyncCompletionCallback callback,
+        void* userData
+    );
+
+    /// <summary>
+    /// DPBuWsɸTAѼƦP GetMainAppInfo
+    /// </summary>
+    SOCKETCLIENT_API AsyncRequest GetMainAppInfoAsync(
+        const char* productSeries,
+        const char* applicableProjects,
+        const char* customizeId,
+        AsyncCompletionCallback callback,
+        void* userData
+    );
+
+    /// <summary>
+    /// DPBuWsѼƸTAѼƦP GetDefaultParametersInfo
+    /// </summary>
+    SOCKETCLIENT_API AsyncRequest GetDefaultParametersInfoAsync(
+        const char* productSeries,
+        const char* applicableProjects,
+        const char* customizeId,
+        AsyncCompletionCallback callback,
+        void* userData
+    );
+
+    /// <summary>
+    /// DPB妸ШDAѼƦP GetBatchFresults bШDeO
+    /// </summary>
+    SOCKETCLIENT_API AsyncRequest GetBatchAsync(
+        const BatchQuery* queries,
+        int count,
+        BatchResult* results,
+        AsyncCompletionCallback callback,
+        void* userData
+    );
+
+    /// <summary>
+    /// ݫDPBШD
+    /// </summary>
+    /// <param name="request">ШDNX</param>
+    /// <param name="timeoutMs">O (@)A0 ܥuˬdO_wAtƪܤ@</param>
+    /// <returns>wɦ^ true</returns>
+    SOCKETCLIENT_API bool WaitAsyncRequest(AsyncRequest request, int timeoutMs);
+
+    /// <summary>
+    /// oDPBШDGAGTPɮץѩIsAƩIsɬ NULL
+    /// </summary>
+    /// <param name="request">ШDNX</param>
+    /// <param name="result">Isݰtmc</param>
+    /// <returns>|ɦ^ false</returns>
+    SOCKETCLIENT_API bool TakeAsyncResult(AsyncRequest request, AsyncResult* result);
+
+    /// <summary>
+    /// ШDNXFШD|ɤ|~éIs^IAGb
+    /// </summary>
+    SOCKETCLIENT_API void FreeAsyncRequest(AsyncRequest request);
+
+    /// <summary>
+    /// DPB.binɮ׸TAѼƦP GetBinFileInfoAsync
+    /// </summary>
+    SOCKETCLIENT_API AsyncRequest ClientGetBinFileInfoAsync(
+        ClientHandle client,
+        const char* askId,
+        const char* productSeries,
+        const char* applicableProjects,
+        const char* customizeId,
+        AsyncCompletionCallback callback,
+        void* userData
+    );
+
+    /// <summary>
+    /// DPB.binɮ׸TAѼƦP GetBinFileInfoIfModifiedAsync
+    /// </summary>
+    SOCKETCLIENT_API AsyncRequest ClientGetBinFileInfoIfModifiedAsync(
+        ClientHandle client,
+        const char* askId,
+        const char* productSeries,
+        const char* applicableProjects,
+        const char* customizeId,
+        const char* knownVersion,
+        AsyncCompletionCallback callback,
+        void* userData
+    );
+
+    /// <summary>
+    /// DPBHy覡.binɮסAѼƦP GetBinFileStreamAsync
+    /// </summary>
+    SOCKETCLIENT_API AsyncRequest ClientGetBinFileStreamAsync(
+        ClientHandle client,
+        const char* askId,
+        const char* productSeries,
+        const char* applicableProjects,
+        const char* customizeId,
+        BinFileChunkCallback chunkCallback,
+        void* chunkUserData,
+        AsyncCompletionCallback callback,
+        void* userData
+    );
+
+    /// <summary>
+    /// DPB.binɮרügJw|AѼƦP GetBinFileToPathAsync
+    /// </summary>
+    SOCKETCLIENT_API AsyncRequest ClientGetBinFileToPathAsync(
+        ClientHandle client,
+        const char* askId,
+        const char* productSeries,
+        const char* applicableProjects,
+        const char* customizeId,
+        const char* destinationPath,
+        AsyncCompletionCallback callback,
+        void* userData
+    );
+
+    /// <summary>
+    /// DPBuWsɸTAѼƦP GetMainAppInfoAsync
+    /// </summary>
+    SOCKETCLIENT_API AsyncRequest ClientGetMainAppInfoAsync(
+        ClientHandle client,
+        const char* productSeries,
+        const char* applicableProjects,
+        const char* customizeId,
+        AsyncCompletionCallback callback,
+        void* userData
+    );
+
+    /// <summary>
+    /// DPBuWsѼƸTAѼƦP GetDefaultParametersInfoAsync
+    /// </summary>
+    SOCKETCLIENT_API AsyncRequest ClientGetDefaultParametersInfoAsync(
+        ClientHandle client,
+        const char* productSeries,
+        const char* applicableProjects,
+        const char* customizeId,
+        AsyncCompletionCallback callback,
+        void* userData
+    );
+
+    /// <summary>
+    /// DPB妸ШDAѼƦP GetBatchAsync
+    /// </summary>
+    SOCKETCLIENT_API AsyncRequest ClientGetBatchAsync(
+        ClientHandle client,
+        const BatchQuery* queries,
+        int count,
+        BatchResult* results,
+        AsyncCompletionCallback callback,
+        void* userData
+    );
+
+    /// <summary>
+    /// ШDUqA@ ClientMetrics::phases 
+    /// </summary>
+    enum MetricsPhase
+    {
+        METRICS_PHASE_DNS = 0,      // }ѪR
+        METRICS_PHASE_CONNECT,      // TCP su
+        METRICS_PHASE_SEND,         // eXШD
+        METRICS_PHASE_FIRST_BYTE,   // eXШD즬짹Y
+        METRICS_PHASE_BODY,         // ɮפe
+        METRICS_PHASE_PARSE,        // ѪRY
+        METRICS_PHASE_REQUEST,      // ӽШDA]tݳsu
+        METRICS_PHASE_COUNT
+    };
+
+    /// <summary>
+    /// ~A@ ClientMetrics::errors 
+    /// </summary>
+    enum MetricsError
+    {
+        METRICS_ERROR_CONNECT = 0,  // Lksu
+        METRICS_ERROR_SEND,         // ǰe
+        METRICS_ERROR_RECEIVE,      // ѩγsuQ
+        METRICS_ERROR_TIMEOUT,      // ǰeαO
+        METRICS_ERROR_PROTOCOL,     // ^Y榡~
+        METRICS_ERROR_SERVER,       // AȾ^~ (status  error)
+        METRICS_ERROR_CHECKSUM,     // 쪺ɮפePY CRC32C / SHA-256 
+        METRICS_ERROR_COUNT
+    };
+
+    /// <summary>
+    /// @qέpA쬰L
+    /// </summary>
+    struct LatencySummary
+    {
+        unsigned long long count;
+        double meanUs;
+        double p50Us;
+        double p90Us;
+        double p99Us;
+        double p999Us;
+        double maxUs;
+    };
+
+    /// <summary>
+    /// ȤݹҦ۫إߥHӪέp
+    /// </summary>
+    struct ClientMetrics
+    {
+        LatencySummary phases[METRICS_PHASE_COUNT];
+        unsigned long long requests;
+        unsigned long long bytesSent;
+        unsigned long long bytesReceived;
+        unsigned long long errors[METRICS_ERROR_COUNT];
+        unsigned long long cacheHits;      // ѥ֨Ѫ .bin ɮ׽ШD
+        unsigned long long cacheMisses;    // dߧ֨ᤴݤUШD
+        unsigned long long resumes;        // U_᭫ssuñq_m~򪺦
+        unsigned long long deltas;         // Ht׸ɸƧs֨ɮתШD
+    };
+
+    /// <summary>
+    /// Ūw]Ҫέp
+    /// </summary>
+    /// <param name="metrics">Isݰtmc</param>
+    SOCKETCLIENT_API bool GetClientMetrics(ClientMetrics* metrics);
+
+    /// <summary>
+    /// Nw]ҪέpH Prometheus r榡gJɮ (i node_exporter textfile collector Ū)
+    /// </summary>
+    /// <param name="path">Xɮ׸|</param>
+    SOCKETCLIENT_API bool DumpClientMetrics(const char* path);
+
+    /// <summary>
+    /// ŪҪέpAѼƦP GetClientMetrics
+    /// </summary>
+    SOCKETCLIENT_API bool ClientGetMetrics(ClientHandle client, ClientMetrics* metrics);
+
+    /// <summary>
+    /// NҪέpgJɮסAѼƦP DumpClientMetrics
+    /// </summary>
+    SOCKETCLIENT_API bool ClientDumpMetrics(ClientHandle client, const char* path);
 }
\ No newline at end of file
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+template <typename T>
+class Task;
+
+// {ɱ^ݪ (ಾA[`Is|)
+struct TaskFinalAwaiter
+{
+	bool await_ready() const noexcept {
+		return false;
+	}
+
+	template <typename Promise>
+	std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+		std::coroutine_handle<> continuation = handle.promise().continuation;
+		return continuation ? continuation : std::noop_coroutine();
+	}
+
+	void await_resume() const noexcept {
+	}
+};
+
+struct TaskPromiseBase
+{
+	std::coroutine_handle<> continuation;
+	std::exception_ptr exception;
+
+	std::suspend_always initial_suspend() const noexcept {
+		return {};
+	}
+
+	TaskFinalAwaiter final_suspend() const noexcept {
+		return {};
+	}
+
+	void unhandled_exception() noexcept {
+		exception = std::current_exception();
+	}
+};
+
+template <typename T>
+struct TaskPromise : TaskPromiseBase
+{
+	std::optional<T> value;
+
+	Task<T> get_return_object() noexcept;
+
+	template <typename U>
+	void return_value(U&& result) {
+		value.emplace(std::forward<U>(result));
+	}
+
+	T result() {
+		if (exception) {
+			std::rethrow_exception(exception);
+		}
+		return std::move(*value);
+	}
+};
+
+template <>
+struct TaskPromise<void> : TaskPromiseBase
+{
+	Task<void> get_return_object() noexcept;
+
+	void return_void() const noexcept {
+	}
+
+	void result() {
+		if (exception) {
+			std::rethrow_exception(exception);
+		}
+	}
+};
+
+/// <summary>
+/// {DPBGGإ߮ɤAĤ@ co_await ɤ~}lAᱵ^ݪ{
+/// u co_await @FѾ֦{ج[
+/// </summary>
+template <typename T>
+class Task
+{
+public:
+	using promise_type = TaskPromise<T>;
+
+	Task() noexcept = default;
+
+	explicit Task(std::coroutine_handle<promise_type> handle) noexcept
+		: handle(handle)
+	{
+	}
+
+	Task(Task&& other) noexcept
+		: handle(std::exchange(other.handle, nullptr))
+	{
+	}
+
+	Task& operator=(Task&& other) noexcept {
+		if (this != &other) {
+			if (handle) {
+				handle.destroy();
+			}
+			handle = std::exchange(other.handle, nullptr);
+		}
+		return *this;
+	}
+
+	Task(const Task&) = delete;
+	Task& operator=(const Task&) = delete;
+
+	~Task() {
+		if (handle) {
+			handle.destroy();
+		}
+	}
+
+	bool done() const noexcept {
+		return !handle || handle.done();
+	}
+
+	auto operator co_await() && noexcept {
+		struct Awaiter
+		{
+			std::coroutine_handle<promise_type> handle;
+
+			bool await_ready() const noexcept {
+				return !handle || handle.done();
+			}
+
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+				handle.promise().continuation = awaiting;
+				return handle;
+			}
+
+			T await_resume() {
+				return handle.promise().result();
+			}
+		};
+		return Awaiter{ handle };
+	}
+
+private:
+	std::coroutine_handle<promise_type> handle;
+};
+
+template <typename T>
+inline Task<T> TaskPromise<T>::get_return_object() noexcept
+{
+	return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept
+{
+	return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
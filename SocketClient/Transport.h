@@ -0,0 +1,119 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "SocketClient.h"
+
+#define DEFAULT_CONNECT_TIMEOUT_MS 10000
+#define DEFAULT_IO_TIMEOUT_MS 30000
+
+/// <summary>
+/// suUqӮ
+/// </summary>
+struct ConnectTiming
+{
+	std::chrono::nanoseconds resolve{ 0 };  // }ѪR (DNS)
+	std::chrono::nanoseconds connect{ 0 };  // TCP suA]tեѪ}
+};
+
+/// <summary>
+/// ǿhAjx socket @
+/// Windows ϥ WinsockALinux ϥΫD socket + epollAο io_uring
+/// </summary>
+class Transport
+{
+public:
+	virtual ~Transport() = default;
+
+	/// <summary>
+	/// ѪR}ósAȾA̧ǹըCӸѪRG
+	/// </summary>
+	virtual bool connect(const char* address, const char* port) = 0;
+
+	/// <summary>
+	/// ǰe
+	/// </summary>
+	/// <returns>ǰe줸ռơAѦ^ -1</returns>
+	virtual int send(const char* data, size_t length) = 0;
+
+	/// <summary>
+	/// ơA̦h length 줸
+	/// </summary>
+	/// <returns>줸ռơAsu^ 0AѦ^ -1</returns>
+	virtual int receive(char* buffer, size_t length) = 0;
+
+	/// <summary>
+	/// n length 줸աAgJIsݪO (MSG_WAITALL)
+	/// jqƥuݤּƴXtΩIs
+	/// </summary>
+	/// <returns>줸ռơAp length ܳsuΥ (H lastError Ϥ)</returns>
+	virtual size_t receiveAll(char* buffer, size_t length) = 0;
+
+	/// <summary>
+	/// O_䴩 receiveToFile
+	/// </summary>
+	virtual bool supportsReceiveToFile() const {
+		return false;
+	}
+
+	/// <summary>
+	/// n length 줸ըêgJɮת offset mAgLIsݪO
+	/// </summary>
+	/// <param name="fileFd">HgJҦ}Ҫɮ״yzl</param>
+	/// <returns>gJɮת줸ռơAp length ܳsuΥ (H lastError Ϥ)</returns>
+	virtual size_t receiveToFile(int /*fileFd*/, uint64_t /*offset*/, size_t /*length*/) {
+		return 0;
+	}
+
+	/// <summary>
+	/// ǰeV
+	/// </summary>
+	virtual bool shutdownSend() = 0;
+
+	/// <summary>
+	///  socket
+	/// </summary>
+	virtual bool close() = 0;
+
+	virtual bool isConnected() const = 0;
+
+	/// <summary>
+	/// ̪@Ѫx~X (WSAGetLastError / errno)
+	/// </summary>
+	virtual int lastError() const = 0;
+
+	/// <summary>
+	/// ̪@ connect }ѪRPsuӮ
+	/// </summary>
+	const ConnectTiming& connectTiming() const {
+		return timing;
+	}
+
+protected:
+	ConnectTiming timing;
+};
+
+/// <summary>
+/// lƥx禡w (Windows  WSAStartup)
+/// </summary>
+/// <returns>0 ܦ\A_h~X</returns>
+int TransportStartup();
+
+/// <summary>
+/// 񥭥x禡w (Windows  WSACleanup)
+/// </summary>
+/// <returns>0 ܦ\A_h~X</returns>
+int TransportCleanup();
+
+/// <summary>
+/// P_ lastError ~XO_O
+/// </summary>
+bool IsTimeoutError(int error);
+
+/// <summary>
+/// إߥثexǿh@
+/// </summary>
+/// <param name="backend">w@Aثex䴩ɨϥιw]@</param>
+std::unique_ptr<Transport> CreateTransport(TransportBackend backend = TRANSPORT_DEFAULT);
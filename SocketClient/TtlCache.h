@@ -0,0 +1,98 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/// <summary>
+/// ĴO֨AѦhӰ@
+/// Ĵ 0 ɰΡAget @ߥRBput Os
+/// clear / setTtl W@NAbe}ldߪG put ˱
+/// </summary>
+template <typename T>
+class TtlCache
+{
+public:
+	explicit TtlCache(std::chrono::milliseconds ttl)
+		: ttl(ttl)
+	{
+	}
+
+	TtlCache(const TtlCache&) = delete;
+	TtlCache& operator=(const TtlCache&) = delete;
+
+	/// <summary>
+	/// oLءAƻs value
+	/// </summary>
+	/// <param name="generation">ثe@NARɬd߫HIs put</param>
+	bool get(const std::string& key, T& value, uint64_t& generation) {
+		std::lock_guard<std::mutex> lock(mutex);
+		generation = currentGeneration;
+		auto it = entries.find(key);
+		if (it == entries.end()) {
+			return false;
+		}
+		if (std::chrono::steady_clock::now() >= it->second.expires) {
+			entries.erase(it);
+			return false;
+		}
+		value = it->second.value;
+		return true;
+	}
+
+	/// <summary>
+	/// OsdߵGòwLءFd߶}l֨wQMɤOs
+	/// </summary>
+	/// <param name="generation">d߫e get  generation o@N</param>
+	void put(const std::string& key, const T& value, uint64_t generation) {
+		std::lock_guard<std::mutex> lock(mutex);
+		if (ttl.count() <= 0 || generation != currentGeneration) {
+			return;
+		}
+		auto now = std::chrono::steady_clock::now();
+		for (auto it = entries.begin(); it != entries.end();) {
+			if (now >= it->second.expires) {
+				it = entries.erase(it);
+			}
+			else {
+				++it;
+			}
+		}
+		entries[key] = Entry{ value, now + ttl };
+	}
+
+	uint64_t generation() {
+		std::lock_guard<std::mutex> lock(mutex);
+		return currentGeneration;
+	}
+
+	/// <summary>
+	/// ܧ󦳮ĴAwOsؤ@ֲM
+	/// </summary>
+	void setTtl(std::chrono::milliseconds value) {
+		std::lock_guard<std::mutex> lock(mutex);
+		ttl = value;
+		entries.clear();
+		currentGeneration++;
+	}
+
+	void clear() {
+		std::lock_guard<std::mutex> lock(mutex);
+		entries.clear();
+		currentGeneration++;
+	}
+
+private:
+	struct Entry
+	{
+		T value;
+		std::chrono::steady_clock::time_point expires;
+	};
+
+	std::mutex mutex;
+	std::chrono::milliseconds ttl;
+	uint64_t currentGeneration = 0;
+	std::unordered_map<std::string, Entry> entries;
+};
@@ -0,0 +1,877 @@
+#include "pch.h"
+#include "UringTransport.h"
+#include "Logger.h"
+#include <linux/io_uring.h>
+#include <linux/time_types.h>
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <sys/uio.h>
+#include <sys/utsname.h>
+#include <netdb.h>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <string>
+
+#define URING_QUEUE_DEPTH 32              // Heǥ٥wİϪ
+#define URING_COMPLETION_DEPTH 64
+#define URING_BUFFER_COUNT 16           // ѵhwİϼơA 2 
+#define URING_BUFFER_SIZE 64 * 1024     // 64KB
+#define URING_BUFFER_AREA (URING_BUFFER_COUNT * URING_BUFFER_SIZE)
+#define URING_BUFFER_GROUP 0
+#define URING_FILE_SLOTS 2              // gJɮ׮ɽϥΪ϶ơAU@PɼgJW@
+#define URING_FILE_SLOT_SIZE (URING_BUFFER_AREA / URING_FILE_SLOTS)
+#define URING_ABORT_TIMEOUT_MS 1000
+
+// ƥ user_data
+#define URING_TAG_MULTISHOT 1
+#define URING_TAG_CANCEL 2
+#define URING_TAG_PROVIDE 3             // \ɤͧƥ
+#define URING_TAG_RECEIVE 4
+#define URING_TAG_WRITE 5               // [W϶s
+
+static int uringSetup(unsigned entries, struct io_uring_params* params)
+{
+	return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int uringEnter(int ringFd, unsigned toSubmit, unsigned minComplete, unsigned flags, void* arg, size_t argSize)
+{
+	return (int)syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, arg, argSize);
+}
+
+static int uringRegister(int ringFd, unsigned opcode, void* arg, unsigned count)
+{
+	return (int)syscall(__NR_io_uring_register, ringFd, opcode, arg, count);
+}
+
+/// <summary>
+/// io_uring PCAϥΨtΩIs (̿ liburing)
+/// P@ɶuѤ@Ӱϥ
+/// </summary>
+class UringQueue
+{
+public:
+	~UringQueue() {
+		destroy();
+	}
+
+	bool create(unsigned entries, unsigned completionEntries) {
+		struct io_uring_params params;
+		memset(&params, 0, sizeof(params));
+		params.flags = IORING_SETUP_CQSIZE;
+		params.cq_entries = completionEntries;
+		ringFd = uringSetup(entries, &params);
+		if (ringFd < 0) {
+			error = errno;
+			return false;
+		}
+		// ݭn@Mg (5.4) PݹOɰѼ (5.11)
+		if (!(params.features & IORING_FEAT_SINGLE_MMAP) || !(params.features & IORING_FEAT_EXT_ARG)) {
+			error = ENOSYS;
+			destroy();
+			return false;
+		}
+
+		ringSize = std::max(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+			params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe));
+		ring = mmap(nullptr, ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+		if (ring == MAP_FAILED) {
+			ring = nullptr;
+			error = errno;
+			destroy();
+			return false;
+		}
+		sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+		void* sqeMap = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+		if (sqeMap == MAP_FAILED) {
+			error = errno;
+			destroy();
+			return false;
+		}
+		sqes = static_cast<struct io_uring_sqe*>(sqeMap);
+
+		char* base = static_cast<char*>(ring);
+		sqHead = reinterpret_cast<unsigned*>(base + params.sq_off.head);
+		sqTail = reinterpret_cast<unsigned*>(base + params.sq_off.tail);
+		sqMask = *reinterpret_cast<unsigned*>(base + params.sq_off.ring_mask);
+		sqArray = reinterpret_cast<unsigned*>(base + params.sq_off.array);
+		sqEntries = params.sq_entries;
+		cqHead = reinterpret_cast<unsigned*>(base + params.cq_off.head);
+		cqTail = reinterpret_cast<unsigned*>(base + params.cq_off.tail);
+		cqMask = *reinterpret_cast<unsigned*>(base + params.cq_off.ring_mask);
+		cqes = reinterpret_cast<struct io_uring_cqe*>(base + params.cq_off.cqes);
+		localTail = *sqTail;
+		return true;
+	}
+
+	void destroy() {
+		if (sqes) {
+			munmap(sqes, sqesSize);
+			sqes = nullptr;
+		}
+		if (ring) {
+			munmap(ring, ringSize);
+			ring = nullptr;
+		}
+		if (ringFd >= 0) {
+			::close(ringFd);
+			ringFd = -1;
+		}
+	}
+
+	int fd() const {
+		return ringFd;
+	}
+
+	int lastError() const {
+		return error;
+	}
+
+	// o@ӲMŪ涵ءACwɦ^ nullptr
+	struct io_uring_sqe* nextEntry() {
+		unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+		if (localTail - head >= sqEntries) {
+			return nullptr;
+		}
+		unsigned index = localTail & sqMask;
+		struct io_uring_sqe* sqe = &sqes[index];
+		memset(sqe, 0, sizeof(*sqe));
+		sqArray[index] = index;
+		localTail++;
+		return sqe;
+	}
+
+	// ueXƤJءA
+	int submit() {
+		__atomic_store_n(sqTail, localTail, __ATOMIC_RELEASE);
+		unsigned toSubmit = localTail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+		if (toSubmit == 0) {
+			return 0;
+		}
+		return uringEnter(ringFd, toSubmit, 0, 0, nullptr, 0) < 0 ? errno : 0;
+	}
+
+	// eXƤJبõݦܤ֤@ӧƥA^ 0 ܦ\AOɦ^ ETIMEALѦ^ errno
+	int submitAndWait(std::chrono::milliseconds timeout) {
+		__atomic_store_n(sqTail, localTail, __ATOMIC_RELEASE);
+		unsigned toSubmit = localTail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+
+		struct __kernel_timespec ts;
+		ts.tv_sec = timeout.count() / 1000;
+		ts.tv_nsec = (timeout.count() % 1000) * 1000000;
+		struct io_uring_getevents_arg arg;
+		memset(&arg, 0, sizeof(arg));
+		arg.ts = (uint64_t)(uintptr_t)&ts;
+
+		int result = uringEnter(ringFd, toSubmit, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+		if (result < 0) {
+			return errno == EINTR ? 0 : errno;
+		}
+		return 0;
+	}
+
+	// XU@ӧƥ
+	bool next(struct io_uring_cqe& cqe) {
+		unsigned head = *cqHead;
+		if (head == __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)) {
+			return false;
+		}
+		cqe = cqes[head & cqMask];
+		__atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+		return true;
+	}
+
+private:
+	int ringFd = -1;
+	int error = 0;
+	void* ring = nullptr;
+	size_t ringSize = 0;
+	struct io_uring_sqe* sqes = nullptr;
+	size_t sqesSize = 0;
+
+	unsigned* sqHead = nullptr;
+	unsigned* sqTail = nullptr;
+	unsigned* sqArray = nullptr;
+	unsigned sqMask = 0;
+	unsigned sqEntries = 0;
+	unsigned localTail = 0;
+
+	unsigned* cqHead = nullptr;
+	unsigned* cqTail = nullptr;
+	unsigned cqMask = 0;
+	struct io_uring_cqe* cqes = nullptr;
+};
+
+/// <summary>
+/// Linux io_uring @AΩPɤUjqɮתhDG
+/// - Hh (multishot recv) ft֤߬D諸wİ (provided buffers)A
+///   @Y򱵦A@ݥiohӤw϶
+///   (wİϥH IORING_OP_PROVIDE_BUFFERS 浹֤ߡF֤ߪ buffer ring Lkwİ)
+/// - jqeH@ MSG_WAITALL gJIsݪO
+/// - gJɮ׮ɥHs recv  write AwİϹwU֤ (registered buffers)
+/// ШDܤpAǰeϥΪ몺 send (SO_SNDTIMEO O)A]޽uƮɶǰePibPi
+/// </summary>
+class UringTransport : public Transport
+{
+public:
+	~UringTransport() override {
+		close();
+	}
+
+	bool connect(const char* address, const char* port) override {
+		close();
+
+		struct addrinfo* result = NULL, * ptr = NULL, hints;
+
+		memset(&hints, 0, sizeof(hints));
+		hints.ai_family = AF_UNSPEC;
+		hints.ai_socktype = SOCK_STREAM;
+		hints.ai_protocol = IPPROTO_TCP;
+
+		// ѪRAȾa}Mݤf
+		auto resolveStart = std::chrono::steady_clock::now();
+		int iResult = getaddrinfo(address, port, &hints, &result);
+		auto connectStart = std::chrono::steady_clock::now();
+		timing.resolve = connectStart - resolveStart;
+		timing.connect = std::chrono::nanoseconds(0);
+		if (iResult != 0) {
+			errorCode = iResult;
+			Logger::error("getaddrinfo failed with error: " + std::string(gai_strerror(iResult)));
+			return false;
+		}
+
+		// ճsAȾ
+		for (ptr = result; ptr != NULL; ptr = ptr->ai_next) {
+			socketFd = socket(ptr->ai_family, ptr->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, ptr->ai_protocol);
+			if (socketFd < 0) {
+				errorCode = errno;
+				Logger::error("Socket creation failed with error: " + std::to_string(errorCode));
+				break;
+			}
+
+			Logger::debug("Attempting to connect to server...");
+			if (connectNonBlocking(ptr->ai_addr, ptr->ai_addrlen)) {
+				break;
+			}
+
+			::close(socketFd);
+			socketFd = -1;
+			Logger::debug("Connection attempt failed, trying next address...");
+		}
+
+		freeaddrinfo(result);
+		timing.connect = std::chrono::steady_clock::now() - connectStart;
+		if (socketFd < 0) {
+			return false;
+		}
+
+		// su^ҦA io_uring 
+		int flags = fcntl(socketFd, F_GETFL);
+		if (flags < 0 || fcntl(socketFd, F_SETFL, flags & ~O_NONBLOCK) != 0) {
+			errorCode = errno;
+			close();
+			return false;
+		}
+		setSendTimeout(DEFAULT_IO_TIMEOUT_MS);
+
+		if (!createRing()) {
+			close();
+			return false;
+		}
+		return true;
+	}
+
+	int send(const char* data, size_t length) override {
+		size_t totalSent = 0;
+		while (totalSent < length) {
+			ssize_t sent = ::send(socketFd, data + totalSent, length - totalSent, MSG_NOSIGNAL);
+			if (sent >= 0) {
+				totalSent += (size_t)sent;
+				continue;
+			}
+			if (errno == EINTR) {
+				continue;
+			}
+			errorCode = (errno == EAGAIN || errno == EWOULDBLOCK) ? ETIMEDOUT : errno;
+			return -1;
+		}
+		return (int)totalSent;
+	}
+
+	int receive(char* buffer, size_t length) override {
+		int result = waitForData();
+		if (result <= 0) {
+			return result;
+		}
+		return (int)takePending(buffer, length);
+	}
+
+	size_t receiveAll(char* buffer, size_t length) override {
+		errorCode = 0;
+
+		size_t total = 0;
+		while (total < length) {
+			if (!pending.empty()) {
+				total += takePending(buffer + total, length - total);
+				continue;
+			}
+
+			size_t remaining = length - total;
+			if (remaining > URING_BUFFER_SIZE) {
+				// jqưhAH@ MSG_WAITALL تOFe쪺ƥƻs
+				if (!stopMultishot()) {
+					break;
+				}
+				if (!pending.empty()) {
+					continue;
+				}
+				if (receiveError == 0 && !closedByPeer) {
+					size_t received = receiveDirect(buffer + total, remaining);
+					total += received;
+					if (received < remaining) {
+						break;
+					}
+					continue;
+				}
+			}
+
+			if (waitForData() <= 0) {
+				break;
+			}
+		}
+		return total;
+	}
+
+	bool supportsReceiveToFile() const override {
+		return true;
+	}
+
+	size_t receiveToFile(int fileFd, uint64_t offset, size_t length) override {
+		errorCode = 0;
+		fileWritten = 0;
+		fileError = 0;
+
+		// hAew쪺ƥgJ
+		if (!stopMultishot()) {
+			return 0;
+		}
+		size_t total = 0;
+		while (total < length && !pending.empty()) {
+			PendingBuffer& front = pending.front();
+			size_t count = std::min(front.length - front.offset, length - total);
+			ssize_t written = pwrite(fileFd, bufferAddress(front.bufferId) + front.offset, count, (off_t)(offset + total));
+			if (written != (ssize_t)count) {
+				errorCode = written < 0 ? errno : EIO;
+				return total;
+			}
+			total += count;
+			consumePending(count);
+		}
+		if (total < length && (receiveError != 0 || closedByPeer)) {
+			errorCode = receiveError;
+			return total;
+		}
+
+		// leHs recv  write G֤ߦ@Ӱ϶ߧYgJɮסAPɱU@Ӱ϶
+		size_t prefix = total;
+		bool failed = false;
+		int slot = 0;
+		while (total < length) {
+			if (writePending[slot] && !waitUntil([this, slot] { return !writePending[slot]; })) {
+				failed = true;
+				break;
+			}
+			if (fileError != 0) {
+				break;
+			}
+
+			size_t count = std::min((size_t)URING_FILE_SLOT_SIZE, length - total);
+			char* slotAddress = buffers + (size_t)slot * URING_FILE_SLOT_SIZE;
+			queueReceive(slotAddress, count, true);
+			queueWrite(fileFd, slot, slotAddress, count, offset + total);
+			if (!waitUntil([this] { return receiveDone; })) {
+				failed = true;
+				break;
+			}
+			if (receiveResult < 0 || (size_t)receiveResult < count) {
+				// sgJ|Q
+				recordReceiveFailure(receiveResult);
+				break;
+			}
+			total += count;
+			slot = (slot + 1) % URING_FILE_SLOTS;
+		}
+
+		// ݨlgJ
+		if (failed || !waitUntil([this] { return !anyWritePending(); })) {
+			abortInflight();
+		}
+		if (fileError != 0 && errorCode == 0) {
+			errorCode = fileError;
+		}
+		return prefix + fileWritten;
+	}
+
+	bool shutdownSend() override {
+		if (shutdown(socketFd, SHUT_WR) != 0) {
+			errorCode = errno;
+			return false;
+		}
+		return true;
+	}
+
+	bool close() override {
+		if (queue.fd() >= 0) {
+			if (inflight > 0) {
+				abortInflight();
+			}
+			destroyRing();
+		}
+
+		bool success = true;
+		if (socketFd >= 0) {
+			if (::close(socketFd) != 0) {
+				errorCode = errno;
+				success = false;
+			}
+			socketFd = -1;
+		}
+		pending.clear();
+		multishotArmed = false;
+		closedByPeer = false;
+		receiveError = 0;
+		return success;
+	}
+
+	bool isConnected() const override {
+		return socketFd >= 0;
+	}
+
+	int lastError() const override {
+		return errorCode;
+	}
+
+private:
+	// hwJB|Ϊwİ
+	struct PendingBuffer
+	{
+		uint16_t bufferId;
+		size_t offset;
+		size_t length;
+	};
+
+	int socketFd = -1;
+	int errorCode = 0;
+
+	UringQueue queue;
+	// wİϡGPɧ@h provided buffers PgJɮת registered buffer
+	char* buffers = nullptr;
+	// |ާ@ơAwİϫe 0
+	int inflight = 0;
+
+	std::deque<PendingBuffer> pending;
+	bool multishotArmed = false;
+	bool closedByPeer = false;
+	int receiveError = 0;
+
+	bool receiveDone = false;
+	int receiveResult = 0;
+
+	bool writePending[URING_FILE_SLOTS] = {};
+	size_t writeLength[URING_FILE_SLOTS] = {};
+	size_t fileWritten = 0;
+	int fileError = 0;
+
+	bool connectNonBlocking(const struct sockaddr* addr, socklen_t addrlen) {
+		if (::connect(socketFd, addr, addrlen) == 0) {
+			return true;
+		}
+		if (errno != EINPROGRESS) {
+			errorCode = errno;
+			return false;
+		}
+
+		struct pollfd pfd;
+		pfd.fd = socketFd;
+		pfd.events = POLLOUT;
+		pfd.revents = 0;
+		int count;
+		do {
+			count = poll(&pfd, 1, DEFAULT_CONNECT_TIMEOUT_MS);
+		} while (count < 0 && errno == EINTR);
+		if (count == 0) {
+			errorCode = ETIMEDOUT;
+			return false;
+		}
+		if (count < 0) {
+			errorCode = errno;
+			return false;
+		}
+
+		int soError = 0;
+		socklen_t soErrorLen = sizeof(soError);
+		if (getsockopt(socketFd, SOL_SOCKET, SO_ERROR, &soError, &soErrorLen) != 0) {
+			errorCode = errno;
+			return false;
+		}
+		if (soError != 0) {
+			errorCode = soError;
+			return false;
+		}
+		return true;
+	}
+
+	void setSendTimeout(int timeoutMs) {
+		struct timeval timeout;
+		timeout.tv_sec = timeoutMs / 1000;
+		timeout.tv_usec = (timeoutMs % 1000) * 1000;
+		setsockopt(socketFd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+	}
+
+	bool createRing() {
+		if (!queue.create(URING_QUEUE_DEPTH, URING_COMPLETION_DEPTH)) {
+			errorCode = queue.lastError();
+			Logger::error("io_uring_setup failed with error: " + std::to_string(errorCode));
+			return false;
+		}
+
+		void* area = mmap(nullptr, URING_BUFFER_AREA, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (area == MAP_FAILED) {
+			errorCode = errno;
+			Logger::error("Failed to allocate io_uring buffers: " + std::to_string(errorCode));
+			queue.destroy();
+			return false;
+		}
+		buffers = static_cast<char*>(area);
+
+		// U֤ߤݦbCާ@ɹoqO
+		struct iovec iov;
+		iov.iov_base = buffers;
+		iov.iov_len = URING_BUFFER_AREA;
+		if (uringRegister(queue.fd(), IORING_REGISTER_BUFFERS, &iov, 1) != 0) {
+			errorCode = errno;
+			Logger::error("io_uring buffer registration failed with error: " + std::to_string(errorCode));
+			destroyRing();
+			return false;
+		}
+
+		// PĤ@@_eX
+		provideBuffers(0, URING_BUFFER_COUNT);
+		return true;
+	}
+
+	void destroyRing() {
+		queue.destroy();
+		// ާ@ɮ֤ߥiٷ|gJAOdO餣
+		if (inflight > 0) {
+			Logger::error("io_uring operations still pending on close, leaking receive buffers");
+		}
+		else {
+			if (buffers) {
+				munmap(buffers, URING_BUFFER_AREA);
+			}
+		}
+		buffers = nullptr;
+		inflight = 0;
+		receiveDone = false;
+		std::fill(std::begin(writePending), std::end(writePending), false);
+	}
+
+	bool anyWritePending() const {
+		return std::any_of(std::begin(writePending), std::end(writePending), [](bool value) { return value; });
+	}
+
+	char* bufferAddress(uint16_t bufferId) const {
+		return buffers + (size_t)bufferId * URING_BUFFER_SIZE;
+	}
+
+	// o涵ءACwɥeXwƤJ
+	struct io_uring_sqe* nextEntry() {
+		struct io_uring_sqe* sqe = queue.nextEntry();
+		while (!sqe) {
+			queue.submit();
+			sqe = queue.nextEntry();
+		}
+		return sqe;
+	}
+
+	// Nwİϥٵ֤ߨѦhϥΡAU@eXɥͮ
+	void provideBuffers(uint16_t firstId, unsigned count) {
+		struct io_uring_sqe* sqe = nextEntry();
+		sqe->opcode = IORING_OP_PROVIDE_BUFFERS;
+		sqe->fd = (int)count;
+		sqe->addr = (uint64_t)(uintptr_t)bufferAddress(firstId);
+		sqe->len = URING_BUFFER_SIZE;
+		sqe->off = firstId;
+		sqe->buf_group = URING_BUFFER_GROUP;
+		sqe->flags = IOSQE_CQE_SKIP_SUCCESS;
+		sqe->user_data = URING_TAG_PROVIDE;
+	}
+
+	void armMultishot() {
+		struct io_uring_sqe* sqe = nextEntry();
+		sqe->opcode = IORING_OP_RECV;
+		sqe->fd = socketFd;
+		sqe->flags = IOSQE_BUFFER_SELECT;
+		sqe->buf_group = URING_BUFFER_GROUP;
+		sqe->ioprio = IORING_RECV_MULTISHOT;
+		sqe->user_data = URING_TAG_MULTISHOT;
+		multishotArmed = true;
+		inflight++;
+	}
+
+	void queueReceive(char* destination, size_t length, bool linkNext) {
+		struct io_uring_sqe* sqe = nextEntry();
+		sqe->opcode = IORING_OP_RECV;
+		sqe->fd = socketFd;
+		sqe->addr = (uint64_t)(uintptr_t)destination;
+		sqe->len = (uint32_t)length;
+		sqe->msg_flags = MSG_WAITALL;
+		sqe->flags = linkNext ? IOSQE_IO_LINK : 0;
+		sqe->user_data = URING_TAG_RECEIVE;
+		receiveDone = false;
+		inflight++;
+	}
+
+	void queueWrite(int fileFd, int slot, char* source, size_t length, uint64_t offset) {
+		struct io_uring_sqe* sqe = nextEntry();
+		sqe->opcode = IORING_OP_WRITE_FIXED;
+		sqe->fd = fileFd;
+		sqe->addr = (uint64_t)(uintptr_t)source;
+		sqe->len = (uint32_t)length;
+		sqe->off = offset;
+		sqe->buf_index = 0;
+		sqe->user_data = URING_TAG_WRITE + slot;
+		writePending[slot] = true;
+		writeLength[slot] = length;
+		inflight++;
+	}
+
+	void queueCancel(uint64_t userData, uint32_t cancelFlags) {
+		struct io_uring_sqe* sqe = nextEntry();
+		sqe->opcode = IORING_OP_ASYNC_CANCEL;
+		sqe->fd = -1;
+		sqe->addr = userData;
+		sqe->cancel_flags = cancelFlags;
+		sqe->user_data = URING_TAG_CANCEL;
+		inflight++;
+	}
+
+	// BzҦwƥ
+	void reap() {
+		struct io_uring_cqe cqe;
+		while (queue.next(cqe)) {
+			if (cqe.user_data == URING_TAG_PROVIDE) {
+				// uѮɤ~|ApJi椤ާ@
+				receiveError = -cqe.res;
+				continue;
+			}
+
+			bool more = (cqe.flags & IORING_CQE_F_MORE) != 0;
+			if (!more) {
+				inflight--;
+			}
+
+			if (cqe.user_data == URING_TAG_MULTISHOT) {
+				if (cqe.res > 0) {
+					pending.push_back({ (uint16_t)(cqe.flags >> IORING_CQE_BUFFER_SHIFT), 0, (size_t)cqe.res });
+				}
+				else if (cqe.res == 0) {
+					closedByPeer = true;
+				}
+				else if (cqe.res == -ENOBUFS) {
+					// wİϳb pending Υ٪ШD|eXɵA᭫sYiF
+					// wİϤOb pending NOw (ΧYN) ٮ֤ߡA|ä[κ
+				}
+				else if (cqe.res != -ECANCELED) {
+					receiveError = -cqe.res;
+				}
+				if (!more) {
+					multishotArmed = false;
+				}
+			}
+			else if (cqe.user_data == URING_TAG_RECEIVE) {
+				receiveDone = true;
+				receiveResult = cqe.res;
+			}
+			else if (cqe.user_data >= URING_TAG_WRITE && cqe.user_data < URING_TAG_WRITE + URING_FILE_SLOTS) {
+				int slot = (int)(cqe.user_data - URING_TAG_WRITE);
+				writePending[slot] = false;
+				if (cqe.res >= 0 && (size_t)cqe.res == writeLength[slot]) {
+					fileWritten += writeLength[slot];
+				}
+				else if (cqe.res != -ECANCELED && fileError == 0) {
+					fileError = cqe.res < 0 ? -cqe.res : EIO;
+				}
+			}
+		}
+	}
+
+	// eXƤJާ@õݪ done() ߡAOɩΥѮɳ]w errorCode æ^ false
+	template <typename Condition>
+	bool waitUntil(Condition done) {
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(DEFAULT_IO_TIMEOUT_MS);
+		while (true) {
+			reap();
+			if (done()) {
+				return true;
+			}
+			auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+			if (remaining.count() <= 0) {
+				errorCode = ETIMEDOUT;
+				return false;
+			}
+			int result = queue.submitAndWait(remaining);
+			if (result != 0 && result != ETIME) {
+				errorCode = result;
+				return false;
+			}
+		}
+	}
+
+	// ݦheӸơA^ǭȦP receive
+	int waitForData() {
+		while (pending.empty()) {
+			if (receiveError != 0) {
+				errorCode = receiveError;
+				return -1;
+			}
+			if (closedByPeer) {
+				return 0;
+			}
+			if (!multishotArmed) {
+				armMultishot();
+			}
+			if (!waitUntil([this] { return !pending.empty() || !multishotArmed; })) {
+				return -1;
+			}
+		}
+		return 1;
+	}
+
+	// hAe쪺Ưdb pending 
+	bool stopMultishot() {
+		if (!multishotArmed) {
+			return true;
+		}
+		queueCancel(URING_TAG_MULTISHOT, 0);
+		if (!waitUntil([this] { return !multishotArmed; })) {
+			abortInflight();
+			return false;
+		}
+		return true;
+	}
+
+	// H@ MSG_WAITALL A֤ߦγsu~
+	size_t receiveDirect(char* destination, size_t length) {
+		queueReceive(destination, length, false);
+		if (!waitUntil([this] { return receiveDone; })) {
+			// تOݩIsݡA^eTw֤ߤAgJ
+			abortInflight();
+			return 0;
+		}
+		if (receiveResult < 0 || (size_t)receiveResult < length) {
+			recordReceiveFailure(receiveResult);
+		}
+		return receiveResult > 0 ? (size_t)receiveResult : 0;
+	}
+
+	void recordReceiveFailure(int result) {
+		if (result < 0) {
+			receiveError = -result;
+			errorCode = receiveError;
+		}
+		else {
+			closedByPeer = true;
+		}
+	}
+
+	size_t takePending(char* destination, size_t length) {
+		size_t copied = 0;
+		while (copied < length && !pending.empty()) {
+			PendingBuffer& front = pending.front();
+			size_t count = std::min(front.length - front.offset, length - copied);
+			memcpy(destination + copied, bufferAddress(front.bufferId) + front.offset, count);
+			copied += count;
+			consumePending(count);
+		}
+		return copied;
+	}
+
+	void consumePending(size_t count) {
+		PendingBuffer& front = pending.front();
+		front.offset += count;
+		if (front.offset == front.length) {
+			provideBuffers(front.bufferId, 1);
+			pending.pop_front();
+		}
+	}
+
+	// Ҧi椤ާ@õݮ֤ߧA~wİϡFsuAi
+	void abortInflight() {
+		int savedError = errorCode;
+		if (socketFd >= 0) {
+			shutdown(socketFd, SHUT_RDWR);
+		}
+		queueCancel(0, IORING_ASYNC_CANCEL_ANY | IORING_ASYNC_CANCEL_ALL);
+
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(URING_ABORT_TIMEOUT_MS);
+		while (true) {
+			reap();
+			if (inflight <= 0 || std::chrono::steady_clock::now() >= deadline) {
+				break;
+			}
+			int result = queue.submitAndWait(std::chrono::milliseconds(100));
+			if (result != 0 && result != ETIME) {
+				break;
+			}
+		}
+		multishotArmed = false;
+		if (receiveError == 0) {
+			receiveError = savedError != 0 ? savedError : ECONNABORTED;
+		}
+		errorCode = savedError;
+	}
+};
+
+// hݭn Linux 6.0AýT{ io_uring Q (io_uring_disabled  seccomp)
+static bool uringSupported()
+{
+	static std::once_flag once;
+	static bool supported = false;
+	std::call_once(once, [] {
+		struct utsname name;
+		int major = 0, minor = 0;
+		if (uname(&name) != 0 || sscanf(name.release, "%d.%d", &major, &minor) != 2 || major < 6) {
+			Logger::info("io_uring transport requires Linux 6.0 or later");
+			return;
+		}
+		UringQueue probe;
+		if (!probe.create(URING_QUEUE_DEPTH, URING_COMPLETION_DEPTH)) {
+			Logger::info("io_uring is not available: " + std::to_string(probe.lastError()));
+			return;
+		}
+		supported = true;
+	});
+	return supported;
+}
+
+std::unique_ptr<Transport> CreateUringTransport()
+{
+	if (!uringSupported()) {
+		return nullptr;
+	}
+	return std::make_unique<UringTransport>();
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <memory>
+#include "Transport.h"
+
+/// <summary>
+/// إ io_uring ǿhA֤ߤ䴩 (ݭn Linux 6.0 HW) γQϥήɦ^ nullptr
+/// </summary>
+std::unique_ptr<Transport> CreateUringTransport();
@@ -0,0 +1,172 @@
+#include "pch.h"
+#include "Transport.h"
+#include "Logger.h"
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <string>
+
+#pragma comment(lib, "Ws2_32.lib")
+#pragma comment(lib, "Mswsock.lib")
+#pragma comment(lib, "AdvApi32.lib")
+
+class WinsockTransport : public Transport
+{
+public:
+	~WinsockTransport() override {
+		if (socketHandle != INVALID_SOCKET) {
+			closesocket(socketHandle);
+		}
+	}
+
+	bool connect(const char* address, const char* port) override {
+		struct addrinfo* result = NULL, * ptr = NULL, hints;
+
+		ZeroMemory(&hints, sizeof(hints));
+		hints.ai_family = AF_UNSPEC;
+		hints.ai_socktype = SOCK_STREAM;
+		hints.ai_protocol = IPPROTO_TCP;
+
+		// ѪRAȾa}Mݤf
+		auto resolveStart = std::chrono::steady_clock::now();
+		int iResult = getaddrinfo(address, port, &hints, &result);
+		auto connectStart = std::chrono::steady_clock::now();
+		timing.resolve = connectStart - resolveStart;
+		timing.connect = std::chrono::nanoseconds(0);
+		if (iResult != 0) {
+			errorCode = iResult;
+			Logger::error("getaddrinfo failed with error: " + std::to_string(iResult));
+			return false;
+		}
+
+		// ճsAȾ
+		for (ptr = result; ptr != NULL; ptr = ptr->ai_next) {
+			socketHandle = socket(ptr->ai_family, ptr->ai_socktype, ptr->ai_protocol);
+			if (socketHandle == INVALID_SOCKET) {
+				errorCode = WSAGetLastError();
+				Logger::error("Socket creation failed with error: " + std::to_string(errorCode));
+				freeaddrinfo(result);
+				return false;
+			}
+
+			Logger::debug("Attempting to connect to server...");
+			iResult = ::connect(socketHandle, ptr->ai_addr, (int)ptr->ai_addrlen);
+			if (iResult == SOCKET_ERROR) {
+				errorCode = WSAGetLastError();
+				closesocket(socketHandle);
+				socketHandle = INVALID_SOCKET;
+				Logger::debug("Connection attempt failed, trying next address...");
+				continue;
+			}
+			break;
+		}
+
+		freeaddrinfo(result);
+		timing.connect = std::chrono::steady_clock::now() - connectStart;
+		return socketHandle != INVALID_SOCKET;
+	}
+
+	int send(const char* data, size_t length) override {
+		size_t totalSent = 0;
+		while (totalSent < length) {
+			int iResult = ::send(socketHandle, data + totalSent, (int)(length - totalSent), 0);
+			if (iResult == SOCKET_ERROR) {
+				errorCode = WSAGetLastError();
+				return -1;
+			}
+			totalSent += iResult;
+		}
+		return (int)totalSent;
+	}
+
+	int receive(char* buffer, size_t length) override {
+		int iResult = recv(socketHandle, buffer, (int)length, 0);
+		if (iResult == SOCKET_ERROR) {
+			errorCode = WSAGetLastError();
+			return -1;
+		}
+		return iResult;
+	}
+
+	size_t receiveAll(char* buffer, size_t length) override {
+		errorCode = 0;
+		size_t totalReceived = 0;
+		while (totalReceived < length) {
+			// recv װѼƬ intAjɮפq
+			int chunk = (int)std::min(length - totalReceived, (size_t)INT_MAX);
+			int iResult = recv(socketHandle, buffer + totalReceived, chunk, MSG_WAITALL);
+			if (iResult == SOCKET_ERROR) {
+				errorCode = WSAGetLastError();
+				break;
+			}
+			if (iResult == 0) {
+				break;
+			}
+			totalReceived += iResult;
+		}
+		return totalReceived;
+	}
+
+	bool shutdownSend() override {
+		if (shutdown(socketHandle, SD_SEND) == SOCKET_ERROR) {
+			errorCode = WSAGetLastError();
+			return false;
+		}
+		return true;
+	}
+
+	bool close() override {
+		if (socketHandle == INVALID_SOCKET) {
+			return true;
+		}
+		int iResult = closesocket(socketHandle);
+		socketHandle = INVALID_SOCKET;
+		if (iResult == SOCKET_ERROR) {
+			errorCode = WSAGetLastError();
+			return false;
+		}
+		return true;
+	}
+
+	bool isConnected() const override {
+		return socketHandle != INVALID_SOCKET;
+	}
+
+	int lastError() const override {
+		return errorCode;
+	}
+
+private:
+	SOCKET socketHandle = INVALID_SOCKET;
+	int errorCode = 0;
+};
+
+int TransportStartup()
+{
+	WSAData wsaData;
+	return WSAStartup(MAKEWORD(2, 2), &wsaData);
+}
+
+int TransportCleanup()
+{
+	if (WSACleanup() == SOCKET_ERROR) {
+		return WSAGetLastError();
+	}
+	return 0;
+}
+
+bool IsTimeoutError(int error)
+{
+	return error == WSAETIMEDOUT;
+}
+
+std::unique_ptr<Transport> CreateTransport(TransportBackend backend)
+{
+	// Windows u Winsock @ALﶵιw]ǿh
+	if (backend != TRANSPORT_DEFAULT) {
+		Logger::info("io_uring transport is not available on Windows, using the default transport");
+	}
+	return std::make_unique<WinsockTransport>();
+}
@@ -1,5 +1,8 @@
 ﻿#pragma once
 
+#ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN             // 從 Windows 標頭排除不常使用的項目
+#define NOMINMAX                        // 避免 min/max 巨集與 std::min/std::max 衝突
 // Windows 標頭檔
 #include <windows.h>
+#endif // _WIN32
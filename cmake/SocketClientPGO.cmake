@@ -0,0 +1,77 @@
+# 兩階段 PGO 建置腳本，由 `cmake --build <dir> --target pgo` 呼叫
+#
+#   1. 以 SOCKETCLIENT_PGO=GENERATE 建置插樁版本
+#   2. 啟動 mock_server，並以 pgo_training 執行一般站點請求流程
+#   3. 以 SOCKETCLIENT_PGO=USE 重新建置 libsocketclient (Release + LTO)
+#
+# 輸出位於 BINARY_DIR，profile 資料位於 BINARY_DIR/profile
+
+foreach(variable SOURCE_DIR BINARY_DIR CXX_COMPILER CXX_COMPILER_ID)
+  if(NOT DEFINED ${variable})
+    message(FATAL_ERROR "SocketClientPGO.cmake requires -D${variable}=...")
+  endif()
+endforeach()
+
+if(NOT DEFINED PGO_ITERATIONS)
+  set(PGO_ITERATIONS 300)
+endif()
+if(NOT DEFINED PGO_PORT)
+  set(PGO_PORT 19444)
+endif()
+
+set(PROFILE_DIR "${BINARY_DIR}/profile")
+
+function(run_step description)
+  message(STATUS "PGO: ${description}")
+  execute_process(COMMAND ${ARGN} RESULT_VARIABLE result)
+  if(NOT result EQUAL 0)
+    message(FATAL_ERROR "PGO: ${description} failed (${result})")
+  endif()
+endfunction()
+
+function(configure_stage stage)
+  run_step("configure ${stage}"
+    ${CMAKE_COMMAND} -S ${SOURCE_DIR} -B ${BINARY_DIR}
+      -DCMAKE_BUILD_TYPE=Release
+      -DCMAKE_CXX_COMPILER=${CXX_COMPILER}
+      -DSOCKETCLIENT_ENABLE_LTO=ON
+      -DSOCKETCLIENT_PGO=${stage}
+      -DSOCKETCLIENT_PGO_DIR=${PROFILE_DIR})
+endfunction()
+
+file(REMOVE_RECURSE ${PROFILE_DIR})
+file(MAKE_DIRECTORY ${PROFILE_DIR})
+
+configure_stage(GENERATE)
+run_step("build instrumented library"
+  ${CMAKE_COMMAND} --build ${BINARY_DIR} --target socketclient mock_server pgo_training)
+
+# 兩個指令以管線方式同時執行；pgo_training 會重試連線直到服務器就緒，
+# 服務器在唯一的連線關閉後結束
+set(ENV{SOCKETCLIENT_ADDRESS} "127.0.0.1")
+set(ENV{SOCKETCLIENT_PORT} "${PGO_PORT}")
+message(STATUS "PGO: training against mock server on port ${PGO_PORT}")
+execute_process(
+  COMMAND ${BINARY_DIR}/mock_server --port ${PGO_PORT} --synthetic-size 1048576 --max-connections 1
+  COMMAND ${BINARY_DIR}/pgo_training ${PGO_ITERATIONS}
+  WORKING_DIRECTORY ${BINARY_DIR}
+  RESULTS_VARIABLE training_results
+  TIMEOUT 600)
+foreach(result IN LISTS training_results)
+  if(NOT result EQUAL 0)
+    message(FATAL_ERROR "PGO: training run failed (${training_results})")
+  endif()
+endforeach()
+
+if(CXX_COMPILER_ID MATCHES "Clang")
+  find_program(LLVM_PROFDATA NAMES llvm-profdata REQUIRED)
+  file(GLOB raw_profiles ${PROFILE_DIR}/*.profraw)
+  run_step("merge profiles"
+    ${LLVM_PROFDATA} merge -o ${PROFILE_DIR}/socketclient.profdata ${raw_profiles})
+endif()
+
+configure_stage(USE)
+run_step("build optimized library"
+  ${CMAKE_COMMAND} --build ${BINARY_DIR} --target socketclient socketclient_static)
+
+message(STATUS "PGO: optimized library written to ${BINARY_DIR}")